@@ -0,0 +1,1170 @@
+#ifndef AISDI_LINEAR_ADAPTIVESEQUENCE_H
+#define AISDI_LINEAR_ADAPTIVESEQUENCE_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.h"
+
+namespace aisdi {
+
+    namespace detail {
+
+        // Layouts used by AdaptiveSequence. They share one index based interface and do no checking of their own,
+        // the sequence validates positions before it calls them.
+
+        template <typename Type>
+        class ContiguousLayout {
+        public:
+            using size_type = std::size_t;
+
+            size_type size() const {
+                return items.getSize();
+            }
+
+            Type& at(size_type index) {
+                return items.data()[index];
+            }
+
+            const Type& at(size_type index) const {
+                return items.data()[index];
+            }
+
+            void insert(size_type index, Type&& item) {
+                items.insert(items.cbegin() + index, std::move(item));
+            }
+
+            void erase(size_type first, size_type length) {
+                items.erase(items.cbegin() + first, items.cbegin() + first + length);
+            }
+
+            void reserve(size_type capacity) {
+                items.reserve(capacity);
+            }
+
+            void clear() {
+                items = Vector<Type>();
+            }
+
+            void swap(ContiguousLayout& other) {
+                std::swap(items, other.items);
+            }
+
+        private:
+            Vector<Type> items;
+        };
+
+        // Circular buffer with a power of two capacity, elements are shifted towards the nearer end.
+        template <typename Type>
+        class RingLayout {
+        public:
+            using size_type = std::size_t;
+
+            RingLayout() : slots(nullptr), capacity(0), head(0), count(0) {}
+
+            RingLayout(const RingLayout&) = delete;
+            RingLayout& operator=(const RingLayout&) = delete;
+
+            ~RingLayout() {
+                clear();
+                ::operator delete(slots);
+            }
+
+            size_type size() const {
+                return count;
+            }
+
+            Type& at(size_type index) {
+                return *slot(index);
+            }
+
+            const Type& at(size_type index) const {
+                return *slot(index);
+            }
+
+            void insert(size_type index, Type&& item) {
+                if (count == capacity) {
+                    reallocate(capacity == 0 ? MIN_CAPACITY : capacity * 2);
+                }
+                if (index == count) {
+                    new (slot(count)) Type(std::move(item));
+                    ++count;
+                }
+                else if (index == 0 || index < count / 2) {
+                    size_type front = (head + capacity - 1) & (capacity - 1);
+                    new (slots + front) Type(std::move(index == 0 ? item : at(0)));
+                    head = front;
+                    ++count;
+                    if (index > 0) {
+                        for (size_type i = 1; i < index; ++i) {
+                            at(i) = std::move(at(i + 1));
+                        }
+                        at(index) = std::move(item);
+                    }
+                }
+                else {
+                    new (slot(count)) Type(std::move(at(count - 1)));
+                    ++count;
+                    for (size_type i = count - 2; i > index; --i) {
+                        at(i) = std::move(at(i - 1));
+                    }
+                    at(index) = std::move(item);
+                }
+            }
+
+            void erase(size_type first, size_type length) {
+                size_type last = first + length;
+                if (first < count - last) {
+                    for (size_type i = first; i > 0; --i) {
+                        at(i - 1 + length) = std::move(at(i - 1));
+                    }
+                    for (size_type i = 0; i < length; ++i) {
+                        slot(i)->~Type();
+                    }
+                    head = (head + length) & (capacity - 1);
+                }
+                else {
+                    for (size_type i = last; i < count; ++i) {
+                        at(i - length) = std::move(at(i));
+                    }
+                    for (size_type i = count - length; i < count; ++i) {
+                        slot(i)->~Type();
+                    }
+                }
+                count -= length;
+            }
+
+            void reserve(size_type wanted) {
+                size_type new_capacity = capacity == 0 ? MIN_CAPACITY : capacity;
+                while (new_capacity < wanted) {
+                    new_capacity *= 2;
+                }
+                if (new_capacity != capacity) {
+                    reallocate(new_capacity);
+                }
+            }
+
+            void clear() {
+                for (size_type i = 0; i < count; ++i) {
+                    slot(i)->~Type();
+                }
+                head = count = 0;
+            }
+
+            void swap(RingLayout& other) {
+                std::swap(slots, other.slots);
+                std::swap(capacity, other.capacity);
+                std::swap(head, other.head);
+                std::swap(count, other.count);
+            }
+
+        private:
+            static const size_type MIN_CAPACITY = 16;
+
+            Type* slot(size_type index) const {
+                return slots + ((head + index) & (capacity - 1));
+            }
+
+            void reallocate(size_type new_capacity) {
+                Type* new_slots = static_cast<Type*>(::operator new(sizeof(Type) * new_capacity));
+                for (size_type i = 0; i < count; ++i) {
+                    new (new_slots + i) Type(std::move(at(i)));
+                    slot(i)->~Type();
+                }
+                ::operator delete(slots);
+                slots = new_slots;
+                capacity = new_capacity;
+                head = 0;
+            }
+
+            Type* slots;
+            size_type capacity;
+            size_type head;
+            size_type count;
+        };
+
+        // Buffer with a hole kept where the last edit happened, so edits close to each other move few elements.
+        template <typename Type>
+        class GapLayout {
+        public:
+            using size_type = std::size_t;
+
+            GapLayout() : slots(nullptr), capacity(0), gap_start(0), gap_end(0) {}
+
+            GapLayout(const GapLayout&) = delete;
+            GapLayout& operator=(const GapLayout&) = delete;
+
+            ~GapLayout() {
+                clear();
+                ::operator delete(slots);
+            }
+
+            size_type size() const {
+                return capacity - (gap_end - gap_start);
+            }
+
+            Type& at(size_type index) {
+                return slots[index < gap_start ? index : index + (gap_end - gap_start)];
+            }
+
+            const Type& at(size_type index) const {
+                return slots[index < gap_start ? index : index + (gap_end - gap_start)];
+            }
+
+            void insert(size_type index, Type&& item) {
+                if (gap_start == gap_end) {
+                    reallocate(capacity == 0 ? MIN_CAPACITY : capacity * 2);
+                }
+                moveGap(index);
+                new (slots + gap_start) Type(std::move(item));
+                ++gap_start;
+            }
+
+            void erase(size_type first, size_type length) {
+                moveGap(first);
+                for (size_type i = 0; i < length; ++i) {
+                    slots[gap_end + i].~Type();
+                }
+                gap_end += length;
+            }
+
+            void reserve(size_type wanted) {
+                size_type new_capacity = capacity == 0 ? MIN_CAPACITY : capacity;
+                while (new_capacity < wanted) {
+                    new_capacity *= 2;
+                }
+                if (new_capacity != capacity) {
+                    reallocate(new_capacity);
+                }
+            }
+
+            void clear() {
+                for (size_type i = 0; i < gap_start; ++i) {
+                    slots[i].~Type();
+                }
+                for (size_type i = gap_end; i < capacity; ++i) {
+                    slots[i].~Type();
+                }
+                gap_start = 0;
+                gap_end = capacity;
+            }
+
+            void swap(GapLayout& other) {
+                std::swap(slots, other.slots);
+                std::swap(capacity, other.capacity);
+                std::swap(gap_start, other.gap_start);
+                std::swap(gap_end, other.gap_end);
+            }
+
+        private:
+            static const size_type MIN_CAPACITY = 16;
+
+            void moveGap(size_type index) {
+                if (gap_start == gap_end) {
+                    gap_start = gap_end = index;
+                    return;
+                }
+                while (index < gap_start) {
+                    --gap_start;
+                    --gap_end;
+                    new (slots + gap_end) Type(std::move(slots[gap_start]));
+                    slots[gap_start].~Type();
+                }
+                while (index > gap_start) {
+                    new (slots + gap_start) Type(std::move(slots[gap_end]));
+                    slots[gap_end].~Type();
+                    ++gap_start;
+                    ++gap_end;
+                }
+            }
+
+            void reallocate(size_type new_capacity) {
+                Type* new_slots = static_cast<Type*>(::operator new(sizeof(Type) * new_capacity));
+                size_type new_gap_end = new_capacity - (capacity - gap_end);
+                for (size_type i = 0; i < gap_start; ++i) {
+                    new (new_slots + i) Type(std::move(slots[i]));
+                    slots[i].~Type();
+                }
+                for (size_type i = gap_end; i < capacity; ++i) {
+                    new (new_slots + new_gap_end + (i - gap_end)) Type(std::move(slots[i]));
+                    slots[i].~Type();
+                }
+                ::operator delete(slots);
+                slots = new_slots;
+                capacity = new_capacity;
+                gap_end = new_gap_end;
+            }
+
+            Type* slots;
+            size_type capacity;
+            size_type gap_start;
+            size_type gap_end;
+        };
+
+        // Doubly linked list of fixed size chunks. A full chunk is split in half, so an edit moves at most
+        // one chunk of elements. Lookups start from a cursor left by the previous one, which makes walking in
+        // order O(1) per step; const lookups move a cursor owned by the caller, never the layout's own.
+        template <typename Type>
+        class ChunkedLayout {
+        public:
+            using size_type = std::size_t;
+
+            static const size_type CHUNK_SIZE = 64;
+
+            struct Chunk {
+                Type* items() {
+                    return reinterpret_cast<Type*>(&storage);
+                }
+
+                Chunk* prev;
+                Chunk* next;
+                size_type count;
+                typename std::aligned_storage<sizeof(Type) * CHUNK_SIZE, alignof(Type)>::type storage;
+            };
+
+            // A chunk and the index of its first element.
+            struct Cursor {
+                Cursor() : chunk(nullptr), start(0) {}
+
+                Chunk* chunk;
+                size_type start;
+            };
+
+            ChunkedLayout() : first(nullptr), last(nullptr), count(0) {}
+
+            ChunkedLayout(const ChunkedLayout&) = delete;
+            ChunkedLayout& operator=(const ChunkedLayout&) = delete;
+
+            ~ChunkedLayout() {
+                clear();
+            }
+
+            size_type size() const {
+                return count;
+            }
+
+            Type& at(size_type index) {
+                size_type offset;
+                Chunk* chunk = find(index, offset, cursor);
+                return chunk->items()[offset];
+            }
+
+            const Type& at(size_type index) const {
+                Cursor near = cursor;
+                return at(index, near);
+            }
+
+            // The cursor has to come from an earlier lookup on the unchanged layout, or be empty.
+            const Type& at(size_type index, Cursor& near) const {
+                size_type offset;
+                Chunk* chunk = find(index, offset, near);
+                return chunk->items()[offset];
+            }
+
+            void insert(size_type index, Type&& item) {
+                // the cursor ends up on the chunk receiving the element, whose start does not move
+                size_type offset;
+                Chunk* chunk;
+                if (index == count) {
+                    if (last == nullptr || last->count == CHUNK_SIZE) {
+                        linkAfter(last, new Chunk);
+                    }
+                    chunk = last;
+                    offset = last->count;
+                }
+                else if (index == 0 && first->count == CHUNK_SIZE) {
+                    linkAfter(nullptr, new Chunk);
+                    chunk = cursor.chunk = first;
+                    offset = cursor.start = 0;
+                }
+                else {
+                    chunk = find(index, offset, cursor);
+                    if (chunk->count == CHUNK_SIZE) {
+                        split(chunk);
+                        if (offset > chunk->count) {
+                            offset -= chunk->count;
+                            chunk = chunk->next;
+                        }
+                        cursor.chunk = chunk;
+                        cursor.start = index - offset;
+                    }
+                }
+                Type* items = chunk->items();
+                size_type used = chunk->count;
+                if (offset == used) {
+                    new (items + used) Type(std::move(item));
+                }
+                else {
+                    new (items + used) Type(std::move(items[used - 1]));
+                    std::move_backward(items + offset, items + used - 1, items + used);
+                    items[offset] = std::move(item);
+                }
+                ++chunk->count;
+                ++count;
+            }
+
+            void erase(size_type firstIndex, size_type length) {
+                while (length > 0) {
+                    size_type offset;
+                    Chunk* chunk = find(firstIndex, offset, cursor);
+                    Type* items = chunk->items();
+                    size_type removed = std::min(length, chunk->count - offset);
+                    std::move(items + offset + removed, items + chunk->count, items + offset);
+                    for (size_type i = chunk->count - removed; i < chunk->count; ++i) {
+                        items[i].~Type();
+                    }
+                    chunk->count -= removed;
+                    count -= removed;
+                    length -= removed;
+                    if (chunk->count == 0) {
+                        cursor.chunk = chunk->next;
+                        cursor.start = firstIndex;
+                        unlink(chunk);
+                        delete chunk;
+                    }
+                }
+            }
+
+            void reserve(size_type) {}
+
+            void clear() {
+                while (first != nullptr) {
+                    Chunk* chunk = first;
+                    first = chunk->next;
+                    for (size_type i = 0; i < chunk->count; ++i) {
+                        chunk->items()[i].~Type();
+                    }
+                    delete chunk;
+                }
+                last = nullptr;
+                count = 0;
+                cursor = Cursor();
+            }
+
+            void swap(ChunkedLayout& other) {
+                std::swap(first, other.first);
+                std::swap(last, other.last);
+                std::swap(count, other.count);
+                std::swap(cursor, other.cursor);
+            }
+
+        private:
+            // Starts from whichever of the cursor, the front and the back is closest to index, and leaves the
+            // cursor on the chunk found.
+            Chunk* find(size_type index, size_type& offset, Cursor& near) const {
+                Chunk* chunk = first;
+                size_type start = 0;
+                size_type best = index;
+                if (count - index < best) {
+                    chunk = last;
+                    start = count - last->count;
+                    best = count - index;
+                }
+                if (near.chunk != nullptr) {
+                    size_type distance = index > near.start ? index - near.start : near.start - index;
+                    if (distance < best) {
+                        chunk = near.chunk;
+                        start = near.start;
+                    }
+                }
+                while (index < start) {
+                    chunk = chunk->prev;
+                    start -= chunk->count;
+                }
+                while (index >= start + chunk->count) {
+                    start += chunk->count;
+                    chunk = chunk->next;
+                }
+                near.chunk = chunk;
+                near.start = start;
+                offset = index - start;
+                return chunk;
+            }
+
+            // Moves the upper half of a full chunk into a new chunk linked after it.
+            void split(Chunk* chunk) {
+                Chunk* upper = new Chunk;
+                linkAfter(chunk, upper);
+                size_type keep = CHUNK_SIZE / 2;
+                Type* items = chunk->items();
+                for (size_type i = keep; i < CHUNK_SIZE; ++i) {
+                    new (upper->items() + (i - keep)) Type(std::move(items[i]));
+                    items[i].~Type();
+                }
+                upper->count = CHUNK_SIZE - keep;
+                chunk->count = keep;
+            }
+
+            // A null position links the chunk in front of the first one.
+            void linkAfter(Chunk* position, Chunk* chunk) {
+                chunk->count = 0;
+                chunk->prev = position;
+                chunk->next = position == nullptr ? first : position->next;
+                if (chunk->next != nullptr) {
+                    chunk->next->prev = chunk;
+                }
+                else {
+                    last = chunk;
+                }
+                if (position != nullptr) {
+                    position->next = chunk;
+                }
+                else {
+                    first = chunk;
+                }
+            }
+
+            void unlink(Chunk* chunk) {
+                (chunk->prev != nullptr ? chunk->prev->next : first) = chunk->next;
+                (chunk->next != nullptr ? chunk->next->prev : last) = chunk->prev;
+            }
+
+            Chunk* first;
+            Chunk* last;
+            size_type count;
+            Cursor cursor;
+        };
+
+    }
+
+    enum class SequenceLayout { Contiguous, Ring, Gap, Chunked };
+
+    // Sequence which counts how it is used and moves its elements into the layout that suits the observed
+    // mix: a vector for appends and reads, a ring buffer for work at both ends, a gap buffer for edits close
+    // to each other and a chunked list for edits scattered over a long sequence. Each operation adds its
+    // estimated cost under every layout; every DECISION_WINDOW operations (sooner when the current layout
+    // is clearly losing) the cheapest layout is adopted when it would have cost less than half of the current
+    // one and the saving pays for moving the elements. Reads are counted by the non-const operator[] only;
+    // reading a const sequence, iterators included, changes nothing and may happen from many threads at once.
+    template <typename Type>
+    class AdaptiveSequence {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = Type;
+        using pointer = Type*;
+        using reference = Type&;
+        using const_pointer = const Type*;
+        using const_reference = const Type&;
+
+        class ConstIterator;
+        class Iterator;
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+        using Layout = SequenceLayout;
+
+        static const size_type LAYOUT_COUNT = 4;
+        static const size_type DECISION_WINDOW = 256;
+        static const size_type EARLY_DECISION_FACTOR = 4;
+
+        struct Stats {
+            size_type backEdits;
+            size_type frontEdits;
+            size_type middleEdits;
+            size_type reads;
+            size_type switches;
+            // estimated cost of the last evaluated window under each layout, indexed by Layout
+            size_type windowCosts[LAYOUT_COUNT];
+        };
+
+        AdaptiveSequence() : AdaptiveSequence(Layout::Contiguous) {}
+
+        explicit AdaptiveSequence(Layout initial)
+                : layout(initial), adaptive(true), stats(), window(), window_ops(0), last_edit(0), last_read(0),
+                  edits(0) {}
+
+        AdaptiveSequence(std::initializer_list<Type> l) : AdaptiveSequence() {
+            reserve(l.size());
+            for (const auto& val : l) {
+                append(val);
+            }
+        }
+
+        AdaptiveSequence(const AdaptiveSequence& other) : AdaptiveSequence(other.layout) {
+            adaptive = other.adaptive;
+            reserve(other.getSize());
+            for (size_type i = 0; i < other.getSize(); ++i) {
+                insertAt(i, Type(other.slot(i)));
+            }
+        }
+
+        AdaptiveSequence(AdaptiveSequence&& other) : AdaptiveSequence() {
+            swap(other);
+        }
+
+        AdaptiveSequence& operator=(const AdaptiveSequence& other) {
+            if (this == &other) {
+                return *this;
+            }
+            AdaptiveSequence copy(other);
+            swap(copy);
+            return *this;
+        }
+
+        AdaptiveSequence& operator=(AdaptiveSequence&& other) {
+            if (this == &other) {
+                return *this;
+            }
+            AdaptiveSequence taken(std::move(other));
+            swap(taken);
+            return *this;
+        }
+
+        bool isEmpty() const {
+            return getSize() == 0;
+        }
+
+        size_type getSize() const {
+            switch (layout) {
+                case Layout::Contiguous:
+                    return contiguous.size();
+                case Layout::Ring:
+                    return ring.size();
+                case Layout::Gap:
+                    return gap.size();
+                default:
+                    return chunked.size();
+            }
+        }
+
+        reference operator[](size_type index) {
+            noteRead(index);
+            return slot(index);
+        }
+
+        const_reference operator[](size_type index) const {
+            return slot(index);
+        }
+
+        void append(const Type& item) {
+            insert(cend(), item);
+        }
+
+        void prepend(const Type& item) {
+            insert(cbegin(), item);
+        }
+
+        void insert(const const_iterator& insertPosition, const Type& item) {
+            size_type index = insertPosition.index();
+            if (index > getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            Type copy(item);
+            noteEdit(index, 0);
+            insertAt(index, std::move(copy));
+        }
+
+        Type popFirst() {
+            if (isEmpty()) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            noteEdit(0, 1);
+            Type val = std::move(slot(0));
+            eraseAt(0, 1);
+            return val;
+        }
+
+        Type popLast() {
+            if (isEmpty()) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            size_type index = getSize() - 1;
+            noteEdit(index, 1);
+            Type val = std::move(slot(index));
+            eraseAt(index, 1);
+            return val;
+        }
+
+        void erase(const const_iterator& position) {
+            if (position.index() >= getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            erase(position, position + 1);
+        }
+
+        void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded) {
+            size_type first = firstIncluded.index();
+            size_type last = lastExcluded.index();
+            if (first > last || last > getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            if (first == last) {
+                return;
+            }
+            noteEdit(first, last - first);
+            eraseAt(first, last - first);
+        }
+
+        Layout getLayout() const {
+            return layout;
+        }
+
+        // Moves the elements into the given layout now, automatic switching may still move them later.
+        void setLayout(Layout target) {
+            if (target != layout) {
+                switchTo(target);
+            }
+        }
+
+        // With adaptation off the counters keep running, but the layout only changes through setLayout.
+        void setAdaptive(bool enabled) {
+            adaptive = enabled;
+        }
+
+        bool isAdaptive() const {
+            return adaptive;
+        }
+
+        const Stats& getStats() const {
+            return stats;
+        }
+
+        static const char* layoutName(Layout layout) {
+            switch (layout) {
+                case Layout::Contiguous:
+                    return "contiguous";
+                case Layout::Ring:
+                    return "ring";
+                case Layout::Gap:
+                    return "gap";
+                default:
+                    return "chunked";
+            }
+        }
+
+        iterator begin() {
+            return iterator(0, *this);
+        }
+
+        iterator end() {
+            return iterator(getSize(), *this);
+        }
+
+        const_iterator cbegin() const {
+            return const_iterator(0, *this);
+        }
+
+        const_iterator cend() const {
+            return const_iterator(getSize(), *this);
+        }
+
+        const_iterator begin() const {
+            return cbegin();
+        }
+
+        const_iterator end() const {
+            return cend();
+        }
+
+    private:
+        using ChunkedLayout = detail::ChunkedLayout<Type>;
+
+        static size_type distance(size_type a, size_type b) {
+            return a > b ? a - b : b - a;
+        }
+
+        // Charges an insertion (length 0) or removal of length elements at index to every layout.
+        void noteEdit(size_type index, size_type length) {
+            size_type size = getSize();
+            // a layout that has already spent a few conversions worth of work is not kept for the whole window
+            if (window_ops >= DECISION_WINDOW
+                    || window[size_type(layout)] > EARLY_DECISION_FACTOR * size + DECISION_WINDOW) {
+                reconsider();
+            }
+            size_type after = size - index - length;
+            size_type nearer = std::min(index, after);
+            size_type moved = distance(index, last_edit);
+            if (after == 0) {
+                ++stats.backEdits;
+            }
+            else if (index == 0) {
+                ++stats.frontEdits;
+            }
+            else {
+                ++stats.middleEdits;
+            }
+            window[size_type(Layout::Contiguous)] += 1 + after;
+            window[size_type(Layout::Ring)] += 1 + nearer;
+            window[size_type(Layout::Gap)] += 1 + moved;
+            window[size_type(Layout::Chunked)] += 1 + (after == 0 ? 0 : ChunkedLayout::CHUNK_SIZE / 2)
+                                                  + std::min(moved, nearer) / ChunkedLayout::CHUNK_SIZE;
+            last_edit = length == 0 ? index + 1 : index;
+            ++window_ops;
+        }
+
+        // Reads cost the same everywhere except the chunked list, where a jump has to walk the chunks.
+        void noteRead(size_type index) {
+            size_type jump = distance(index, last_read);
+            ++stats.reads;
+            for (size_type i = 0; i < LAYOUT_COUNT; ++i) {
+                ++window[i];
+            }
+            if (jump > 1) {
+                size_type nearer = std::min(std::min(jump, index), getSize() - index);
+                window[size_type(Layout::Chunked)] += nearer / ChunkedLayout::CHUNK_SIZE;
+            }
+            last_read = index;
+            ++window_ops;
+        }
+
+        void reconsider() {
+            size_type current = size_type(layout);
+            size_type best = current;
+            for (size_type i = 0; i < LAYOUT_COUNT; ++i) {
+                stats.windowCosts[i] = window[i];
+                window[i] = 0;
+                if (stats.windowCosts[i] < stats.windowCosts[best]) {
+                    best = i;
+                }
+            }
+            window_ops = 0;
+            if (adaptive && best != current && stats.windowCosts[best] * 2 < stats.windowCosts[current]
+                    && stats.windowCosts[current] - stats.windowCosts[best] > getSize()) {
+                switchTo(Layout(best));
+            }
+        }
+
+        void switchTo(Layout target) {
+            ++edits;
+            switch (target) {
+                case Layout::Contiguous:
+                    moveInto(contiguous);
+                    break;
+                case Layout::Ring:
+                    moveInto(ring);
+                    break;
+                case Layout::Gap:
+                    moveInto(gap);
+                    break;
+                default:
+                    moveInto(chunked);
+                    break;
+            }
+            layout = target;
+            ++stats.switches;
+        }
+
+        template <typename Target>
+        void moveInto(Target& target) {
+            switch (layout) {
+                case Layout::Contiguous:
+                    transfer(contiguous, target);
+                    break;
+                case Layout::Ring:
+                    transfer(ring, target);
+                    break;
+                case Layout::Gap:
+                    transfer(gap, target);
+                    break;
+                default:
+                    transfer(chunked, target);
+                    break;
+            }
+        }
+
+        template <typename Source, typename Target>
+        static void transfer(Source& source, Target& target) {
+            size_type size = source.size();
+            target.reserve(size);
+            for (size_type i = 0; i < size; ++i) {
+                target.insert(i, std::move(source.at(i)));
+            }
+            source.clear();
+        }
+
+        Type& slot(size_type index) {
+            switch (layout) {
+                case Layout::Contiguous:
+                    return contiguous.at(index);
+                case Layout::Ring:
+                    return ring.at(index);
+                case Layout::Gap:
+                    return gap.at(index);
+                default:
+                    return chunked.at(index);
+            }
+        }
+
+        const Type& slot(size_type index) const {
+            switch (layout) {
+                case Layout::Contiguous:
+                    return contiguous.at(index);
+                case Layout::Ring:
+                    return ring.at(index);
+                case Layout::Gap:
+                    return gap.at(index);
+                default:
+                    return chunked.at(index);
+            }
+        }
+
+        // Const lookup for iterators, which keep their own chunk cursor while the sequence is unchanged.
+        const Type& read(size_type index, typename ChunkedLayout::Cursor& near, size_type& nearEdits) const {
+            if (layout != Layout::Chunked) {
+                return slot(index);
+            }
+            if (nearEdits != edits) {
+                near = typename ChunkedLayout::Cursor();
+                nearEdits = edits;
+            }
+            return chunked.at(index, near);
+        }
+
+        void insertAt(size_type index, Type&& item) {
+            ++edits;
+            switch (layout) {
+                case Layout::Contiguous:
+                    contiguous.insert(index, std::move(item));
+                    break;
+                case Layout::Ring:
+                    ring.insert(index, std::move(item));
+                    break;
+                case Layout::Gap:
+                    gap.insert(index, std::move(item));
+                    break;
+                default:
+                    chunked.insert(index, std::move(item));
+                    break;
+            }
+        }
+
+        void eraseAt(size_type index, size_type length) {
+            ++edits;
+            switch (layout) {
+                case Layout::Contiguous:
+                    contiguous.erase(index, length);
+                    break;
+                case Layout::Ring:
+                    ring.erase(index, length);
+                    break;
+                case Layout::Gap:
+                    gap.erase(index, length);
+                    break;
+                default:
+                    chunked.erase(index, length);
+                    break;
+            }
+        }
+
+        void reserve(size_type capacity) {
+            switch (layout) {
+                case Layout::Contiguous:
+                    contiguous.reserve(capacity);
+                    break;
+                case Layout::Ring:
+                    ring.reserve(capacity);
+                    break;
+                case Layout::Gap:
+                    gap.reserve(capacity);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        void swap(AdaptiveSequence& other) {
+            std::swap(layout, other.layout);
+            std::swap(adaptive, other.adaptive);
+            std::swap(stats, other.stats);
+            std::swap(window, other.window);
+            std::swap(window_ops, other.window_ops);
+            std::swap(last_edit, other.last_edit);
+            std::swap(last_read, other.last_read);
+            // both contents change, so cursors taken on either of them must not match afterwards
+            edits = other.edits = std::max(edits, other.edits) + 1;
+            contiguous.swap(other.contiguous);
+            ring.swap(other.ring);
+            gap.swap(other.gap);
+            chunked.swap(other.chunked);
+        }
+
+        Layout layout;
+        bool adaptive;
+        Stats stats;
+        size_type window[LAYOUT_COUNT];
+        size_type window_ops;
+        size_type last_edit;
+        size_type last_read;
+        // bumped by every change of the contents, invalidates the cursors kept by iterators
+        size_type edits;
+        detail::ContiguousLayout<Type> contiguous;
+        detail::RingLayout<Type> ring;
+        detail::GapLayout<Type> gap;
+        detail::ChunkedLayout<Type> chunked;
+    };
+
+    template <typename Type>
+    class AdaptiveSequence<Type>::ConstIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename AdaptiveSequence::value_type;
+        using difference_type = typename AdaptiveSequence::difference_type;
+        using pointer = typename AdaptiveSequence::const_pointer;
+        using reference = typename AdaptiveSequence::const_reference;
+
+        explicit ConstIterator(size_type idx, const AdaptiveSequence<Type>& parent)
+                : current_index(idx), parent(&parent), near_edits(0) {}
+
+        reference operator*() const {
+            if (current_index >= parent->getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            return parent->read(current_index, near, near_edits);
+        }
+
+        pointer operator->() const {
+            return &operator*();
+        }
+
+        size_type index() const {
+            return current_index;
+        }
+
+        ConstIterator& operator++() {
+            if (current_index >= parent->getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            ++current_index;
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator result = *this;
+            operator++();
+            return result;
+        }
+
+        ConstIterator& operator--() {
+            if (current_index == 0) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            --current_index;
+            return *this;
+        }
+
+        ConstIterator operator--(int) {
+            ConstIterator result = *this;
+            operator--();
+            return result;
+        }
+
+        ConstIterator& operator+=(difference_type d) {
+            current_index += d;
+            return *this;
+        }
+
+        ConstIterator& operator-=(difference_type d) {
+            current_index -= d;
+            return *this;
+        }
+
+        ConstIterator operator+(difference_type d) const {
+            ConstIterator new_iter = *this;
+            new_iter += d;
+            return new_iter;
+        }
+
+        difference_type operator-(const ConstIterator& other) const {
+            return difference_type(current_index) - difference_type(other.current_index);
+        }
+
+        ConstIterator operator-(difference_type d) const {
+            ConstIterator new_iter = *this;
+            new_iter -= d;
+            return new_iter;
+        }
+
+        bool operator==(const ConstIterator& other) const {
+            return current_index == other.current_index;
+        }
+
+        bool operator!=(const ConstIterator& other) const {
+            return !(*this == other);
+        }
+
+        bool operator<(const ConstIterator& other) const {
+            return current_index < other.current_index;
+        }
+
+        bool operator>(const ConstIterator& other) const {
+            return other < *this;
+        }
+
+        bool operator<=(const ConstIterator& other) const {
+            return !(other < *this);
+        }
+
+        bool operator>=(const ConstIterator& other) const {
+            return !(*this < other);
+        }
+
+    protected:
+        size_type current_index;
+        const AdaptiveSequence<Type>* parent;
+
+    private:
+        // where the last dereference ended in a chunked layout, owned by this iterator alone
+        mutable typename AdaptiveSequence::ChunkedLayout::Cursor near;
+        mutable size_type near_edits;
+    };
+
+    template <typename Type>
+    class AdaptiveSequence<Type>::Iterator : public AdaptiveSequence<Type>::ConstIterator {
+    public:
+        using pointer = typename AdaptiveSequence::pointer;
+        using reference = typename AdaptiveSequence::reference;
+
+        explicit Iterator(size_type idx, AdaptiveSequence<Type>& parent) : ConstIterator(idx, parent) {}
+
+        Iterator(const ConstIterator& other)
+                : ConstIterator(other) {}
+
+        Iterator& operator++() {
+            ConstIterator::operator++();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto result = *this;
+            ConstIterator::operator++();
+            return result;
+        }
+
+        Iterator& operator--() {
+            ConstIterator::operator--();
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            auto result = *this;
+            ConstIterator::operator--();
+            return result;
+        }
+
+        Iterator operator+(difference_type d) const {
+            return ConstIterator::operator+(d);
+        }
+
+        Iterator operator-(difference_type d) const {
+            return ConstIterator::operator-(d);
+        }
+
+        reference operator*() const {
+            // ugly cast, yet reduces code duplication.
+            return const_cast<reference>(ConstIterator::operator*());
+        }
+
+        pointer operator->() const {
+            return &operator*();
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_ADAPTIVESEQUENCE_H
@@ -0,0 +1,115 @@
+#ifndef AISDI_LINEAR_ALLOCATORS_H
+#define AISDI_LINEAR_ALLOCATORS_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <limits>
+#include <type_traits>
+#include <algorithm>
+
+namespace aisdi {
+
+    namespace detail {
+
+        // Memory from operator new is already aligned for fundamental types, stricter alignments go through posix_memalign.
+        inline void* allocateAligned(std::size_t bytes, std::size_t alignment) {
+            if (alignment <= alignof(std::max_align_t)) {
+                return ::operator new(bytes);
+            }
+            void* memory = nullptr;
+            if (posix_memalign(&memory, alignment, std::max(bytes, alignment)) != 0) {
+                throw std::bad_alloc();
+            }
+            return memory;
+        }
+
+        inline void deallocateAligned(void* memory, std::size_t alignment) {
+            if (alignment <= alignof(std::max_align_t)) {
+                ::operator delete(memory);
+            }
+            else {
+                std::free(memory);
+            }
+        }
+
+        template <std::size_t Alignment>
+        const void* assumeAligned(const void* memory) {
+#if defined(__GNUC__)
+            return __builtin_assume_aligned(memory, Alignment);
+#else
+            return memory;
+#endif
+        }
+
+        template <std::size_t Alignment>
+        void* assumeAligned(void* memory) {
+#if defined(__GNUC__)
+            return __builtin_assume_aligned(memory, Alignment);
+#else
+            return memory;
+#endif
+        }
+
+    }
+
+    // Stateless allocator returning memory aligned to at least Alignment bytes.
+    template <typename Type, std::size_t Alignment>
+    class AlignedAllocator {
+        static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+    public:
+        using value_type = Type;
+
+        template <typename Other>
+        struct rebind {
+            using other = AlignedAllocator<Other, Alignment>;
+        };
+
+        AlignedAllocator() {}
+
+        template <typename Other>
+        AlignedAllocator(const AlignedAllocator<Other, Alignment>&) {}
+
+        Type* allocate(std::size_t count) {
+            if (count > std::numeric_limits<std::size_t>::max() / sizeof(Type)) {
+                throw std::bad_alloc();
+            }
+            return static_cast<Type*>(detail::allocateAligned(count * sizeof(Type), ALIGNMENT));
+        }
+
+        void deallocate(Type* memory, std::size_t) {
+            detail::deallocateAligned(memory, ALIGNMENT);
+        }
+
+    private:
+        static const std::size_t ALIGNMENT = Alignment > alignof(Type) ? Alignment : alignof(Type);
+    };
+
+    template <typename Type, typename Other, std::size_t Alignment>
+    bool operator==(const AlignedAllocator<Type, Alignment>&, const AlignedAllocator<Other, Alignment>&) {
+        return true;
+    }
+
+    template <typename Type, typename Other, std::size_t Alignment>
+    bool operator!=(const AlignedAllocator<Type, Alignment>&, const AlignedAllocator<Other, Alignment>&) {
+        return false;
+    }
+
+    // Guaranteed alignment of the memory an allocator hands out. Specialize it for custom allocators
+    // so that containers can pad their capacity and tell the compiler about it.
+    template <typename Alloc>
+    struct AllocatorAlignment : std::integral_constant<std::size_t, alignof(typename Alloc::value_type)> {};
+
+    template <typename Type, std::size_t Alignment>
+    struct AllocatorAlignment<AlignedAllocator<Type, Alignment>>
+            : std::integral_constant<std::size_t, (Alignment > alignof(Type) ? Alignment : alignof(Type))> {};
+
+    // True for allocators whose deallocate() is a no-op because memory is reclaimed all at once,
+    // containers may then drop trivially destructible storage without walking it.
+    template <typename Alloc>
+    struct AllocatorReleasesInBulk : std::false_type {};
+
+}
+
+#endif // AISDI_LINEAR_ALLOCATORS_H
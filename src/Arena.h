@@ -0,0 +1,168 @@
+#ifndef AISDI_LINEAR_ARENA_H
+#define AISDI_LINEAR_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+
+#include "Allocators.h"
+
+namespace aisdi {
+
+    // Monotonic bump-pointer allocator. Memory comes from the optional seed buffer first, then from
+    // heap chunks; nothing is freed until reset() or destruction, which release everything at once.
+    class Arena {
+    public:
+        using size_type = std::size_t;
+
+        static const size_type DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+        explicit Arena(size_type chunkSize = DEFAULT_CHUNK_SIZE)
+                : Arena(nullptr, 0, chunkSize) {}
+
+        // The seed buffer (e.g. on the stack) has to outlive the arena.
+        Arena(void* buffer, size_type bytes, size_type chunkSize = DEFAULT_CHUNK_SIZE)
+                : seed(static_cast<char*>(buffer)), seed_size(bytes), chunk_size(chunkSize), chunks(nullptr),
+                  used_bytes(0) {
+            if (chunkSize == 0) {
+                throw std::invalid_argument("Arena chunk size must be positive");
+            }
+            current = seed;
+            limit = seed + seed_size;
+        }
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        ~Arena() {
+            releaseChunks();
+        }
+
+        void* allocate(size_type bytes, size_type alignment = alignof(std::max_align_t)) {
+            char* start = alignUp(current, alignment);
+            if (current == nullptr || start > limit || bytes > size_type(limit - start)) {
+                addChunk(bytes, alignment);
+                start = alignUp(current, alignment);
+            }
+            current = start + bytes;
+            used_bytes += bytes;
+            return start;
+        }
+
+        // Forgets every allocation and returns the heap chunks, containers using the arena must be gone.
+        void reset() {
+            releaseChunks();
+            current = seed;
+            limit = seed + seed_size;
+            used_bytes = 0;
+        }
+
+        size_type getUsedBytes() const {
+            return used_bytes;
+        }
+
+        // Seed buffer plus all heap chunks.
+        size_type getReservedBytes() const {
+            size_type total = seed_size;
+            for (Chunk* chunk = chunks; chunk != nullptr; chunk = chunk->previous) {
+                total += chunk->size;
+            }
+            return total;
+        }
+
+    private:
+        struct Chunk {
+            Chunk* previous;
+            size_type size;
+        };
+
+        static char* alignUp(char* address, size_type alignment) {
+            std::uintptr_t value = reinterpret_cast<std::uintptr_t>(address);
+            return address + ((alignment - value % alignment) % alignment);
+        }
+
+        void addChunk(size_type bytes, size_type alignment) {
+            const size_type overhead = sizeof(Chunk) + alignment;
+            if (bytes > std::numeric_limits<size_type>::max() - overhead) {
+                throw std::bad_alloc();
+            }
+            // requests larger than a chunk get a chunk of their own
+            size_type size = std::max(chunk_size, bytes + overhead);
+            Chunk* chunk = static_cast<Chunk*>(::operator new(size));
+            chunk->previous = chunks;
+            chunk->size = size;
+            chunks = chunk;
+            current = reinterpret_cast<char*>(chunk + 1);
+            limit = reinterpret_cast<char*>(chunk) + size;
+        }
+
+        void releaseChunks() {
+            while (chunks != nullptr) {
+                Chunk* previous = chunks->previous;
+                ::operator delete(chunks);
+                chunks = previous;
+            }
+        }
+
+        char* seed;
+        size_type seed_size;
+        size_type chunk_size;
+        Chunk* chunks;
+        char* current;
+        char* limit;
+        size_type used_bytes;
+    };
+
+    // Standard allocator drawing from an Arena, deallocate() is a no-op.
+    template <typename Type>
+    class ArenaAllocator {
+    public:
+        using value_type = Type;
+
+        template <typename Other>
+        struct rebind {
+            using other = ArenaAllocator<Other>;
+        };
+
+        explicit ArenaAllocator(Arena& arena) : arena(&arena) {}
+
+        template <typename Other>
+        ArenaAllocator(const ArenaAllocator<Other>& other) : arena(&other.getArena()) {}
+
+        Type* allocate(std::size_t count) {
+            if (count > std::numeric_limits<std::size_t>::max() / sizeof(Type)) {
+                throw std::bad_alloc();
+            }
+            return static_cast<Type*>(arena->allocate(count * sizeof(Type), alignof(Type)));
+        }
+
+        void deallocate(Type*, std::size_t) {}
+
+        Arena& getArena() const {
+            return *arena;
+        }
+
+    private:
+        Arena* arena;
+    };
+
+    template <typename Type, typename Other>
+    bool operator==(const ArenaAllocator<Type>& lhs, const ArenaAllocator<Other>& rhs) {
+        return &lhs.getArena() == &rhs.getArena();
+    }
+
+    template <typename Type, typename Other>
+    bool operator!=(const ArenaAllocator<Type>& lhs, const ArenaAllocator<Other>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    template <typename Type>
+    struct AllocatorReleasesInBulk<ArenaAllocator<Type>> : std::true_type {};
+
+}
+
+#endif // AISDI_LINEAR_ARENA_H
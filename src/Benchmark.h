@@ -0,0 +1,511 @@
+#ifndef AISDI_LINEAR_BENCHMARK_H
+#define AISDI_LINEAR_BENCHMARK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace aisdi {
+
+    namespace bench {
+
+        // Wall clock time which never goes backwards, unlike std::clock it does not stop while the process sleeps.
+        using Clock = std::chrono::steady_clock;
+
+        // One timed batch: how long it took, how many operations it covered and, when the case timed them one
+        // by one, the time of every operation.
+        struct Sample {
+            Clock::duration elapsed;
+            std::size_t operations;
+            std::vector<Clock::duration> laps;
+        };
+
+        class Stopwatch {
+        public:
+            // Room for the given number of laps is reserved before the clock starts.
+            explicit Stopwatch(std::size_t expectedLaps = 0) {
+                laps.reserve(expectedLaps);
+                start = lap_start = Clock::now();
+            }
+
+            // Ends the timing of one operation and starts the next one; each lap includes one clock read.
+            void lap() {
+                const Clock::time_point now = Clock::now();
+                laps.push_back(now - lap_start);
+                lap_start = now;
+            }
+
+            Sample stop(std::size_t operations) const {
+                return Sample{Clock::now() - start, operations, laps};
+            }
+
+        private:
+            std::vector<Clock::duration> laps;
+            Clock::time_point start;
+            Clock::time_point lap_start;
+        };
+
+        struct Config {
+            std::vector<std::size_t> sizes{10, 100, 1000, 10000, 100000};
+            // Runs of every case; mean and deviation are taken over their per-operation means.
+            std::size_t repetitions = 5;
+            std::size_t warmups = 1;
+            // only cases whose name contains it are run
+            std::string filter;
+            // where the machine-readable reports go, nothing is written when empty
+            std::string csvPath;
+            std::string jsonPath;
+            bool help = false;
+        };
+
+        inline std::string usage(const std::string& program) {
+            return "usage: " + program + " [repetitions] [--repetitions=N] [--warmup=N] [--sizes=N,N,...]"
+                   " [--filter=TEXT] [--csv=PATH] [--json=PATH] [--help]";
+        }
+
+        inline std::size_t parseCount(const std::string& text, const std::string& option) {
+            std::size_t parsed = 0;
+            std::size_t value = 0;
+            try {
+                value = std::stoull(text, &parsed);
+            }
+            catch (const std::exception&) {
+                parsed = 0;
+            }
+            if (text.empty() || parsed != text.size() || text[0] == '-') {
+                throw std::invalid_argument("Invalid value of " + option + ": " + text);
+            }
+            return value;
+        }
+
+        inline std::vector<std::size_t> parseSizes(const std::string& list) {
+            std::vector<std::size_t> sizes;
+            std::size_t begin = 0;
+            while (begin <= list.size()) {
+                std::size_t comma = list.find(',', begin);
+                if (comma == std::string::npos) {
+                    comma = list.size();
+                }
+                std::size_t size = parseCount(list.substr(begin, comma - begin), "--sizes");
+                if (size == 0) {
+                    throw std::invalid_argument("Sizes have to be positive");
+                }
+                sizes.push_back(size);
+                begin = comma + 1;
+            }
+            return sizes;
+        }
+
+        // A bare number is the repetition count, so the old "aisdiLinear N" invocation keeps working.
+        inline Config parseArguments(int argc, const char* const* argv) {
+            Config config;
+            for (int i = 1; i < argc; ++i) {
+                const std::string argument = argv[i];
+                const std::size_t equals = argument.find('=');
+                const std::string option = argument.substr(0, equals);
+                const std::string value = equals == std::string::npos ? std::string() : argument.substr(equals + 1);
+                if (argument == "--help" || argument == "-h") {
+                    config.help = true;
+                }
+                else if (option == "--repetitions") {
+                    config.repetitions = parseCount(value, option);
+                }
+                else if (option == "--warmup") {
+                    config.warmups = parseCount(value, option);
+                }
+                else if (option == "--sizes") {
+                    config.sizes = parseSizes(value);
+                }
+                else if (option == "--filter") {
+                    config.filter = value;
+                }
+                else if (option == "--csv" || option == "--json") {
+                    if (value.empty()) {
+                        throw std::invalid_argument("Missing path of " + option);
+                    }
+                    (option == "--csv" ? config.csvPath : config.jsonPath) = value;
+                }
+                else if (argument.compare(0, 1, "-") != 0) {
+                    config.repetitions = parseCount(argument, "repetitions");
+                }
+                else {
+                    throw std::invalid_argument("Unknown option: " + argument);
+                }
+            }
+            if (config.repetitions == 0) {
+                throw std::invalid_argument("At least one repetition is needed");
+            }
+            return config;
+        }
+
+        // Log-linear histogram in the spirit of HdrHistogram. Values below 2^SUB_BUCKET_BITS are counted exactly,
+        // above that every power of two is split into 2^(SUB_BUCKET_BITS - 1) buckets, so a reported value is off
+        // by less than 1.6% however large it is. Memory grows with the logarithm of the largest value.
+        class Histogram {
+        public:
+            static const unsigned SUB_BUCKET_BITS = 7;
+
+            Histogram() : total(0), lowest(0), highest(0) {}
+
+            void record(std::uint64_t value) {
+                const std::size_t index = bucketOf(value);
+                if (index >= counts.size()) {
+                    counts.resize(index + 1, 0);
+                }
+                ++counts[index];
+                lowest = total == 0 || value < lowest ? value : lowest;
+                highest = value > highest ? value : highest;
+                ++total;
+            }
+
+            std::uint64_t count() const {
+                return total;
+            }
+
+            std::uint64_t min() const {
+                return lowest;
+            }
+
+            std::uint64_t max() const {
+                return highest;
+            }
+
+            // Middle of the bucket holding the value of the given rank, kept within the recorded range.
+            std::uint64_t valueAtQuantile(double quantile) const {
+                if (total == 0) {
+                    return 0;
+                }
+                std::uint64_t rank = std::uint64_t(std::ceil(quantile * total));
+                rank = rank == 0 ? 1 : (rank > total ? total : rank);
+                std::uint64_t seen = 0;
+                for (std::size_t i = 0; i < counts.size(); ++i) {
+                    seen += counts[i];
+                    if (seen >= rank) {
+                        const std::uint64_t middle = bucketLow(i) + (bucketHigh(i) - bucketLow(i)) / 2;
+                        return middle < lowest ? lowest : (middle > highest ? highest : middle);
+                    }
+                }
+                return highest;
+            }
+
+            // Values in buckets entirely below (above) the bucket of the given value.
+            std::uint64_t countBelow(std::uint64_t value) const {
+                std::uint64_t below = 0;
+                for (std::size_t i = 0; i < counts.size() && i < bucketOf(value); ++i) {
+                    below += counts[i];
+                }
+                return below;
+            }
+
+            std::uint64_t countAbove(std::uint64_t value) const {
+                std::uint64_t above = 0;
+                for (std::size_t i = bucketOf(value) + 1; i < counts.size(); ++i) {
+                    above += counts[i];
+                }
+                return above;
+            }
+
+            std::size_t bucketCount() const {
+                return counts.size();
+            }
+
+            std::uint64_t countAt(std::size_t bucket) const {
+                return counts[bucket];
+            }
+
+            static std::size_t bucketOf(std::uint64_t value) {
+                if (value < SUB_BUCKETS) {
+                    return std::size_t(value);
+                }
+                const unsigned shift = highestBit(value) - SUB_BUCKET_BITS + 1;
+                return std::size_t(SUB_BUCKETS + (shift - 1) * (SUB_BUCKETS / 2) + ((value >> shift) - SUB_BUCKETS / 2));
+            }
+
+            static std::uint64_t bucketLow(std::size_t bucket) {
+                if (bucket < SUB_BUCKETS) {
+                    return bucket;
+                }
+                const std::uint64_t above = bucket - SUB_BUCKETS;
+                const unsigned shift = unsigned(above / (SUB_BUCKETS / 2)) + 1;
+                return (SUB_BUCKETS / 2 + above % (SUB_BUCKETS / 2)) << shift;
+            }
+
+            static std::uint64_t bucketHigh(std::size_t bucket) {
+                return bucketLow(bucket + 1) - 1;
+            }
+
+        private:
+            static const std::uint64_t SUB_BUCKETS = std::uint64_t(1) << SUB_BUCKET_BITS;
+
+            static unsigned highestBit(std::uint64_t value) {
+#if defined(__GNUC__)
+                return unsigned(sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(value));
+#else
+                unsigned bit = 0;
+                while (value >>= 1) {
+                    ++bit;
+                }
+                return bit;
+#endif
+            }
+
+            std::vector<std::uint64_t> counts;
+            std::uint64_t total;
+            std::uint64_t lowest;
+            std::uint64_t highest;
+        };
+
+        // Samples outside Tukey's fences: more than 1.5 interquartile ranges below the first or above the third quartile.
+        struct Outliers {
+            std::uint64_t low;
+            std::uint64_t high;
+        };
+
+        // Timings of one case at one size in nanoseconds. The distribution (min, percentiles, max, outliers) holds
+        // single operations, or whole batches for cases too fast to time one by one; mean and deviation are taken
+        // over the per-operation means of the batches. The histogram holds picoseconds so that sub-nanosecond
+        // operations keep their resolution, mean and deviation are exact.
+        class Result {
+        public:
+            Result(const std::string& name, std::size_t size)
+                    : name(name), size(size), batch_count(0), running_mean(0), squared_deviations(0) {}
+
+            void add(double nanos) {
+                const double picos = nanos * PICOS_PER_NANO;
+                histogram.record(picos <= 0 ? 0 : std::uint64_t(picos + 0.5));
+            }
+
+            void addBatch(double nanosPerOperation) {
+                // Welford's update keeps the variance accurate when samples are large and close together
+                ++batch_count;
+                const double delta = nanosPerOperation - running_mean;
+                running_mean += delta / batch_count;
+                squared_deviations += delta * (nanosPerOperation - running_mean);
+            }
+
+            std::uint64_t count() const {
+                return histogram.count();
+            }
+
+            std::uint64_t batches() const {
+                return batch_count;
+            }
+
+            double mean() const {
+                return running_mean;
+            }
+
+            // Sample standard deviation of the batch means, zero for fewer than two batches.
+            double stddev() const {
+                return batch_count < 2 ? 0 : std::sqrt(squared_deviations / (batch_count - 1));
+            }
+
+            double min() const {
+                return histogram.min() / PICOS_PER_NANO;
+            }
+
+            double max() const {
+                return histogram.max() / PICOS_PER_NANO;
+            }
+
+            double percentile(double percent) const {
+                return histogram.valueAtQuantile(percent / 100) / PICOS_PER_NANO;
+            }
+
+            double median() const {
+                return percentile(50);
+            }
+
+            Outliers outliers() const {
+                const std::uint64_t first = histogram.valueAtQuantile(0.25);
+                const std::uint64_t third = histogram.valueAtQuantile(0.75);
+                const std::uint64_t reach = (third - first) * 3 / 2;
+                return Outliers{first > reach ? histogram.countBelow(first - reach) : 0,
+                                histogram.countAbove(third + reach)};
+            }
+
+            // Recorded distribution, in picoseconds per operation.
+            const Histogram& getHistogram() const {
+                return histogram;
+            }
+
+            std::string name;
+            std::size_t size;
+
+        private:
+            static constexpr double PICOS_PER_NANO = 1000.0;
+
+            Histogram histogram;
+            std::uint64_t batch_count;
+            double running_mean;
+            double squared_deviations;
+        };
+
+        class Suite {
+        public:
+            // A case sets up its own data for the given size and times only the part it measures, lapping the
+            // stopwatch after every operation when they are slow enough to be timed one by one.
+            using Case = std::function<Sample(std::size_t size)>;
+
+            // Runs at every configured size.
+            void add(const std::string& name, Case run) {
+                cases.push_back(Entry{name, 0, std::move(run)});
+            }
+
+            // Runs once per repetition at its own size, whatever sizes are configured.
+            void addFixed(const std::string& name, std::size_t size, Case run) {
+                cases.push_back(Entry{name, size, std::move(run)});
+            }
+
+            std::vector<Result> run(const Config& config, std::ostream& progress) const {
+                std::vector<Result> results;
+                for (const Entry& entry : cases) {
+                    if (entry.name.find(config.filter) == std::string::npos) {
+                        continue;
+                    }
+                    const std::vector<std::size_t> sizes = entry.size == 0 ? config.sizes
+                                                                           : std::vector<std::size_t>{entry.size};
+                    for (std::size_t size : sizes) {
+                        progress << entry.name << " " << size << std::endl;
+                        for (std::size_t i = 0; i < config.warmups; ++i) {
+                            entry.run(size);
+                        }
+                        Result result(entry.name, size);
+                        for (std::size_t i = 0; i < config.repetitions; ++i) {
+                            const Sample sample = entry.run(size);
+                            const double nanos = std::chrono::duration<double, std::nano>(sample.elapsed).count();
+                            const double perOperation = nanos / (sample.operations == 0 ? 1 : sample.operations);
+                            result.addBatch(perOperation);
+                            if (sample.laps.empty()) {
+                                result.add(perOperation);
+                            }
+                            for (Clock::duration lap : sample.laps) {
+                                result.add(std::chrono::duration<double, std::nano>(lap).count());
+                            }
+                        }
+                        results.push_back(result);
+                    }
+                }
+                return results;
+            }
+
+        private:
+            struct Entry {
+                std::string name;
+                std::size_t size;
+                Case run;
+            };
+
+            std::vector<Entry> cases;
+        };
+
+        inline void printResults(const std::vector<Result>& results, std::ostream& out) {
+            const char* const columns[] = {"min", "median", "p90", "p99", "p99.9", "max", "mean", "stddev"};
+            out << std::left << std::setw(36) << "benchmark (ns/op)" << std::right << std::setw(10) << "size"
+                << std::setw(9) << "samples" << std::setw(9) << "batches";
+            for (const char* column : columns) {
+                out << std::setw(13) << column;
+            }
+            out << std::setw(11) << "outliers" << std::endl;
+            out << std::fixed << std::setprecision(2);
+            for (const Result& result : results) {
+                const Outliers outliers = result.outliers();
+                out << std::left << std::setw(36) << result.name << std::right << std::setw(10) << result.size
+                    << std::setw(9) << result.count() << std::setw(9) << result.batches()
+                    << std::setw(13) << result.min()
+                    << std::setw(13) << result.median() << std::setw(13) << result.percentile(90)
+                    << std::setw(13) << result.percentile(99) << std::setw(13) << result.percentile(99.9)
+                    << std::setw(13) << result.max() << std::setw(13) << result.mean()
+                    << std::setw(13) << result.stddev() << std::setw(11) << outliers.low + outliers.high << std::endl;
+            }
+        }
+
+        inline std::string csvField(const std::string& text) {
+            if (text.find_first_of(",\"\n") == std::string::npos) {
+                return text;
+            }
+            std::string quoted = "\"";
+            for (char c : text) {
+                quoted += c == '"' ? std::string("\"\"") : std::string(1, c);
+            }
+            return quoted + "\"";
+        }
+
+        // One row per case and size, times in nanoseconds per operation.
+        inline void writeCsv(const std::vector<Result>& results, std::ostream& out) {
+            out << "benchmark,size,samples,batches,min_ns,median_ns,p90_ns,p99_ns,p999_ns,max_ns,mean_ns,stddev_ns,"
+                   "low_outliers,high_outliers\n";
+            out << std::fixed << std::setprecision(3);
+            for (const Result& result : results) {
+                const Outliers outliers = result.outliers();
+                out << csvField(result.name) << ',' << result.size << ',' << result.count() << ','
+                    << result.batches() << ',' << result.min() << ',' << result.median() << ',' << result.percentile(90) << ','
+                    << result.percentile(99) << ',' << result.percentile(99.9) << ',' << result.max() << ','
+                    << result.mean() << ',' << result.stddev() << ',' << outliers.low << ',' << outliers.high << '\n';
+            }
+        }
+
+        inline std::string jsonString(const std::string& text) {
+            std::string quoted = "\"";
+            for (char c : text) {
+                if (c == '"' || c == '\\') {
+                    quoted += '\\';
+                    quoted += c;
+                }
+                else if (static_cast<unsigned char>(c) < 0x20) {
+                    const char* const digits = "0123456789abcdef";
+                    quoted += "\\u00";
+                    quoted += digits[(c >> 4) & 0xf];
+                    quoted += digits[c & 0xf];
+                }
+                else {
+                    quoted += c;
+                }
+            }
+            return quoted + "\"";
+        }
+
+        // Same statistics as the CSV plus the non-empty histogram buckets as [low_ns, high_ns, count] triples,
+        // enough to chart the whole distribution.
+        inline void writeJson(const std::vector<Result>& results, std::ostream& out) {
+            out << std::fixed << std::setprecision(3);
+            out << "{\"results\":[";
+            for (std::size_t i = 0; i < results.size(); ++i) {
+                const Result& result = results[i];
+                const Outliers outliers = result.outliers();
+                const Histogram& histogram = result.getHistogram();
+                out << (i == 0 ? "\n" : ",\n") << "{\"name\":" << jsonString(result.name)
+                    << ",\"size\":" << result.size << ",\"samples\":" << result.count()
+                    << ",\"batches\":" << result.batches()
+                    << ",\"min_ns\":" << result.min() << ",\"median_ns\":" << result.median()
+                    << ",\"p90_ns\":" << result.percentile(90) << ",\"p99_ns\":" << result.percentile(99)
+                    << ",\"p999_ns\":" << result.percentile(99.9) << ",\"max_ns\":" << result.max()
+                    << ",\"mean_ns\":" << result.mean() << ",\"stddev_ns\":" << result.stddev()
+                    << ",\"low_outliers\":" << outliers.low << ",\"high_outliers\":" << outliers.high
+                    << ",\"histogram\":[";
+                bool first = true;
+                for (std::size_t bucket = 0; bucket < histogram.bucketCount(); ++bucket) {
+                    if (histogram.countAt(bucket) == 0) {
+                        continue;
+                    }
+                    out << (first ? "" : ",") << '[' << Histogram::bucketLow(bucket) / 1000.0 << ','
+                        << Histogram::bucketHigh(bucket) / 1000.0 << ',' << histogram.countAt(bucket) << ']';
+                    first = false;
+                }
+                out << "]}";
+            }
+            out << "\n]}\n";
+        }
+
+    }
+
+}
+
+#endif // AISDI_LINEAR_BENCHMARK_H
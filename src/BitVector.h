@@ -0,0 +1,649 @@
+#ifndef AISDI_LINEAR_BITVECTOR_H
+#define AISDI_LINEAR_BITVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+
+#include "Vector.h"
+
+namespace aisdi {
+
+    namespace detail {
+
+        inline unsigned popcount(std::uint64_t word) {
+#if defined(__GNUC__)
+            return __builtin_popcountll(word);
+#else
+            unsigned count = 0;
+            for (; word != 0; word &= word - 1) {
+                ++count;
+            }
+            return count;
+#endif
+        }
+
+        inline unsigned trailingZeros(std::uint64_t word) {
+#if defined(__GNUC__)
+            return __builtin_ctzll(word);
+#else
+            unsigned count = 0;
+            for (; (word & 1) == 0; word >>= 1) {
+                ++count;
+            }
+            return count;
+#endif
+        }
+
+        // Position of the k-th (0-based) set bit of word, which must have more than k set bits.
+        inline unsigned selectInWord(std::uint64_t word, unsigned k) {
+            for (; k > 0; --k) {
+                word &= word - 1;
+            }
+            return trailingZeros(word);
+        }
+
+    }
+
+    // Bit-packed sequence of flags stored in 64-bit words. Bits past getSize() are always zero,
+    // so whole-word operations never need masking.
+    class BitVector {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = bool;
+        using word_type = std::uint64_t;
+
+        class Reference;
+        class ConstIterator;
+        class Iterator;
+        using reference = Reference;
+        using const_reference = bool;
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+        enum : size_type { npos = static_cast<size_type>(-1) };
+        static const size_type WORD_BITS = 64;
+
+        BitVector() : elements(0), rank_valid(false) {}
+
+        BitVector(std::initializer_list<bool> l) : BitVector() {
+            words.reserve(wordsFor(l.size()));
+            for (bool val : l) {
+                append(val);
+            }
+        }
+
+        explicit BitVector(size_type count, bool value = false) : elements(count), rank_valid(false) {
+            words.reserve(wordsFor(count));
+            for (size_type i = 0; i < wordsFor(count); ++i) {
+                words.append(value ? ~word_type(0) : 0);
+            }
+            clearUnusedBits();
+        }
+
+        bool isEmpty() const {
+            return getSize() == 0;
+        }
+
+        size_type getSize() const {
+            return elements;
+        }
+
+        const word_type* data() const {
+            return words.data();
+        }
+
+        size_type getWordCount() const {
+            return words.getSize();
+        }
+
+        bool get(size_type position) const {
+            checkPosition(position);
+            return (words.data()[position / WORD_BITS] >> (position % WORD_BITS)) & 1;
+        }
+
+        void set(size_type position, bool value = true) {
+            checkPosition(position);
+            word_type mask = word_type(1) << (position % WORD_BITS);
+            word_type& word = words.data()[position / WORD_BITS];
+            word = value ? (word | mask) : (word & ~mask);
+            rank_valid = false;
+        }
+
+        void flip(size_type position) {
+            checkPosition(position);
+            words.data()[position / WORD_BITS] ^= word_type(1) << (position % WORD_BITS);
+            rank_valid = false;
+        }
+
+        bool operator[](size_type position) const {
+            return get(position);
+        }
+
+        Reference operator[](size_type position);
+
+        void append(bool value) {
+            if (elements % WORD_BITS == 0) {
+                words.append(0);
+            }
+            ++elements;
+            set(elements - 1, value);
+        }
+
+        void prepend(bool value) {
+            insertAt(0, value);
+        }
+
+        void insert(const const_iterator& insertPosition, bool value);
+
+        bool popFirst() {
+            if (isEmpty()) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            bool val = get(0);
+            eraseRange(0, 1);
+            return val;
+        }
+
+        bool popLast() {
+            if (isEmpty()) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            bool val = get(elements - 1);
+            eraseRange(elements - 1, elements);
+            return val;
+        }
+
+        void erase(const const_iterator& position);
+
+        void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded);
+
+        size_type count() const {
+            size_type total = 0;
+            const word_type* it = words.data();
+            for (size_type i = 0; i < words.getSize(); ++i) {
+                total += detail::popcount(it[i]);
+            }
+            return total;
+        }
+
+        size_type findFirst() const {
+            return findFrom(0);
+        }
+
+        // First set bit after position, or npos.
+        size_type findNext(size_type position) const {
+            return position + 1 >= elements ? npos : findFrom(position + 1);
+        }
+
+        // Number of set bits in [0, position). Counts whole words from the start unless buildRankIndex()
+        // has run since the last modification.
+        size_type rank(size_type position) const {
+            if (position > elements) {
+                throw std::out_of_range("Position out of range");
+            }
+            size_type word = position / WORD_BITS;
+            size_type from = rank_valid ? word - word % WORDS_PER_BLOCK : 0;
+            size_type total = rank_valid ? rank_blocks.data()[word / WORDS_PER_BLOCK] : 0;
+            const word_type* it = words.data();
+            for (size_type i = from; i < word; ++i) {
+                total += detail::popcount(it[i]);
+            }
+            if (position % WORD_BITS != 0) {
+                total += detail::popcount(it[word] & ((word_type(1) << (position % WORD_BITS)) - 1));
+            }
+            return total;
+        }
+
+        // Position of the k-th (0-based) set bit, found through the rank index when it is current.
+        size_type select(size_type k) const {
+            size_type block = rank_valid ? blockHolding(k) : 0;
+            size_type remaining = k - (rank_valid ? rank_blocks.data()[block] : 0);
+            const word_type* it = words.data();
+            for (size_type i = block * WORDS_PER_BLOCK; i < words.getSize(); ++i) {
+                size_type ones = detail::popcount(it[i]);
+                if (remaining < ones) {
+                    return i * WORD_BITS + detail::selectInWord(it[i], remaining);
+                }
+                remaining -= ones;
+            }
+            throw std::out_of_range("Not enough set bits");
+        }
+
+        // Prefix counts of set bits for every block of WORDS_PER_BLOCK words, used by rank() and select()
+        // until the next modification. They never build it themselves, so const reads stay thread-safe.
+        void buildRankIndex() {
+            if (rank_valid) {
+                return;
+            }
+            rank_blocks = Vector<size_type>();
+            size_type total = 0;
+            const word_type* it = words.data();
+            for (size_type i = 0; i < words.getSize(); ++i) {
+                if (i % WORDS_PER_BLOCK == 0) {
+                    rank_blocks.append(total);
+                }
+                total += detail::popcount(it[i]);
+            }
+            rank_blocks.append(total);
+            rank_valid = true;
+        }
+
+        BitVector& operator&=(const BitVector& other) {
+            checkSameSize(other);
+            for (size_type i = 0; i < words.getSize(); ++i) {
+                words.data()[i] &= other.words.data()[i];
+            }
+            rank_valid = false;
+            return *this;
+        }
+
+        BitVector& operator|=(const BitVector& other) {
+            checkSameSize(other);
+            for (size_type i = 0; i < words.getSize(); ++i) {
+                words.data()[i] |= other.words.data()[i];
+            }
+            rank_valid = false;
+            return *this;
+        }
+
+        BitVector& operator^=(const BitVector& other) {
+            checkSameSize(other);
+            for (size_type i = 0; i < words.getSize(); ++i) {
+                words.data()[i] ^= other.words.data()[i];
+            }
+            rank_valid = false;
+            return *this;
+        }
+
+        iterator begin();
+
+        iterator end();
+
+        const_iterator cbegin() const;
+
+        const_iterator cend() const;
+
+        const_iterator begin() const;
+
+        const_iterator end() const;
+
+    private:
+        static const size_type WORDS_PER_BLOCK = 8;
+
+        static size_type wordsFor(size_type bits) {
+            return (bits + WORD_BITS - 1) / WORD_BITS;
+        }
+
+        void checkPosition(size_type position) const {
+            if (position >= elements) {
+                throw std::out_of_range("Position out of range");
+            }
+        }
+
+        void checkSameSize(const BitVector& other) const {
+            if (elements != other.elements) {
+                throw std::invalid_argument("BitVectors differ in size");
+            }
+        }
+
+        void clearUnusedBits() {
+            if (elements % WORD_BITS != 0) {
+                words.data()[words.getSize() - 1] &= (word_type(1) << (elements % WORD_BITS)) - 1;
+            }
+        }
+
+        // 64 bits starting at an arbitrary position, bits past the end read as zero.
+        word_type read64(size_type position) const {
+            size_type word = position / WORD_BITS;
+            size_type shift = position % WORD_BITS;
+            const word_type* it = words.data();
+            word_type bits = it[word] >> shift;
+            if (shift != 0 && word + 1 < words.getSize()) {
+                bits |= it[word + 1] << (WORD_BITS - shift);
+            }
+            return bits;
+        }
+
+        size_type findFrom(size_type position) const {
+            if (position >= elements) {
+                return npos;
+            }
+            size_type word = position / WORD_BITS;
+            const word_type* it = words.data();
+            word_type bits = it[word] & (~word_type(0) << (position % WORD_BITS));
+            while (bits == 0) {
+                if (++word == words.getSize()) {
+                    return npos;
+                }
+                bits = it[word];
+            }
+            return word * WORD_BITS + detail::trailingZeros(bits);
+        }
+
+        void eraseRange(size_type first, size_type last);
+
+        void insertAt(size_type position, bool value);
+
+        // Last block whose preceding count is <= k.
+        size_type blockHolding(size_type k) const {
+            const size_type* blocks = rank_blocks.data();
+            size_type low = 0;
+            size_type high = rank_blocks.getSize();
+            while (high - low > 1) {
+                size_type middle = (low + high) / 2;
+                if (blocks[middle] <= k) {
+                    low = middle;
+                }
+                else {
+                    high = middle;
+                }
+            }
+            return low;
+        }
+
+        Vector<word_type> words;
+        size_type elements;
+        Vector<size_type> rank_blocks;
+        bool rank_valid;
+    };
+
+    class BitVector::Reference {
+    public:
+        Reference(BitVector& parent, size_type position) : parent(&parent), position(position) {}
+
+        operator bool() const {
+            return parent->get(position);
+        }
+
+        Reference& operator=(bool value) {
+            parent->set(position, value);
+            return *this;
+        }
+
+        Reference& operator=(const Reference& other) {
+            return *this = bool(other);
+        }
+
+        void flip() {
+            parent->flip(position);
+        }
+
+    private:
+        BitVector* parent;
+        size_type position;
+    };
+
+    class BitVector::ConstIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = bool;
+        using difference_type = BitVector::difference_type;
+        using pointer = void;
+        using reference = bool;
+
+        explicit ConstIterator(size_type idx, const BitVector& parent) : current_index(idx), parent(&parent) {}
+
+        bool operator*() const {
+            if (current_index >= parent->getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            return parent->get(current_index);
+        }
+
+        size_type index() const {
+            return current_index;
+        }
+
+        ConstIterator& operator++() {
+            if (current_index >= parent->getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            ++current_index;
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator result = *this;
+            operator++();
+            return result;
+        }
+
+        ConstIterator& operator--() {
+            if (current_index == 0) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            --current_index;
+            return *this;
+        }
+
+        ConstIterator operator--(int) {
+            ConstIterator result = *this;
+            operator--();
+            return result;
+        }
+
+        ConstIterator& operator+=(difference_type d) {
+            current_index += d;
+            return *this;
+        }
+
+        ConstIterator& operator-=(difference_type d) {
+            current_index -= d;
+            return *this;
+        }
+
+        ConstIterator operator+(difference_type d) const {
+            return ConstIterator(current_index + d, *parent);
+        }
+
+        ConstIterator operator-(difference_type d) const {
+            return ConstIterator(current_index - d, *parent);
+        }
+
+        difference_type operator-(const ConstIterator& other) const {
+            return difference_type(current_index) - difference_type(other.current_index);
+        }
+
+        bool operator[](difference_type d) const {
+            return *(*this + d);
+        }
+
+        bool operator==(const ConstIterator& other) const {
+            return current_index == other.current_index;
+        }
+
+        bool operator!=(const ConstIterator& other) const {
+            return !(*this == other);
+        }
+
+        bool operator<(const ConstIterator& other) const {
+            return current_index < other.current_index;
+        }
+
+        bool operator>(const ConstIterator& other) const {
+            return other < *this;
+        }
+
+        bool operator<=(const ConstIterator& other) const {
+            return !(other < *this);
+        }
+
+        bool operator>=(const ConstIterator& other) const {
+            return !(*this < other);
+        }
+
+    protected:
+        size_type current_index;
+        const BitVector* parent;
+    };
+
+    class BitVector::Iterator : public BitVector::ConstIterator {
+    public:
+        using reference = BitVector::Reference;
+
+        explicit Iterator(size_type idx, BitVector& parent) : ConstIterator(idx, parent) {}
+
+        Iterator(const ConstIterator& other)
+                : ConstIterator(other) {}
+
+        Iterator& operator++() {
+            ConstIterator::operator++();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto result = *this;
+            ConstIterator::operator++();
+            return result;
+        }
+
+        Iterator& operator--() {
+            ConstIterator::operator--();
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            auto result = *this;
+            ConstIterator::operator--();
+            return result;
+        }
+
+        Iterator& operator+=(difference_type d) {
+            ConstIterator::operator+=(d);
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type d) {
+            ConstIterator::operator-=(d);
+            return *this;
+        }
+
+        Iterator operator+(difference_type d) const {
+            return ConstIterator::operator+(d);
+        }
+
+        using ConstIterator::operator-;
+
+        Iterator operator-(difference_type d) const {
+            return ConstIterator::operator-(d);
+        }
+
+        Reference operator*() const {
+            if (current_index >= parent->getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            // ugly cast, yet reduces code duplication.
+            return Reference(const_cast<BitVector&>(*parent), current_index);
+        }
+
+        Reference operator[](difference_type d) const {
+            return *(*this + d);
+        }
+    };
+
+    inline BitVector::Reference BitVector::operator[](size_type position) {
+        checkPosition(position);
+        return Reference(*this, position);
+    }
+
+    inline void BitVector::insert(const const_iterator& insertPosition, bool value) {
+        if (insertPosition.index() > elements) {
+            throw std::out_of_range("Iterator out of range");
+        }
+        insertAt(insertPosition.index(), value);
+    }
+
+    inline void BitVector::erase(const const_iterator& position) {
+        if (position.index() >= elements) {
+            throw std::out_of_range("Iterator out of range");
+        }
+        eraseRange(position.index(), position.index() + 1);
+    }
+
+    inline void BitVector::erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded) {
+        if (firstIncluded.index() > lastExcluded.index() || lastExcluded.index() > elements) {
+            throw std::out_of_range("Iterator out of range");
+        }
+        eraseRange(firstIncluded.index(), lastExcluded.index());
+    }
+
+    inline void BitVector::insertAt(size_type position, bool value) {
+        append(false);
+        word_type* it = words.data();
+        size_type word = position / WORD_BITS;
+        for (size_type i = words.getSize() - 1; i > word; --i) {
+            it[i] = (it[i] << 1) | (it[i - 1] >> (WORD_BITS - 1));
+        }
+        word_type low = (word_type(1) << (position % WORD_BITS)) - 1;
+        it[word] = (it[word] & low) | ((it[word] & ~low) << 1);
+        clearUnusedBits();
+        set(position, value);
+    }
+
+    // Moves the bits following the range down, whole words at a time once the destination is aligned.
+    inline void BitVector::eraseRange(size_type first, size_type last) {
+        size_type destination = first;
+        word_type* it = words.data();
+        for (size_type source = last; source < elements;) {
+            size_type offset = destination % WORD_BITS;
+            size_type take = WORD_BITS - offset;
+            if (take > elements - source) {
+                take = elements - source;
+            }
+            word_type mask = take == WORD_BITS ? ~word_type(0) : (word_type(1) << take) - 1;
+            word_type& target = it[destination / WORD_BITS];
+            target = (target & ~(mask << offset)) | ((read64(source) & mask) << offset);
+            destination += take;
+            source += take;
+        }
+        elements -= last - first;
+        while (words.getSize() > wordsFor(elements)) {
+            words.popLast();
+        }
+        clearUnusedBits();
+        rank_valid = false;
+    }
+
+    inline BitVector::iterator BitVector::begin() {
+        return iterator(0, *this);
+    }
+
+    inline BitVector::iterator BitVector::end() {
+        return iterator(elements, *this);
+    }
+
+    inline BitVector::const_iterator BitVector::cbegin() const {
+        return const_iterator(0, *this);
+    }
+
+    inline BitVector::const_iterator BitVector::cend() const {
+        return const_iterator(elements, *this);
+    }
+
+    inline BitVector::const_iterator BitVector::begin() const {
+        return cbegin();
+    }
+
+    inline BitVector::const_iterator BitVector::end() const {
+        return cend();
+    }
+
+    inline BitVector operator&(BitVector left, const BitVector& right) {
+        return left &= right;
+    }
+
+    inline BitVector operator|(BitVector left, const BitVector& right) {
+        return left |= right;
+    }
+
+    inline BitVector operator^(BitVector left, const BitVector& right) {
+        return left ^= right;
+    }
+
+}
+
+#endif // AISDI_LINEAR_BITVECTOR_H
@@ -0,0 +1,311 @@
+#ifndef AISDI_LINEAR_COMPRESSEDINTVECTOR_H
+#define AISDI_LINEAR_COMPRESSEDINTVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <algorithm>
+
+#include "Vector.h"
+#include "IndexSequence.h"
+
+namespace aisdi {
+
+    namespace detail {
+
+        const std::size_t PACKED_BLOCK_SIZE = 128;
+
+        inline unsigned bitWidth(std::uint64_t value) {
+            if (value == 0) {
+                return 0;
+            }
+#if defined(__GNUC__)
+            return 64 - __builtin_clzll(value);
+#else
+            unsigned width = 0;
+            for (; value != 0; value >>= 1) {
+                ++width;
+            }
+            return width;
+#endif
+        }
+
+        // One instantiation per width, so shifts and masks are constants and the loop unrolls/vectorizes.
+        template <unsigned Width>
+        void unpackDeltas(const std::uint64_t* in, std::uint64_t* out) {
+            const std::uint64_t mask = ~std::uint64_t(0) >> (64 - Width);
+            for (unsigned i = 0; i < PACKED_BLOCK_SIZE; ++i) {
+                const unsigned bit = i * Width;
+                const unsigned shift = bit % 64;
+                std::uint64_t value = in[bit / 64] >> shift;
+                if (shift + Width > 64) {
+                    value |= in[bit / 64 + 1] << (64 - shift);
+                }
+                out[i] = value & mask;
+            }
+        }
+
+        template <>
+        inline void unpackDeltas<0>(const std::uint64_t*, std::uint64_t* out) {
+            std::fill(out, out + PACKED_BLOCK_SIZE, 0);
+        }
+
+        using DeltaUnpacker = void (*)(const std::uint64_t*, std::uint64_t*);
+
+        template <std::size_t... Widths>
+        const DeltaUnpacker* deltaUnpackers(IndexSequence<Widths...>) {
+            static const DeltaUnpacker table[] = { &unpackDeltas<Widths>... };
+            return table;
+        }
+
+        inline DeltaUnpacker deltaUnpacker(unsigned width) {
+            return deltaUnpackers(MakeIndexSequence<65>::type())[width];
+        }
+
+    }
+
+    // Non-decreasing sequence of 64-bit integers. Every 128 values form a block stored as
+    // its first value plus bit-packed deltas, the per-block first values double as a skip index.
+    class CompressedIntVector {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = std::uint64_t;
+
+        class ConstIterator;
+        using const_iterator = ConstIterator;
+        using iterator = ConstIterator;
+
+        static const size_type BLOCK_SIZE = detail::PACKED_BLOCK_SIZE;
+
+        CompressedIntVector() : tail_size(0), elements(0) {}
+
+        CompressedIntVector(std::initializer_list<value_type> l) : CompressedIntVector() {
+            for (value_type val : l) {
+                append(val);
+            }
+        }
+
+        bool isEmpty() const {
+            return getSize() == 0;
+        }
+
+        size_type getSize() const {
+            return elements;
+        }
+
+        // Bytes used by the encoded blocks and their index.
+        size_type getCompressedBytes() const {
+            return packed.getSize() * sizeof(std::uint64_t) + blocks.getSize() * sizeof(Block);
+        }
+
+        void append(value_type value) {
+            if (elements > 0 && value < last) {
+                throw std::invalid_argument("CompressedIntVector values must be non-decreasing");
+            }
+            tail[tail_size++] = value;
+            last = value;
+            ++elements;
+            if (tail_size == BLOCK_SIZE) {
+                encodeBlock();
+                tail_size = 0;
+            }
+        }
+
+        value_type get(size_type index) const {
+            if (index >= elements) {
+                throw std::out_of_range("Index out of range");
+            }
+            value_type values[BLOCK_SIZE];
+            decodeBlock(index / BLOCK_SIZE, values);
+            return values[index % BLOCK_SIZE];
+        }
+
+        // Index of the first value not less than value, getSize() if there is none.
+        size_type lowerBound(value_type value) const {
+            size_type low = 0;
+            size_type high = blockCount();
+            while (low < high) {
+                size_type middle = (low + high) / 2;
+                if (blockBase(middle) < value) {
+                    low = middle + 1;
+                }
+                else {
+                    high = middle;
+                }
+            }
+            if (low > 0) {
+                value_type values[BLOCK_SIZE];
+                size_type count = decodeBlock(low - 1, values);
+                size_type found = std::lower_bound(values, values + count, value) - values;
+                if (found < count) {
+                    return (low - 1) * BLOCK_SIZE + found;
+                }
+            }
+            return low < blockCount() ? low * BLOCK_SIZE : elements;
+        }
+
+        void decodeInto(Vector<value_type>& out) const {
+            out.reserve(out.getSize() + elements);
+            value_type values[BLOCK_SIZE];
+            for (size_type block = 0; block < blockCount(); ++block) {
+                size_type count = decodeBlock(block, values);
+                for (size_type i = 0; i < count; ++i) {
+                    out.append(values[i]);
+                }
+            }
+        }
+
+        const_iterator begin() const;
+
+        const_iterator end() const;
+
+        const_iterator cbegin() const;
+
+        const_iterator cend() const;
+
+    private:
+        struct Block {
+            value_type base;
+            size_type offset;
+            unsigned width;
+        };
+
+        size_type blockCount() const {
+            return blocks.getSize() + (tail_size > 0 ? 1 : 0);
+        }
+
+        value_type blockBase(size_type block) const {
+            return block < blocks.getSize() ? blocks.data()[block].base : tail[0];
+        }
+
+        void encodeBlock() {
+            value_type widest = 0;
+            for (size_type i = 1; i < BLOCK_SIZE; ++i) {
+                widest |= tail[i] - tail[i - 1];
+            }
+            Block block;
+            block.base = tail[0];
+            block.offset = packed.getSize();
+            block.width = detail::bitWidth(widest);
+            // 128 values of width bits take exactly 2 * width words
+            for (size_type i = 0; i < 2 * block.width; ++i) {
+                packed.append(0);
+            }
+            std::uint64_t* out = packed.data() + block.offset;
+            for (size_type i = 1; i < BLOCK_SIZE && block.width > 0; ++i) {
+                value_type delta = tail[i] - tail[i - 1];
+                size_type bit = i * block.width;
+                size_type shift = bit % 64;
+                out[bit / 64] |= delta << shift;
+                if (shift + block.width > 64) {
+                    out[bit / 64 + 1] |= delta >> (64 - shift);
+                }
+            }
+            blocks.append(block);
+        }
+
+        size_type decodeBlock(size_type index, value_type* out) const {
+            if (index == blocks.getSize()) {
+                std::copy(tail, tail + tail_size, out);
+                return tail_size;
+            }
+            const Block& block = blocks.data()[index];
+            detail::deltaUnpacker(block.width)(packed.data() + block.offset, out);
+            out[0] = block.base;
+            for (size_type i = 1; i < BLOCK_SIZE; ++i) {
+                out[i] += out[i - 1];
+            }
+            return BLOCK_SIZE;
+        }
+
+        Vector<Block> blocks;
+        Vector<std::uint64_t> packed;
+        value_type tail[BLOCK_SIZE];
+        size_type tail_size;
+        size_type elements;
+        value_type last;
+    };
+
+    // Decodes one block at a time into its own buffer.
+    class CompressedIntVector::ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = CompressedIntVector::value_type;
+        using difference_type = CompressedIntVector::difference_type;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        explicit ConstIterator(size_type idx, const CompressedIntVector& parent)
+                : current_index(idx), decoded_block(NO_BLOCK), parent(&parent) {
+            decode();
+        }
+
+        reference operator*() const {
+            if (current_index >= parent->getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            return values[current_index % BLOCK_SIZE];
+        }
+
+        ConstIterator& operator++() {
+            if (current_index >= parent->getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            ++current_index;
+            decode();
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator result = *this;
+            operator++();
+            return result;
+        }
+
+        bool operator==(const ConstIterator& other) const {
+            return current_index == other.current_index;
+        }
+
+        bool operator!=(const ConstIterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        static const size_type NO_BLOCK = static_cast<size_type>(-1);
+
+        void decode() {
+            size_type block = current_index / BLOCK_SIZE;
+            if (current_index < parent->getSize() && block != decoded_block) {
+                parent->decodeBlock(block, values);
+                decoded_block = block;
+            }
+        }
+
+        size_type current_index;
+        size_type decoded_block;
+        const CompressedIntVector* parent;
+        value_type values[BLOCK_SIZE];
+    };
+
+    inline CompressedIntVector::const_iterator CompressedIntVector::begin() const {
+        return cbegin();
+    }
+
+    inline CompressedIntVector::const_iterator CompressedIntVector::end() const {
+        return cend();
+    }
+
+    inline CompressedIntVector::const_iterator CompressedIntVector::cbegin() const {
+        return const_iterator(0, *this);
+    }
+
+    inline CompressedIntVector::const_iterator CompressedIntVector::cend() const {
+        return const_iterator(elements, *this);
+    }
+
+}
+
+#endif // AISDI_LINEAR_COMPRESSEDINTVECTOR_H
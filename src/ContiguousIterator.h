@@ -0,0 +1,167 @@
+#ifndef AISDI_LINEAR_CONTIGUOUSITERATOR_H
+#define AISDI_LINEAR_CONTIGUOUSITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+namespace aisdi {
+
+    // Checked iterators shared by containers keeping their elements in one contiguous buffer.
+    // Container has to provide data() const and getSize().
+    template <typename Container>
+    class ContiguousConstIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename Container::value_type;
+        using difference_type = typename Container::difference_type;
+        using pointer = typename Container::const_pointer;
+        using reference = typename Container::const_reference;
+
+        explicit ContiguousConstIterator(pointer ptr, const Container& parent) : current_pointer(ptr), parent(&parent) {}
+
+        reference operator*() const {
+            if (current_pointer < parent->data() || current_pointer >= parent->data() + parent->getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            return *current_pointer;
+        }
+
+        ContiguousConstIterator& operator++() {
+            if (current_pointer >= parent->data() + parent->getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            ++current_pointer;
+            return *this;
+        }
+
+        ContiguousConstIterator operator++(int) {
+            ContiguousConstIterator result = *this;
+            operator++();
+            return result;
+        }
+
+        ContiguousConstIterator& operator--() {
+            if (current_pointer <= parent->data()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            --current_pointer;
+            return *this;
+        }
+
+        ContiguousConstIterator operator--(int) {
+            ContiguousConstIterator result = *this;
+            operator--();
+            return result;
+        }
+
+        ContiguousConstIterator& operator+=(difference_type d) {
+            current_pointer += d;
+            return *this;
+        }
+
+        ContiguousConstIterator& operator-=(difference_type d) {
+            current_pointer -= d;
+            return *this;
+        }
+
+        ContiguousConstIterator operator+(difference_type d) const {
+            ContiguousConstIterator new_iter = *this;
+            new_iter += d;
+            return new_iter;
+        }
+
+        difference_type operator-(const ContiguousConstIterator& other) const {
+            return current_pointer - other.current_pointer;
+        }
+
+        ContiguousConstIterator operator-(difference_type d) const {
+            ContiguousConstIterator new_iter = *this;
+            new_iter -= d;
+            return new_iter;
+        }
+
+        bool operator==(const ContiguousConstIterator& other) const {
+            return current_pointer == other.current_pointer;
+        }
+
+        bool operator!=(const ContiguousConstIterator& other) const {
+            return !(*this == other);
+        }
+
+        bool operator<(const ContiguousConstIterator& other) const {
+            return current_pointer < other.current_pointer;
+        }
+
+        bool operator>(const ContiguousConstIterator& other) const {
+            return other < *this;
+        }
+
+        bool operator<=(const ContiguousConstIterator& other) const {
+            return !(other < *this);
+        }
+
+        bool operator>=(const ContiguousConstIterator& other) const {
+            return !(*this < other);
+        }
+
+    protected:
+        pointer current_pointer;
+        const Container* parent;
+    };
+
+    template <typename Container>
+    class ContiguousIterator : public ContiguousConstIterator<Container> {
+        using Base = ContiguousConstIterator<Container>;
+
+    public:
+        using difference_type = typename Container::difference_type;
+        using pointer = typename Container::pointer;
+        using reference = typename Container::reference;
+
+        explicit ContiguousIterator(pointer ptr, Container& parent) : Base(ptr, parent) {}
+
+        ContiguousIterator(const Base& other)
+                : Base(other) {}
+
+        ContiguousIterator& operator++() {
+            Base::operator++();
+            return *this;
+        }
+
+        ContiguousIterator operator++(int) {
+            auto result = *this;
+            Base::operator++();
+            return result;
+        }
+
+        ContiguousIterator& operator--() {
+            Base::operator--();
+            return *this;
+        }
+
+        ContiguousIterator operator--(int) {
+            auto result = *this;
+            Base::operator--();
+            return result;
+        }
+
+        ContiguousIterator operator+(difference_type d) const {
+            return Base::operator+(d);
+        }
+
+        using Base::operator-;
+
+        ContiguousIterator operator-(difference_type d) const {
+            return Base::operator-(d);
+        }
+
+        reference operator*() const {
+            // ugly cast, yet reduces code duplication.
+            return const_cast<reference>(Base::operator*());
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_CONTIGUOUSITERATOR_H
@@ -0,0 +1,203 @@
+#ifndef AISDI_LINEAR_COPYONWRITE_H
+#define AISDI_LINEAR_COPYONWRITE_H
+
+#include <cstddef>
+#include <atomic>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+namespace aisdi {
+
+    // Value shared by all copies until one of them asks for write access. The reference count is atomic,
+    // so copies may be handed to other threads, a single CopyOnWrite object still needs external locking.
+    template <typename Value>
+    class CopyOnWrite {
+    public:
+        CopyOnWrite() : shared(new Holder()) {}
+
+        explicit CopyOnWrite(Value value) : shared(new Holder(std::move(value))) {}
+
+        CopyOnWrite(const CopyOnWrite& other) : shared(other.shared) {
+            shared->references.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Steals the value, so the new owner can write without copying; other is left holding an empty value.
+        CopyOnWrite(CopyOnWrite&& other) : shared(new Holder()) {
+            std::swap(shared, other.shared);
+        }
+
+        CopyOnWrite& operator=(const CopyOnWrite& other) {
+            other.shared->references.fetch_add(1, std::memory_order_relaxed);
+            release();
+            shared = other.shared;
+            return *this;
+        }
+
+        CopyOnWrite& operator=(CopyOnWrite&& other) {
+            if (this != &other) {
+                Holder* empty = new Holder();
+                release();
+                shared = other.shared;
+                other.shared = empty;
+            }
+            return *this;
+        }
+
+        ~CopyOnWrite() {
+            release();
+        }
+
+        const Value& read() const {
+            return shared->value;
+        }
+
+        // Copies the value first if anyone else can see it.
+        Value& write() {
+            if (isShared()) {
+                Holder* copy = new Holder(shared->value);
+                release();
+                shared = copy;
+            }
+            return shared->value;
+        }
+
+        bool isShared() const {
+            return shared->references.load(std::memory_order_acquire) != 1;
+        }
+
+        std::size_t useCount() const {
+            return shared->references.load(std::memory_order_acquire);
+        }
+
+    private:
+        struct Holder {
+            Holder() : references(1), value() {}
+
+            explicit Holder(const Value& value) : references(1), value(value) {}
+
+            explicit Holder(Value&& value) : references(1), value(std::move(value)) {}
+
+            std::atomic<std::size_t> references;
+            Value value;
+        };
+
+        void release() {
+            // the last owner has to see every write made by the others before deleting
+            if (shared->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete shared;
+            }
+        }
+
+        Holder* shared;
+    };
+
+    // Common interface of the copy-on-write collections, forwarded to an Items collection shared by all copies
+    // until the first modification. Every non-const access (non-const begin and end included) detaches first.
+    template <typename Items>
+    class CowSequence {
+    public:
+        using difference_type = typename Items::difference_type;
+        using size_type = typename Items::size_type;
+        using value_type = typename Items::value_type;
+        using pointer = typename Items::pointer;
+        using reference = typename Items::reference;
+        using const_pointer = typename Items::const_pointer;
+        using const_reference = typename Items::const_reference;
+
+        using iterator = typename Items::iterator;
+        using const_iterator = typename Items::const_iterator;
+
+        bool isEmpty() const {
+            return items.read().isEmpty();
+        }
+
+        size_type getSize() const {
+            return items.read().getSize();
+        }
+
+        // True while the contents are shared with another copy.
+        bool isShared() const {
+            return items.isShared();
+        }
+
+        void append(const value_type& item) {
+            items.write().append(item);
+        }
+
+        void prepend(const value_type& item) {
+            items.write().prepend(item);
+        }
+
+        void insert(const const_iterator& insertPosition, const value_type& item) {
+            const_iterator position = detachAt(insertPosition);
+            items.write().insert(position, item);
+        }
+
+        value_type popFirst() {
+            return items.write().popFirst();
+        }
+
+        value_type popLast() {
+            return items.write().popLast();
+        }
+
+        void erase(const const_iterator& position) {
+            const_iterator detached = detachAt(position);
+            items.write().erase(detached);
+        }
+
+        void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded) {
+            difference_type length = std::distance(firstIncluded, lastExcluded);
+            const_iterator first = detachAt(firstIncluded);
+            items.write().erase(first, std::next(first, length));
+        }
+
+        iterator begin() {
+            return items.write().begin();
+        }
+
+        iterator end() {
+            return items.write().end();
+        }
+
+        const_iterator cbegin() const {
+            return items.read().cbegin();
+        }
+
+        const_iterator cend() const {
+            return items.read().cend();
+        }
+
+        const_iterator begin() const {
+            return cbegin();
+        }
+
+        const_iterator end() const {
+            return cend();
+        }
+
+    protected:
+        CowSequence() {}
+
+        CowSequence(std::initializer_list<value_type> l) : items(Items(l)) {}
+
+        explicit CowSequence(Items contents) : items(std::move(contents)) {}
+
+        // Detaches shared contents and finds the position again in the copy by its distance from the front,
+        // contents that are not shared are left alone and the position stays valid.
+        const_iterator detachAt(const const_iterator& position) {
+            if (!items.isShared()) {
+                return position;
+            }
+            difference_type index = std::distance(items.read().cbegin(), position);
+            const Items& target = items.write();
+            return std::next(target.cbegin(), index);
+        }
+
+        CopyOnWrite<Items> items;
+    };
+
+}
+
+#endif // AISDI_LINEAR_COPYONWRITE_H
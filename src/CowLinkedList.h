@@ -0,0 +1,40 @@
+#ifndef AISDI_LINEAR_COWLINKEDLIST_H
+#define AISDI_LINEAR_COWLINKEDLIST_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+#include "LinkedList.h"
+#include "CopyOnWrite.h"
+
+namespace aisdi {
+
+    // LinkedList whose copies share one node chain until the first modification, copying is O(1) and
+    // thread safe. Every non-const access (non-const begin and end included) detaches a shared chain first.
+    // The first modification of a shared chain copies all of it: every node is reachable through prev links
+    // from the tail as well as through next links from the head, so no part of a doubly linked chain can be
+    // shared by two lists that differ anywhere. PersistentList shares the unchanged tail instead, at the
+    // price of forward-only iteration.
+    template <typename Type>
+    class CowLinkedList : public CowSequence<LinkedList<Type>> {
+        using Base = CowSequence<LinkedList<Type>>;
+
+    public:
+        using Items = LinkedList<Type>;
+
+        CowLinkedList() {}
+
+        CowLinkedList(std::initializer_list<Type> l) : Base(l) {}
+
+        explicit CowLinkedList(Items list) : Base(std::move(list)) {}
+
+        // Read-only view of the current contents.
+        const Items& getList() const {
+            return this->items.read();
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_COWLINKEDLIST_H
@@ -0,0 +1,61 @@
+#ifndef AISDI_LINEAR_COWVECTOR_H
+#define AISDI_LINEAR_COWVECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+#include "Vector.h"
+#include "CopyOnWrite.h"
+
+namespace aisdi {
+
+    // Vector whose copies share one buffer until the first modification, copying is O(1) and thread safe.
+    // Every non-const access (non-const begin, end and data included) detaches a shared buffer first.
+    template <typename Type>
+    class CowVector : public CowSequence<Vector<Type>> {
+        using Base = CowSequence<Vector<Type>>;
+
+    public:
+        using Items = Vector<Type>;
+        using typename Base::size_type;
+        using typename Base::pointer;
+        using typename Base::const_pointer;
+
+        CowVector() {}
+
+        CowVector(std::initializer_list<Type> l) : Base(l) {}
+
+        explicit CowVector(Items vector) : Base(std::move(vector)) {}
+
+        // Read-only view of the current contents.
+        const Items& getVector() const {
+            return this->items.read();
+        }
+
+        void reserve(size_type capacity) {
+            this->items.write().reserve(capacity);
+        }
+
+        pointer data() {
+            return this->items.write().data();
+        }
+
+        const_pointer data() const {
+            return this->items.read().data();
+        }
+    };
+
+    template <typename Type>
+    bool operator==(const CowVector<Type>& lhs, const CowVector<Type>& rhs) {
+        return lhs.data() == rhs.data() || lhs.getVector() == rhs.getVector();
+    }
+
+    template <typename Type>
+    bool operator!=(const CowVector<Type>& lhs, const CowVector<Type>& rhs) {
+        return !(lhs == rhs);
+    }
+
+}
+
+#endif // AISDI_LINEAR_COWVECTOR_H
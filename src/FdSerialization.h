@@ -0,0 +1,136 @@
+#ifndef AISDI_LINEAR_FDSERIALIZATION_H
+#define AISDI_LINEAR_FDSERIALIZATION_H
+
+#include <cstring>
+#include <cerrno>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <algorithm>
+
+#include <unistd.h>
+
+#include "Serialization.h"
+
+namespace aisdi {
+
+    namespace detail {
+
+        // Minimal buffered streambuf over a POSIX file descriptor, used by the fd-based save/load.
+        class FdStreamBuf : public std::streambuf {
+        public:
+            explicit FdStreamBuf(int fd) : fd(fd) {
+                setg(buffer, buffer, buffer);
+                setp(buffer, buffer + sizeof(buffer));
+            }
+
+            ~FdStreamBuf() {
+                drain();
+                // hand back input read ahead but not consumed, so the next reader of fd starts right after our data
+                if (gptr() != egptr()) {
+                    lseek(fd, -(egptr() - gptr()), SEEK_CUR);
+                }
+            }
+
+        protected:
+            int_type overflow(int_type ch) override {
+                if (!drain()) {
+                    return traits_type::eof();
+                }
+                if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+                    *pptr() = traits_type::to_char_type(ch);
+                    pbump(1);
+                }
+                return traits_type::not_eof(ch);
+            }
+
+            int sync() override {
+                return drain() ? 0 : -1;
+            }
+
+            std::streamsize xsputn(const char* bytes, std::streamsize count) override {
+                if (count < epptr() - pptr()) {
+                    return std::streambuf::xsputn(bytes, count);
+                }
+                if (!drain() || !writeAll(bytes, count)) {
+                    return 0;
+                }
+                return count;
+            }
+
+            int_type underflow() override {
+                ssize_t got = retry([this]() { return ::read(fd, buffer, sizeof(buffer)); });
+                if (got <= 0) {
+                    return traits_type::eof();
+                }
+                setg(buffer, buffer, buffer + got);
+                return traits_type::to_int_type(*gptr());
+            }
+
+            std::streamsize xsgetn(char* bytes, std::streamsize count) override {
+                std::streamsize done = std::min<std::streamsize>(count, egptr() - gptr());
+                std::memcpy(bytes, gptr(), done);
+                gbump(done);
+                while (done < count) {
+                    ssize_t got = retry([&]() { return ::read(fd, bytes + done, count - done); });
+                    if (got <= 0) {
+                        break;
+                    }
+                    done += got;
+                }
+                return done;
+            }
+
+        private:
+            template <typename Call>
+            static ssize_t retry(Call call) {
+                ssize_t result;
+                do {
+                    result = call();
+                } while (result < 0 && errno == EINTR);
+                return result;
+            }
+
+            bool writeAll(const char* bytes, std::size_t count) {
+                while (count > 0) {
+                    ssize_t written = retry([&]() { return ::write(fd, bytes, count); });
+                    if (written <= 0) {
+                        return false;
+                    }
+                    bytes += written;
+                    count -= written;
+                }
+                return true;
+            }
+
+            bool drain() {
+                bool ok = writeAll(pbase(), pptr() - pbase());
+                setp(buffer, buffer + sizeof(buffer));
+                return ok;
+            }
+
+            int fd;
+            char buffer[FRAME_SIZE];
+        };
+
+    }
+
+    // Writes collection in the format described in Serialization.h at the current offset of fd.
+    template <typename Collection>
+    void save(const Collection& collection, int fd) {
+        detail::FdStreamBuf buffer(fd);
+        std::ostream out(&buffer);
+        collection.save(out);
+    }
+
+    // Reads a collection written by save(); fd is left right after its data.
+    template <typename Collection>
+    void load(Collection& collection, int fd) {
+        detail::FdStreamBuf buffer(fd);
+        std::istream in(&buffer);
+        collection.load(in);
+    }
+
+}
+
+#endif // AISDI_LINEAR_FDSERIALIZATION_H
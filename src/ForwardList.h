@@ -0,0 +1,360 @@
+#ifndef AISDI_LINEAR_FORWARDLIST_H
+#define AISDI_LINEAR_FORWARDLIST_H
+
+#include <cstddef>
+#include <iterator>
+#include <initializer_list>
+#include <stdexcept>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "Allocators.h"
+
+namespace aisdi {
+
+    // Singly linked list with one allocation per element holding the value and a single link. Appending is
+    // O(1) thanks to a tail pointer, modifications in the middle go through insertAfter and eraseAfter.
+    template <typename Type, typename Alloc = std::allocator<Type>>
+    class ForwardList {
+        struct Link {
+            Link* next;
+        };
+
+        struct Node : Link {
+            template <typename Value>
+            explicit Node(Value&& item) : value(std::forward<Value>(item)) {
+                this->next = nullptr;
+            }
+
+            Type value;
+        };
+
+    public:
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = Type;
+        using allocator_type = Alloc;
+        using pointer = Type*;
+        using reference = Type&;
+        using const_pointer = const Type*;
+        using const_reference = const Type&;
+
+        class ConstIterator;
+        class Iterator;
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+        ForwardList() : ForwardList(Alloc()) {}
+
+        explicit ForwardList(const Alloc& alloc) : allocator(alloc), last(&front), size(0) {
+            front.next = nullptr;
+        }
+
+        ForwardList(std::initializer_list<Type> l, const Alloc& alloc = Alloc()) : ForwardList(alloc) {
+            for (const auto& val : l) {
+                append(val);
+            }
+        }
+
+        ForwardList(const ForwardList& other)
+                : ForwardList(NodeTraits::select_on_container_copy_construction(other.allocator)) {
+            appendAll(other);
+        }
+
+        ForwardList(ForwardList&& other) : allocator(std::move(other.allocator)) {
+            steal(other);
+        }
+
+        ~ForwardList() {
+            clear();
+        }
+
+        ForwardList& operator=(const ForwardList& other) {
+            if (this == &other) {
+                return *this;
+            }
+            clear();
+            if (NodeTraits::propagate_on_container_copy_assignment::value) {
+                allocator = other.allocator;
+            }
+            appendAll(other);
+            return *this;
+        }
+
+        ForwardList& operator=(ForwardList&& other) {
+            if (this == &other) {
+                return *this;
+            }
+            clear();
+            if (NodeTraits::propagate_on_container_move_assignment::value) {
+                allocator = std::move(other.allocator);
+            }
+            else if (allocator != other.allocator) {
+                // nodes cannot change owners, so the values are moved into nodes of our allocator
+                for (Link* it = other.front.next; it != nullptr; it = it->next) {
+                    append(std::move(static_cast<Node*>(it)->value));
+                }
+                other.clear();
+                return *this;
+            }
+            steal(other);
+            return *this;
+        }
+
+        allocator_type get_allocator() const {
+            return allocator_type(allocator);
+        }
+
+        bool isEmpty() const {
+            return getSize() == 0;
+        }
+
+        size_type getSize() const {
+            return size;
+        }
+
+        void append(const Type& item) {
+            linkAfter(last, createNode(item));
+        }
+
+        void append(Type&& item) {
+            linkAfter(last, createNode(std::move(item)));
+        }
+
+        void prepend(const Type& item) {
+            linkAfter(&front, createNode(item));
+        }
+
+        // Returns an iterator to the new element, position may be beforeBegin().
+        iterator insertAfter(const const_iterator& position, const Type& item) {
+            Link* link = position.link();
+            if (link == nullptr) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            Node* node = createNode(item);
+            linkAfter(link, node);
+            return iterator(node, *this);
+        }
+
+        Type popFirst() {
+            if (isEmpty()) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            Type ret_val = std::move(static_cast<Node*>(front.next)->value);
+            unlinkAfter(&front);
+            return ret_val;
+        }
+
+        // Removes the element following position and returns an iterator to the one after it.
+        iterator eraseAfter(const const_iterator& position) {
+            Link* link = position.link();
+            if (link == nullptr || link->next == nullptr) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            unlinkAfter(link);
+            return iterator(link->next, *this);
+        }
+
+        void clear() {
+            if (!DROPS_NODES) {
+                Link* next = front.next;
+                while (next != nullptr) {
+                    Node* to_delete = static_cast<Node*>(next);
+                    next = next->next;
+                    destroyNode(to_delete);
+                }
+            }
+            front.next = nullptr;
+            last = &front;
+            size = 0;
+        }
+
+        iterator beforeBegin() {
+            return iterator(&front, *this);
+        }
+
+        const_iterator cbeforeBegin() const {
+            return const_iterator(const_cast<Link*>(&front), *this);
+        }
+
+        iterator begin() {
+            return iterator(front.next, *this);
+        }
+
+        iterator end() {
+            return iterator(nullptr, *this);
+        }
+
+        const_iterator cbegin() const {
+            return const_iterator(front.next, *this);
+        }
+
+        const_iterator cend() const {
+            return const_iterator(nullptr, *this);
+        }
+
+        const_iterator begin() const {
+            return cbegin();
+        }
+
+        const_iterator end() const {
+            return cend();
+        }
+
+    private:
+        using NodeAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+        using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+        static_assert(std::is_same<typename NodeTraits::pointer, Node*>::value, "Allocator must use raw pointers");
+
+        // Arena-like allocators reclaim nodes of trivially destructible values without walking the chain.
+        static const bool DROPS_NODES = std::is_trivially_destructible<Type>::value
+                                        && AllocatorReleasesInBulk<NodeAllocator>::value;
+
+        template <typename Value>
+        Node* createNode(Value&& item) {
+            Node* node = NodeTraits::allocate(allocator, 1);
+            try {
+                NodeTraits::construct(allocator, node, std::forward<Value>(item));
+            }
+            catch (...) {
+                NodeTraits::deallocate(allocator, node, 1);
+                throw;
+            }
+            return node;
+        }
+
+        void destroyNode(Node* node) {
+            NodeTraits::destroy(allocator, node);
+            NodeTraits::deallocate(allocator, node, 1);
+        }
+
+        void linkAfter(Link* position, Node* node) {
+            node->next = position->next;
+            position->next = node;
+            if (position == last) {
+                last = node;
+            }
+            ++size;
+        }
+
+        void unlinkAfter(Link* position) {
+            Node* removed = static_cast<Node*>(position->next);
+            position->next = removed->next;
+            if (removed == last) {
+                last = position;
+            }
+            destroyNode(removed);
+            --size;
+        }
+
+        void appendAll(const ForwardList& other) {
+            for (const Link* it = other.front.next; it != nullptr; it = it->next) {
+                append(static_cast<const Node*>(it)->value);
+            }
+        }
+
+        // The sentinel lives inside the object, so a tail pointing at it has to be redirected.
+        void steal(ForwardList& other) {
+            front.next = other.front.next;
+            last = other.last == &other.front ? &front : other.last;
+            size = other.size;
+            other.front.next = nullptr;
+            other.last = &other.front;
+            other.size = 0;
+        }
+
+        NodeAllocator allocator;
+        Link front;
+        Link* last;
+        size_type size;
+    };
+
+    template <typename Type, typename Alloc>
+    class ForwardList<Type, Alloc>::ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename ForwardList::value_type;
+        using difference_type = typename ForwardList::difference_type;
+        using pointer = typename ForwardList::const_pointer;
+        using reference = typename ForwardList::const_reference;
+
+        explicit ConstIterator(Link* link, const ForwardList& parent) : current_link(link), parent(&parent) {}
+
+        reference operator*() const {
+            if (current_link == nullptr || current_link == &parent->front) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            return static_cast<Node*>(current_link)->value;
+        }
+
+        pointer operator->() const {
+            return &operator*();
+        }
+
+        ConstIterator& operator++() {
+            if (current_link == nullptr) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            current_link = current_link->next;
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator result = *this;
+            operator++();
+            return result;
+        }
+
+        bool operator==(const ConstIterator& other) const {
+            return current_link == other.current_link;
+        }
+
+        bool operator!=(const ConstIterator& other) const {
+            return !(*this == other);
+        }
+
+        Link* link() const {
+            return current_link;
+        }
+
+    private:
+        Link* current_link;
+        const ForwardList* parent;
+    };
+
+    template <typename Type, typename Alloc>
+    class ForwardList<Type, Alloc>::Iterator : public ForwardList<Type, Alloc>::ConstIterator {
+    public:
+        using pointer = typename ForwardList::pointer;
+        using reference = typename ForwardList::reference;
+
+        explicit Iterator(Link* link, ForwardList& parent) : ConstIterator(link, parent) {}
+
+        Iterator(const ConstIterator& other) : ConstIterator(other) {}
+
+        Iterator& operator++() {
+            ConstIterator::operator++();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator result = *this;
+            ConstIterator::operator++();
+            return result;
+        }
+
+        reference operator*() const {
+            // ugly cast, yet reduces code duplication.
+            return const_cast<reference>(ConstIterator::operator*());
+        }
+
+        pointer operator->() const {
+            return &operator*();
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_FORWARDLIST_H
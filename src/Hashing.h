@@ -0,0 +1,151 @@
+#ifndef AISDI_LINEAR_HASHING_H
+#define AISDI_LINEAR_HASHING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+#include "SimdKernels.h"
+
+namespace aisdi {
+
+    namespace detail {
+
+        // Multiply-and-fold mixing in the style of wyhash.
+        const std::uint64_t HASH_P0 = 0xa0761d6478bd642fULL;
+        const std::uint64_t HASH_P1 = 0xe7037ed1a0b428dbULL;
+        const std::uint64_t HASH_P2 = 0x8ebc6af09c88c6e3ULL;
+        const std::uint64_t HASH_P3 = 0x589965cc75374cc3ULL;
+
+        inline std::uint64_t hashMix(std::uint64_t a, std::uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+            __extension__ typedef unsigned __int128 Wide;
+            Wide product = static_cast<Wide>(a) * b;
+            return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+            std::uint64_t aHigh = a >> 32, aLow = static_cast<std::uint32_t>(a);
+            std::uint64_t bHigh = b >> 32, bLow = static_cast<std::uint32_t>(b);
+            std::uint64_t lowLow = aLow * bLow, lowHigh = aLow * bHigh, highLow = aHigh * bLow, highHigh = aHigh * bHigh;
+            std::uint64_t middle = (lowLow >> 32) + static_cast<std::uint32_t>(lowHigh) + static_cast<std::uint32_t>(highLow);
+            std::uint64_t low = (middle << 32) | static_cast<std::uint32_t>(lowLow);
+            std::uint64_t high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+            return low ^ high;
+#endif
+        }
+
+        inline std::uint64_t readWord(const unsigned char* bytes) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes, sizeof(word));
+            return word;
+        }
+
+        inline std::uint64_t readHalfWord(const unsigned char* bytes) {
+            std::uint32_t word;
+            std::memcpy(&word, bytes, sizeof(word));
+            return word;
+        }
+
+        // Hash of a byte buffer, consuming 48 bytes per step in three independent lanes.
+        inline std::uint64_t hashBytes(const void* data, std::size_t length, std::uint64_t seed) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            std::uint64_t first;
+            std::uint64_t second;
+            seed ^= hashMix(seed ^ HASH_P0, HASH_P1);
+            if (length <= 16) {
+                if (length >= 4) {
+                    std::size_t shift = (length >> 3) << 2;
+                    first = (readHalfWord(bytes) << 32) | readHalfWord(bytes + shift);
+                    second = (readHalfWord(bytes + length - 4) << 32) | readHalfWord(bytes + length - 4 - shift);
+                }
+                else if (length > 0) {
+                    first = (std::uint64_t(bytes[0]) << 16) | (std::uint64_t(bytes[length >> 1]) << 8) | bytes[length - 1];
+                    second = 0;
+                }
+                else {
+                    first = second = 0;
+                }
+            }
+            else {
+                std::size_t left = length;
+                if (left > 48) {
+                    std::uint64_t lane1 = seed;
+                    std::uint64_t lane2 = seed;
+                    do {
+                        seed = hashMix(readWord(bytes) ^ HASH_P1, readWord(bytes + 8) ^ seed);
+                        lane1 = hashMix(readWord(bytes + 16) ^ HASH_P2, readWord(bytes + 24) ^ lane1);
+                        lane2 = hashMix(readWord(bytes + 32) ^ HASH_P3, readWord(bytes + 40) ^ lane2);
+                        bytes += 48;
+                        left -= 48;
+                    } while (left > 48);
+                    seed ^= lane1 ^ lane2;
+                }
+                while (left > 16) {
+                    seed = hashMix(readWord(bytes) ^ HASH_P1, readWord(bytes + 8) ^ seed);
+                    bytes += 16;
+                    left -= 16;
+                }
+                first = readWord(bytes + left - 16);
+                second = readWord(bytes + left - 8);
+            }
+            return hashMix(HASH_P1 ^ length, hashMix(first ^ HASH_P1, second ^ seed));
+        }
+
+        // Incremental hash over a sequence of 64 bit element hashes.
+        class Hasher {
+        public:
+            explicit Hasher(std::uint64_t seed) : state(seed ^ hashMix(seed ^ HASH_P0, HASH_P1)), count(0) {}
+
+            void add(std::uint64_t word) {
+                state = hashMix(word ^ HASH_P1, state ^ HASH_P2);
+                ++count;
+            }
+
+            std::uint64_t finish() const {
+                return hashMix(state ^ HASH_P0, count ^ HASH_P1);
+            }
+
+        private:
+            std::uint64_t state;
+            std::uint64_t count;
+        };
+
+        template <typename Type>
+        std::uint64_t hashElement(const Type& value, std::true_type) {
+            std::uint64_t word = 0;
+            std::memcpy(&word, &value, sizeof(Type));
+            return word;
+        }
+
+        template <typename Type>
+        std::uint64_t hashElement(const Type& value, std::false_type) {
+            return std::hash<Type>()(value);
+        }
+
+        // Elements whose bytes define equality are hashed by value, others through std::hash.
+        template <typename Type>
+        std::uint64_t hashElement(const Type& value) {
+            return hashElement(value, std::integral_constant<bool, simd::IsBitwiseComparable<Type>::value
+                    && sizeof(Type) <= sizeof(std::uint64_t)>());
+        }
+
+        template <typename Type>
+        std::uint64_t hashElements(const Type* data, std::size_t size, std::uint64_t seed, std::true_type) {
+            return hashBytes(data, size * sizeof(Type), seed);
+        }
+
+        template <typename Type>
+        std::uint64_t hashElements(const Type* data, std::size_t size, std::uint64_t seed, std::false_type) {
+            Hasher hasher(seed);
+            for (std::size_t i = 0; i < size; ++i) {
+                hasher.add(hashElement(data[i]));
+            }
+            return hasher.finish();
+        }
+
+    }
+
+}
+
+#endif // AISDI_LINEAR_HASHING_H
@@ -0,0 +1,30 @@
+#ifndef AISDI_LINEAR_INDEXSEQUENCE_H
+#define AISDI_LINEAR_INDEXSEQUENCE_H
+
+#include <cstddef>
+#include <initializer_list>
+
+namespace aisdi {
+
+    namespace detail {
+
+        // C++11 stand-in for std::index_sequence.
+        template <std::size_t... Indices>
+        struct IndexSequence {};
+
+        template <std::size_t Count, std::size_t... Indices>
+        struct MakeIndexSequence : MakeIndexSequence<Count - 1, Count - 1, Indices...> {};
+
+        template <std::size_t... Indices>
+        struct MakeIndexSequence<0, Indices...> {
+            using type = IndexSequence<Indices...>;
+        };
+
+        // Evaluates its arguments (a pack expansion) purely for their side effects.
+        inline void expand(std::initializer_list<int>) {}
+
+    }
+
+}
+
+#endif // AISDI_LINEAR_INDEXSEQUENCE_H
@@ -2,20 +2,32 @@
 #define AISDI_LINEAR_LINKEDLIST_H
 
 #include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <stdexcept>
+#include <istream>
+#include <ostream>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
+#include "Serialization.h"
+#include "Hashing.h"
+#include "Allocators.h"
 
 namespace aisdi
 {
 
-    template <typename Type>
+    // Nodes (with the value stored inline) are allocated through Alloc rebound to the node type.
+    template <typename Type, typename Alloc = std::allocator<Type>>
     class LinkedList
     {
     public:
         using difference_type = std::ptrdiff_t;
         using size_type = std::size_t;
         using value_type = Type;
+        using allocator_type = Alloc;
         using pointer = Type*;
         using reference = Type&;
         using const_pointer = const Type*;
@@ -26,61 +38,69 @@ namespace aisdi
         using iterator = Iterator;
         using const_iterator = ConstIterator;
 
+        // value points into the storage of a node, or is null for the guardian at the end
         using element = struct Element {
             pointer value;
             struct Element* next;
             struct Element* prev;
 
-            Element(pointer val) : value(val) {}
-            ~Element() {
-                delete value;
-            }
+            Element() : value(nullptr), next(nullptr), prev(nullptr) {}
         };
         using element_pointer = element*;
 
-        LinkedList() : size(0) {
-            element_pointer guardian = new Element(nullptr);
-            root = tail = guardian;
-            guardian->next = nullptr;
-            guardian->prev = nullptr;
-        }
+        LinkedList() : LinkedList(Alloc()) {}
 
-        LinkedList(std::initializer_list<Type> l) : LinkedList() {
+        explicit LinkedList(const Alloc& alloc) : allocator(alloc), root(&guardian), tail(&guardian), size(0) {}
+
+        LinkedList(std::initializer_list<Type> l, const Alloc& alloc = Alloc()) : LinkedList(alloc) {
             for (const auto& val : l) {
                 insert(end(), val);
             }
         }
 
-        LinkedList(const LinkedList& other) : LinkedList() {
+        LinkedList(const LinkedList& other)
+                : LinkedList(NodeTraits::select_on_container_copy_construction(other.allocator)) {
             for (auto it = other.begin(); it != other.end(); ++it) {
                 insert(end(), *it);
             }
         }
 
-        LinkedList(LinkedList&& other) {
-            root = other.root;
-            tail = other.tail;
-            size = other.size;
-            other.root = nullptr;
-            other.tail = nullptr;
+        // Only relinks the nodes to this list's guardian, the moved-from list is left empty.
+        LinkedList(LinkedList&& other) noexcept
+                : allocator(other.allocator), root(&guardian), tail(&guardian), size(0) {
+            steal(other);
         }
 
         ~LinkedList() {
-            element_pointer next = root;
-            while (next != nullptr) {
-                element_pointer to_delete = next;
-                next = to_delete->next;
-                delete to_delete;
-            }
+            releaseChain(root);
         }
 
         LinkedList& operator=(const LinkedList& other) {
             if (this == &other) {
                 return *this;
             }
-            erase(cbegin(), cend());
-            for (auto it = other.begin(); it != other.end(); ++it) {
-                insert(end(), *it);
+            if (NodeTraits::propagate_on_container_copy_assignment::value && allocator != other.allocator) {
+                // nodes of the old allocator have to go back to it before it is replaced
+                releaseChain(root);
+                unlinkAll();
+                allocator = other.allocator;
+            }
+            else if (NodeTraits::propagate_on_container_copy_assignment::value) {
+                allocator = other.allocator;
+            }
+            // values are assigned over the existing nodes, only the difference in length is allocated or freed
+            element_pointer target = root;
+            element_pointer source = other.root;
+            while (target != tail && source != other.tail) {
+                *target->value = *source->value;
+                target = target->next;
+                source = source->next;
+            }
+            if (target != tail) {
+                erase(const_iterator(target, *this), cend());
+            }
+            for (; source != other.tail; source = source->next) {
+                insert(end(), *source->value);
             }
             return *this;
         }
@@ -89,20 +109,27 @@ namespace aisdi
             if (this == &other) {
                 return *this;
             }
-            element_pointer next = root;
-            while (next != nullptr) {
-                element_pointer to_delete = next;
-                next = to_delete->next;
-                delete to_delete;
+            if (!NodeTraits::propagate_on_container_move_assignment::value && allocator != other.allocator) {
+                // nodes cannot change owners, so the values are moved into nodes of our allocator
+                erase(cbegin(), cend());
+                for (auto it = other.begin(); it != other.end(); ++it) {
+                    insert(end(), std::move(*it));
+                }
+                return *this;
+            }
+            releaseChain(root);
+            unlinkAll();
+            if (NodeTraits::propagate_on_container_move_assignment::value) {
+                allocator = other.allocator;
             }
-            root = other.root;
-            tail = other.tail;
-            size = other.size;
-            other.root = nullptr;
-            other.tail = nullptr;
+            steal(other);
             return *this;
         }
 
+        allocator_type get_allocator() const {
+            return allocator_type(allocator);
+        }
+
         bool isEmpty() const {
             return getSize() == 0;
         }
@@ -115,23 +142,24 @@ namespace aisdi
             insert(end(), item);
         }
 
+        void append(Type&& item) {
+            insert(end(), std::move(item));
+        }
+
         void prepend(const Type& item) {
             insert(begin(), item);
         }
 
+        void prepend(Type&& item) {
+            insert(begin(), std::move(item));
+        }
+
         void insert(const const_iterator& insertPosition, const Type& item) {
-            element_pointer new_element = new Element(new value_type(item));
-            new_element->next = insertPosition.element();
-            new_element->prev = insertPosition.element()->prev;
-            new_element->next->prev = new_element;
+            link(insertPosition, createElement(item));
+        }
 
-            if (new_element->prev != nullptr) {
-                new_element->prev->next = new_element;
-            }
-            else {
-                root = new_element;
-            }
-            ++size;
+        void insert(const const_iterator& insertPosition, Type&& item) {
+            link(insertPosition, createElement(std::move(item)));
         }
 
         Type popFirst() {
@@ -164,7 +192,7 @@ namespace aisdi
             else {
                 root = del_el->next;
             }
-            delete del_el;
+            destroyElement(del_el);
             --size;
         }
 
@@ -182,11 +210,101 @@ namespace aisdi
             while (next != lst_el) {
                 element_pointer to_delete = next;
                 next = to_delete->next;
-                delete to_delete;
+                destroyElement(to_delete);
                 --size;
             }
         }
 
+        template <typename Predicate>
+        size_type eraseIf(Predicate pred) {
+            element_pointer removed = nullptr;
+            size_type count = 0;
+            try {
+                element_pointer current = root;
+                while (current != tail) {
+                    if (!pred(*current->value)) {
+                        current = current->next;
+                        continue;
+                    }
+                    // Unlink the whole run of matching elements at once and park it for release.
+                    element_pointer first = current;
+                    element_pointer last = current;
+                    size_type run = 1;
+                    while (last->next != tail && pred(*last->next->value)) {
+                        last = last->next;
+                        ++run;
+                    }
+                    current = last->next;
+                    current->prev = first->prev;
+                    if (first->prev != nullptr) {
+                        first->prev->next = current;
+                    }
+                    else {
+                        root = current;
+                    }
+                    last->next = removed;
+                    removed = first;
+                    size -= run;
+                    count += run;
+                    if (current != tail) {
+                        // the run loop has already tested it, predicates are called once per element
+                        current = current->next;
+                    }
+                }
+            }
+            catch (...) {
+                releaseChain(removed);
+                throw;
+            }
+            releaseChain(removed);
+            return count;
+        }
+
+        size_type removeValue(const Type& value) {
+            return eraseIf([&value](const Type& item) { return item == value; });
+        }
+
+        size_type uniqueInPlace() {
+            const_pointer previous = nullptr;
+            return eraseIf([&previous](const Type& item) {
+                if (previous != nullptr && *previous == item) {
+                    return true;
+                }
+                previous = &item;
+                return false;
+            });
+        }
+
+        // Seeded hash of the contents, the elements are combined one by one.
+        std::uint64_t hash(std::uint64_t seed = 0) const {
+            detail::Hasher hasher(seed);
+            for (element_pointer it = root; it != tail; it = it->next) {
+                hasher.add(detail::hashElement(*it->value));
+            }
+            return hasher.finish();
+        }
+
+        // Elements are streamed through the chunked encoder from Serialization.h.
+        void save(std::ostream& out) const {
+            detail::PayloadWriter writer(out, size, sizeof(Type), detail::IsRawSerializable<Type>::value);
+            for (element_pointer it = root; it != tail; it = it->next) {
+                Codec<Type>::write(writer, *it->value);
+            }
+            writer.finish();
+        }
+
+        void load(std::istream& in) {
+            detail::PayloadReader reader(in);
+            reader.expectElements<Type>();
+            LinkedList loaded(get_allocator());
+            // one node per element actually read, so a corrupt count ends as truncated data
+            for (std::uint64_t i = 0; i < reader.count(); ++i) {
+                loaded.append(Codec<Type>::read(reader));
+            }
+            reader.finish();
+            *this = std::move(loaded);
+        }
+
         iterator begin()
         {
             return iterator(root, *this);
@@ -218,13 +336,98 @@ namespace aisdi
         }
 
     private:
+        struct Node : Element {
+            typename std::aligned_storage<sizeof(Type), alignof(Type)>::type storage;
+        };
+
+        using NodeAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+        using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+        static_assert(std::is_same<typename NodeTraits::pointer, Node*>::value,
+                      "Allocator must use raw pointers");
+
+        // Forgets the nodes, which have to be released already.
+        void unlinkAll() {
+            root = tail;
+            guardian.prev = nullptr;
+            size = 0;
+        }
+
+        // Takes over the nodes of other, this list has to be empty.
+        void steal(LinkedList& other) {
+            if (other.size > 0) {
+                root = other.root;
+                guardian.prev = other.guardian.prev;
+                guardian.prev->next = &guardian;
+                size = other.size;
+            }
+            other.unlinkAll();
+        }
+
+        void link(const const_iterator& insertPosition, element_pointer new_element) {
+            new_element->next = insertPosition.element();
+            new_element->prev = insertPosition.element()->prev;
+            new_element->next->prev = new_element;
+
+            if (new_element->prev != nullptr) {
+                new_element->prev->next = new_element;
+            }
+            else {
+                root = new_element;
+            }
+            ++size;
+        }
+
+        template <typename Value>
+        element_pointer createElement(Value&& item) {
+            Node* new_element = NodeTraits::allocate(allocator, 1);
+            NodeTraits::construct(allocator, new_element);
+            pointer value = reinterpret_cast<pointer>(&new_element->storage);
+            try {
+                NodeTraits::construct(allocator, value, std::forward<Value>(item));
+            }
+            catch (...) {
+                destroyElement(new_element);
+                throw;
+            }
+            new_element->value = value;
+            return new_element;
+        }
+
+        void destroyElement(element_pointer to_delete) {
+            Node* node = static_cast<Node*>(to_delete);
+            if (node->value != nullptr) {
+                NodeTraits::destroy(allocator, node->value);
+            }
+            NodeTraits::destroy(allocator, node);
+            NodeTraits::deallocate(allocator, node, 1);
+        }
+
+        // Releases nodes up to the end of a detached run or up to the guardian, which is part of the list.
+        void releaseChain(element_pointer next) {
+            if (DROPS_NODES) {
+                return;
+            }
+            while (next != nullptr && next != tail) {
+                element_pointer to_delete = next;
+                next = to_delete->next;
+                destroyElement(to_delete);
+            }
+        }
+
+        // Arena-like allocators reclaim nodes of trivially destructible values without walking the chain.
+        static const bool DROPS_NODES = std::is_trivially_destructible<Type>::value
+                                        && AllocatorReleasesInBulk<NodeAllocator>::value;
+
+        NodeAllocator allocator;
+        Element guardian;
         element_pointer root;
         element_pointer tail;
         size_type size;
     };
 
-    template <typename Type>
-    class LinkedList<Type>::ConstIterator
+    template <typename Type, typename Alloc>
+    class LinkedList<Type, Alloc>::ConstIterator
     {
     public:
         using iterator_category = std::bidirectional_iterator_tag;
@@ -235,10 +438,10 @@ namespace aisdi
 
         using element_pointer = typename LinkedList::element_pointer;
 
-        explicit ConstIterator(element_pointer el, const LinkedList& parent) : current_element(el), parent(parent) {}
+        explicit ConstIterator(element_pointer el, const LinkedList& parent) : current_element(el), parent(&parent) {}
 
         reference operator*() const {
-            if (*this == parent.end()) {
+            if (*this == parent->end()) {
                 throw std::out_of_range("Iterator out of range");
             }
             return *(current_element->value);
@@ -249,7 +452,7 @@ namespace aisdi
         }
 
         ConstIterator& operator++() {
-            if (*this == parent.end()) {
+            if (*this == parent->end()) {
                 throw std::out_of_range("Iterator out of range");
             }
             current_element = current_element->next;
@@ -257,7 +460,7 @@ namespace aisdi
         }
 
         ConstIterator operator++(int) {
-            if (*this == parent.end()) {
+            if (*this == parent->end()) {
                 throw std::out_of_range("Iterator out of range");
             }
             ConstIterator result = *this;
@@ -266,7 +469,7 @@ namespace aisdi
         }
 
         ConstIterator& operator--() {
-            if (*this == parent.begin()) {
+            if (*this == parent->begin()) {
                 throw std::out_of_range("Iterator out of range");
             }
             current_element = current_element->prev;
@@ -274,7 +477,7 @@ namespace aisdi
         }
 
         ConstIterator operator--(int) {
-            if (*this == parent.begin()) {
+            if (*this == parent->begin()) {
                 throw std::out_of_range("Iterator out of range");
             }
             ConstIterator result = *this;
@@ -314,11 +517,11 @@ namespace aisdi
 
     private:
         element_pointer current_element;
-        const LinkedList& parent;
+        const LinkedList* parent;
     };
 
-    template <typename Type>
-    class LinkedList<Type>::Iterator : public LinkedList<Type>::ConstIterator
+    template <typename Type, typename Alloc>
+    class LinkedList<Type, Alloc>::Iterator : public LinkedList<Type, Alloc>::ConstIterator
     {
     public:
         using pointer = typename LinkedList::pointer;
@@ -373,6 +576,47 @@ namespace aisdi
         }
     };
 
+    template <typename Type, typename Alloc>
+    bool operator==(const LinkedList<Type, Alloc>& lhs, const LinkedList<Type, Alloc>& rhs) {
+        return lhs.getSize() == rhs.getSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <typename Type, typename Alloc>
+    bool operator!=(const LinkedList<Type, Alloc>& lhs, const LinkedList<Type, Alloc>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    template <typename Type, typename Alloc>
+    bool operator<(const LinkedList<Type, Alloc>& lhs, const LinkedList<Type, Alloc>& rhs) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template <typename Type, typename Alloc>
+    bool operator>(const LinkedList<Type, Alloc>& lhs, const LinkedList<Type, Alloc>& rhs) {
+        return rhs < lhs;
+    }
+
+    template <typename Type, typename Alloc>
+    bool operator<=(const LinkedList<Type, Alloc>& lhs, const LinkedList<Type, Alloc>& rhs) {
+        return !(rhs < lhs);
+    }
+
+    template <typename Type, typename Alloc>
+    bool operator>=(const LinkedList<Type, Alloc>& lhs, const LinkedList<Type, Alloc>& rhs) {
+        return !(lhs < rhs);
+    }
+
+}
+
+namespace std {
+
+    template <typename Type, typename Alloc>
+    struct hash<aisdi::LinkedList<Type, Alloc>> {
+        std::size_t operator()(const aisdi::LinkedList<Type, Alloc>& list) const {
+            return list.hash();
+        }
+    };
+
 }
 
 #endif // AISDI_LINEAR_LINKEDLIST_H
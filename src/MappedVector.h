@@ -0,0 +1,329 @@
+#ifndef AISDI_LINEAR_MAPPEDVECTOR_H
+#define AISDI_LINEAR_MAPPEDVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ContiguousIterator.h"
+
+namespace aisdi {
+
+    // Linux only. Vector whose storage is a memory mapped file, reopening the file gives back
+    // the previous contents without reading or parsing them.
+    template <typename Type>
+    class MappedVector {
+        static_assert(std::is_trivially_copyable<Type>::value, "MappedVector requires trivially copyable type");
+
+    public:
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = Type;
+        using pointer = Type*;
+        using reference = Type&;
+        using const_pointer = const Type*;
+        using const_reference = const Type&;
+
+        using iterator = ContiguousIterator<MappedVector>;
+        using const_iterator = ContiguousConstIterator<MappedVector>;
+
+        static const std::uint32_t FORMAT_VERSION = 1;
+
+        explicit MappedVector(const std::string& path, size_type initialCapacity = 1024)
+                : file(-1), header(nullptr), mapped_bytes(0) {
+            file = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+            if (file < 0) {
+                throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+            }
+            try {
+                struct stat status;
+                if (fstat(file, &status) != 0) {
+                    throw std::system_error(errno, std::generic_category(), "Cannot stat " + path);
+                }
+                if (status.st_size == 0) {
+                    create(std::max<size_type>(initialCapacity, 1));
+                }
+                else {
+                    attach(status.st_size);
+                }
+            }
+            catch (...) {
+                close();
+                throw;
+            }
+        }
+
+        MappedVector(const MappedVector&) = delete;
+        MappedVector& operator=(const MappedVector&) = delete;
+
+        MappedVector(MappedVector&& other) : file(other.file), header(other.header), mapped_bytes(other.mapped_bytes) {
+            other.file = -1;
+            other.header = nullptr;
+            other.mapped_bytes = 0;
+        }
+
+        MappedVector& operator=(MappedVector&& other) {
+            if (this == &other) {
+                return *this;
+            }
+            close();
+            file = other.file;
+            header = other.header;
+            mapped_bytes = other.mapped_bytes;
+            other.file = -1;
+            other.header = nullptr;
+            other.mapped_bytes = 0;
+            return *this;
+        }
+
+        ~MappedVector() {
+            close();
+        }
+
+        bool isEmpty() const {
+            return getSize() == 0;
+        }
+
+        // A moved-from collection has no mapping and reads as empty.
+        size_type getSize() const {
+            return header != nullptr ? header->size : 0;
+        }
+
+        size_type getCapacity() const {
+            return header != nullptr ? header->capacity : 0;
+        }
+
+        pointer data() {
+            if (header == nullptr) {
+                return nullptr;
+            }
+            return reinterpret_cast<pointer>(reinterpret_cast<char*>(header) + HEADER_SIZE);
+        }
+
+        const_pointer data() const {
+            if (header == nullptr) {
+                return nullptr;
+            }
+            return reinterpret_cast<const_pointer>(reinterpret_cast<const char*>(header) + HEADER_SIZE);
+        }
+
+        reference operator[](size_type index) {
+            return data()[index];
+        }
+
+        const_reference operator[](size_type index) const {
+            return data()[index];
+        }
+
+        void append(const Type& item) {
+            Type copy = item;
+            grow(getSize() + 1);
+            data()[header->size++] = copy;
+        }
+
+        void prepend(const Type& item) {
+            insert(begin(), item);
+        }
+
+        void insert(const const_iterator& insertPosition, const Type& item) {
+            size_type index = insertPosition - cbegin();
+            if (index > getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            Type copy = item;
+            grow(getSize() + 1);
+            std::memmove(data() + index + 1, data() + index, (getSize() - index) * sizeof(Type));
+            data()[index] = copy;
+            ++header->size;
+        }
+
+        Type popFirst() {
+            if (isEmpty()) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            Type val = data()[0];
+            erase(cbegin());
+            return val;
+        }
+
+        Type popLast() {
+            if (isEmpty()) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            return data()[--header->size];
+        }
+
+        void erase(const const_iterator& position) {
+            if (position < cbegin() || position >= cend()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            erase(position, position + 1);
+        }
+
+        void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded) {
+            size_type first = firstIncluded - cbegin();
+            size_type last = lastExcluded - cbegin();
+            if (first > last || last > getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            std::memmove(data() + first, data() + last, (getSize() - last) * sizeof(Type));
+            header->size -= last - first;
+        }
+
+        // Shrinks the file so that it holds only the live elements.
+        void fitToSize() {
+            remap(std::max<size_type>(getSize(), 1));
+        }
+
+        // Schedules write-back of dirty pages without waiting for it.
+        void flush() {
+            if (msync(header, mapped_bytes, MS_ASYNC) != 0) {
+                throw std::system_error(errno, std::generic_category(), "msync failed");
+            }
+        }
+
+        // Returns once the contents are on disk.
+        void sync() {
+            if (msync(header, mapped_bytes, MS_SYNC) != 0 || fsync(file) != 0) {
+                throw std::system_error(errno, std::generic_category(), "sync failed");
+            }
+        }
+
+        iterator begin() {
+            return iterator(data(), *this);
+        }
+
+        iterator end() {
+            return iterator(data() + getSize(), *this);
+        }
+
+        const_iterator cbegin() const {
+            return const_iterator(data(), *this);
+        }
+
+        const_iterator cend() const {
+            return const_iterator(data() + getSize(), *this);
+        }
+
+        const_iterator begin() const {
+            return cbegin();
+        }
+
+        const_iterator end() const {
+            return cend();
+        }
+
+    private:
+        static const std::uint64_t MAGIC = 0x524f54434556444dULL; // "MDVECTOR"
+        static const size_type HEADER_SIZE = 64;
+
+        struct Header {
+            std::uint64_t magic;
+            std::uint32_t version;
+            std::uint32_t element_size;
+            std::uint64_t size;
+            std::uint64_t capacity;
+        };
+
+        static_assert(sizeof(Header) <= HEADER_SIZE, "Header does not fit in its reserved space");
+        static_assert(HEADER_SIZE % alignof(Type) == 0, "Type is over-aligned for MappedVector");
+
+        static size_type bytesFor(size_type capacity) {
+            return HEADER_SIZE + capacity * sizeof(Type);
+        }
+
+        void create(size_type capacity) {
+            resizeFile(bytesFor(capacity));
+            map(bytesFor(capacity));
+            header->magic = MAGIC;
+            header->version = FORMAT_VERSION;
+            header->element_size = sizeof(Type);
+            header->size = 0;
+            header->capacity = capacity;
+        }
+
+        void attach(size_type fileSize) {
+            if (fileSize < HEADER_SIZE) {
+                throw std::runtime_error("File is not a MappedVector");
+            }
+            map(fileSize);
+            if (header->magic != MAGIC || header->version != FORMAT_VERSION) {
+                throw std::runtime_error("File is not a MappedVector of a supported version");
+            }
+            if (header->element_size != sizeof(Type)) {
+                throw std::runtime_error("MappedVector element size mismatch");
+            }
+            if (bytesFor(header->capacity) > fileSize || header->size > header->capacity) {
+                throw std::runtime_error("MappedVector file is truncated");
+            }
+        }
+
+        void map(size_type bytes) {
+            void* address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+            if (address == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "mmap failed");
+            }
+            header = static_cast<Header*>(address);
+            mapped_bytes = bytes;
+        }
+
+        void grow(size_type count) {
+            if (count > getCapacity()) {
+                remap(std::max(count, getCapacity() * 2));
+            }
+        }
+
+        void remap(size_type capacity) {
+            size_type bytes = bytesFor(capacity);
+            // the file has to be extended before the mapping grows and truncated after it shrinks
+            if (bytes > mapped_bytes) {
+                resizeFile(bytes);
+            }
+            void* address = mremap(header, mapped_bytes, bytes, MREMAP_MAYMOVE);
+            if (address == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "mremap failed");
+            }
+            header = static_cast<Header*>(address);
+            header->capacity = capacity;
+            if (bytes < mapped_bytes) {
+                resizeFile(bytes);
+            }
+            mapped_bytes = bytes;
+        }
+
+        void resizeFile(size_type bytes) {
+            if (ftruncate(file, bytes) != 0) {
+                throw std::system_error(errno, std::generic_category(), "ftruncate failed");
+            }
+        }
+
+        void close() {
+            if (header != nullptr) {
+                munmap(header, mapped_bytes);
+                header = nullptr;
+            }
+            if (file >= 0) {
+                ::close(file);
+                file = -1;
+            }
+        }
+
+        int file;
+        Header* header;
+        size_type mapped_bytes;
+    };
+
+}
+
+#endif // AISDI_LINEAR_MAPPEDVECTOR_H
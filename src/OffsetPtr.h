@@ -0,0 +1,79 @@
+#ifndef AISDI_LINEAR_OFFSETPTR_H
+#define AISDI_LINEAR_OFFSETPTR_H
+
+#include <cstddef>
+
+namespace aisdi {
+
+    // Pointer stored as the distance from its own address. It stays valid while it and its target
+    // move together, e.g. in shared memory mapped at different addresses by different processes.
+    template <typename Type>
+    class OffsetPtr {
+    public:
+        using element_type = Type;
+        using difference_type = std::ptrdiff_t;
+
+        OffsetPtr() : offset(NULL_OFFSET) {}
+
+        OffsetPtr(Type* target) : offset(offsetTo(target)) {}
+
+        OffsetPtr(const OffsetPtr& other) : offset(offsetTo(other.get())) {}
+
+        OffsetPtr& operator=(const OffsetPtr& other) {
+            offset = offsetTo(other.get());
+            return *this;
+        }
+
+        OffsetPtr& operator=(Type* target) {
+            offset = offsetTo(target);
+            return *this;
+        }
+
+        Type* get() const {
+            if (offset == NULL_OFFSET) {
+                return nullptr;
+            }
+            return reinterpret_cast<Type*>(const_cast<char*>(reinterpret_cast<const char*>(this)) + offset);
+        }
+
+        Type& operator*() const {
+            return *get();
+        }
+
+        Type* operator->() const {
+            return get();
+        }
+
+        Type& operator[](difference_type index) const {
+            return get()[index];
+        }
+
+        explicit operator bool() const {
+            return offset != NULL_OFFSET;
+        }
+
+        bool operator==(const OffsetPtr& other) const {
+            return get() == other.get();
+        }
+
+        bool operator!=(const OffsetPtr& other) const {
+            return get() != other.get();
+        }
+
+    private:
+        // no object can start inside the pointer itself, so 1 is free to mean null
+        static const difference_type NULL_OFFSET = 1;
+
+        difference_type offsetTo(const Type* target) const {
+            if (target == nullptr) {
+                return NULL_OFFSET;
+            }
+            return reinterpret_cast<const char*>(target) - reinterpret_cast<const char*>(this);
+        }
+
+        difference_type offset;
+    };
+
+}
+
+#endif // AISDI_LINEAR_OFFSETPTR_H
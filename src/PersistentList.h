@@ -0,0 +1,210 @@
+#ifndef AISDI_LINEAR_PERSISTENTLIST_H
+#define AISDI_LINEAR_PERSISTENTLIST_H
+
+#include <cstddef>
+#include <atomic>
+#include <iterator>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "Vector.h"
+
+namespace aisdi {
+
+    // Immutable singly linked list. prepend and popFirst are O(1) and give new versions sharing the rest
+    // of the list, cells are reference counted atomically so versions may be passed between threads.
+    template <typename Type>
+    class PersistentList {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = Type;
+        using pointer = Type*;
+        using reference = Type&;
+        using const_pointer = const Type*;
+        using const_reference = const Type&;
+
+        class ConstIterator;
+        using iterator = ConstIterator;
+        using const_iterator = ConstIterator;
+
+        PersistentList() : head(nullptr) {}
+
+        PersistentList(std::initializer_list<Type> l) : PersistentList(fromRange(l.begin(), l.end())) {}
+
+        // Copies [first, last) keeping the order.
+        template <typename InputIterator>
+        static PersistentList fromRange(InputIterator first, InputIterator last) {
+            PersistentList result;
+            Cell** link = &result.head;
+            size_type size = 0;
+            for (; first != last; ++first, ++size) {
+                *link = new Cell(*first, nullptr);
+                link = &(*link)->next;
+            }
+            // the length is known only at the end, so sizes are filled in afterwards
+            for (Cell* cell = result.head; cell != nullptr; cell = cell->next) {
+                cell->size = size--;
+            }
+            return result;
+        }
+
+        PersistentList(const PersistentList& other) : head(other.head) {
+            retain(head);
+        }
+
+        PersistentList(PersistentList&& other) : head(other.head) {
+            other.head = nullptr;
+        }
+
+        PersistentList& operator=(PersistentList other) {
+            std::swap(head, other.head);
+            return *this;
+        }
+
+        ~PersistentList() {
+            release(head);
+        }
+
+        bool isEmpty() const {
+            return head == nullptr;
+        }
+
+        size_type getSize() const {
+            return head != nullptr ? head->size : 0;
+        }
+
+        const_reference first() const {
+            if (isEmpty()) {
+                throw std::logic_error("You cannot read first element of empty collection");
+            }
+            return head->value;
+        }
+
+        PersistentList prepend(const Type& item) const {
+            Cell* cell = new Cell(item, head);
+            retain(head);
+            return PersistentList(cell);
+        }
+
+        // The list without its first element, sharing all remaining cells.
+        PersistentList popFirst() const {
+            if (isEmpty()) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            retain(head->next);
+            return PersistentList(head->next);
+        }
+
+        PersistentList tail() const {
+            return popFirst();
+        }
+
+        Vector<Type> toVector() const {
+            Vector<Type> result;
+            result.reserve(getSize());
+            for (const Cell* cell = head; cell != nullptr; cell = cell->next) {
+                result.append(cell->value);
+            }
+            return result;
+        }
+
+        const_iterator cbegin() const {
+            return const_iterator(head);
+        }
+
+        const_iterator cend() const {
+            return const_iterator(nullptr);
+        }
+
+        const_iterator begin() const {
+            return cbegin();
+        }
+
+        const_iterator end() const {
+            return cend();
+        }
+
+    private:
+        struct Cell {
+            Cell(const Type& value, Cell* next)
+                    : references(1), size(next != nullptr ? next->size + 1 : 1), next(next), value(value) {}
+
+            std::atomic<std::size_t> references;
+            size_type size;
+            Cell* next;
+            Type value;
+        };
+
+        explicit PersistentList(Cell* adopted) : head(adopted) {}
+
+        static void retain(Cell* cell) {
+            if (cell != nullptr) {
+                cell->references.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // Iterative, so that dropping the last version of a long list does not recurse per cell.
+        static void release(Cell* cell) {
+            while (cell != nullptr && cell->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                Cell* next = cell->next;
+                delete cell;
+                cell = next;
+            }
+        }
+
+        Cell* head;
+    };
+
+    template <typename Type>
+    class PersistentList<Type>::ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename PersistentList::value_type;
+        using difference_type = typename PersistentList::difference_type;
+        using pointer = typename PersistentList::const_pointer;
+        using reference = typename PersistentList::const_reference;
+
+        explicit ConstIterator(const Cell* cell) : cell(cell) {}
+
+        reference operator*() const {
+            if (cell == nullptr) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            return cell->value;
+        }
+
+        pointer operator->() const {
+            return &operator*();
+        }
+
+        ConstIterator& operator++() {
+            if (cell == nullptr) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            cell = cell->next;
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator result = *this;
+            operator++();
+            return result;
+        }
+
+        bool operator==(const ConstIterator& other) const {
+            return cell == other.cell;
+        }
+
+        bool operator!=(const ConstIterator& other) const {
+            return cell != other.cell;
+        }
+
+    private:
+        const Cell* cell;
+    };
+
+}
+
+#endif // AISDI_LINEAR_PERSISTENTLIST_H
@@ -0,0 +1,777 @@
+#ifndef AISDI_LINEAR_PERSISTENTVECTOR_H
+#define AISDI_LINEAR_PERSISTENTVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <new>
+#include <iterator>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+
+namespace aisdi {
+
+    // Immutable vector stored as a relaxed radix balanced tree with 32-way nodes. Every modification
+    // returns a new version sharing all untouched nodes with the old one, nodes are reference counted
+    // atomically so versions can be used from many threads. Nodes built by appending stay dense and are
+    // indexed by radix, concat, insert and slice leave relaxed nodes that keep cumulative child sizes.
+    template <typename Type>
+    class PersistentVector {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = Type;
+        using pointer = Type*;
+        using reference = Type&;
+        using const_pointer = const Type*;
+        using const_reference = const Type&;
+
+        class ConstIterator;
+        class Transient;
+        using iterator = ConstIterator;
+        using const_iterator = ConstIterator;
+
+        static const size_type BRANCHING = 32;
+
+        PersistentVector() : height(0) {}
+
+        PersistentVector(std::initializer_list<Type> l) : PersistentVector() {
+            Transient builder;
+            for (const Type& item : l) {
+                builder.append(item);
+            }
+            *this = builder.persistent();
+        }
+
+        bool isEmpty() const {
+            return getSize() == 0;
+        }
+
+        size_type getSize() const {
+            return root ? root->size : 0;
+        }
+
+        const_reference get(size_type index) const {
+            if (index >= getSize()) {
+                throw std::out_of_range("Index out of range");
+            }
+            const Node* leaf = leafFor(index);
+            return valuesOf(leaf)[index];
+        }
+
+        PersistentVector set(size_type index, const Type& item) const {
+            if (index >= getSize()) {
+                throw std::out_of_range("Index out of range");
+            }
+            return PersistentVector(assigned(root.get(), height, index, item, false), height);
+        }
+
+        PersistentVector append(const Type& item) const {
+            PersistentVector result(*this);
+            appendTo(result.root, result.height, item, false);
+            return result;
+        }
+
+        PersistentVector prepend(const Type& item) const {
+            return insert(0, item);
+        }
+
+        PersistentVector insert(size_type index, const Type& item) const {
+            if (index > getSize()) {
+                throw std::out_of_range("Index out of range");
+            }
+            if (index == getSize()) {
+                return append(item);
+            }
+            return slice(0, index).append(item).concat(slice(index, getSize()));
+        }
+
+        PersistentVector erase(size_type index) const {
+            if (index >= getSize()) {
+                throw std::out_of_range("Index out of range");
+            }
+            return slice(0, index).concat(slice(index + 1, getSize()));
+        }
+
+        PersistentVector concat(const PersistentVector& other) const {
+            if (other.isEmpty()) {
+                return *this;
+            }
+            if (isEmpty()) {
+                return other;
+            }
+            Ref parts[2];
+            size_type count = joined(root.get(), height, other.root.get(), other.height, parts);
+            unsigned joinedHeight = std::max(height, other.height);
+            if (count == 1) {
+                return PersistentVector(std::move(parts[0]), joinedHeight);
+            }
+            return PersistentVector(branchOf(parts, 0, 2, joinedHeight + 1), joinedHeight + 1);
+        }
+
+        // Elements [firstIncluded, lastExcluded).
+        PersistentVector slice(size_type firstIncluded, size_type lastExcluded) const {
+            if (firstIncluded > lastExcluded || lastExcluded > getSize()) {
+                throw std::out_of_range("Index out of range");
+            }
+            if (firstIncluded == lastExcluded) {
+                return PersistentVector();
+            }
+            Ref sliced = taken(root.get(), height, lastExcluded);
+            sliced = dropped(sliced.get(), height, firstIncluded);
+            unsigned slicedHeight = height;
+            trim(sliced, slicedHeight);
+            return PersistentVector(std::move(sliced), slicedHeight);
+        }
+
+        // Mutable builder starting from this version, for bulk changes without a copy per step.
+        Transient transient() const {
+            return Transient(*this);
+        }
+
+        // Calls function(const Type* values, size_type count) for every leaf, in order.
+        template <typename Function>
+        void forEachLeaf(Function function) const {
+            if (root) {
+                visitLeaves(root.get(), height, function);
+            }
+        }
+
+        const_iterator cbegin() const {
+            return const_iterator(*this, 0);
+        }
+
+        const_iterator cend() const {
+            return const_iterator(*this, getSize());
+        }
+
+        const_iterator begin() const {
+            return cbegin();
+        }
+
+        const_iterator end() const {
+            return cend();
+        }
+
+    private:
+        static const unsigned BITS = 5;
+        static const size_type EXTRA_NODES = 2;
+
+        struct Node {
+            explicit Node(bool leaf) : references(1), size(0), count(0), leaf(leaf) {}
+
+            std::atomic<std::size_t> references;
+            size_type size;
+            size_type count;
+            bool leaf;
+        };
+
+        struct Leaf : Node {
+            Leaf() : Node(true) {}
+
+            typename std::aligned_storage<sizeof(Type), alignof(Type)>::type storage[BRANCHING];
+        };
+
+        // Dense branches (every child but the last one full) have no size table.
+        struct Branch : Node {
+            Branch() : Node(false), sizes(nullptr) {}
+
+            Node* children[BRANCHING];
+            size_type* sizes;
+        };
+
+        // Owning handle of one node reference.
+        class Ref {
+        public:
+            Ref() : node(nullptr) {}
+
+            explicit Ref(Node* adopted) : node(adopted) {}
+
+            static Ref share(Node* node) {
+                retain(node);
+                return Ref(node);
+            }
+
+            Ref(const Ref& other) : node(other.node) {
+                retain(node);
+            }
+
+            Ref(Ref&& other) : node(other.node) {
+                other.node = nullptr;
+            }
+
+            Ref& operator=(Ref other) {
+                std::swap(node, other.node);
+                return *this;
+            }
+
+            ~Ref() {
+                release(node);
+            }
+
+            Node* get() const {
+                return node;
+            }
+
+            Node* operator->() const {
+                return node;
+            }
+
+            explicit operator bool() const {
+                return node != nullptr;
+            }
+
+            Node* detach() {
+                Node* result = node;
+                node = nullptr;
+                return result;
+            }
+
+        private:
+            Node* node;
+        };
+
+        PersistentVector(Ref root, unsigned height) : root(std::move(root)), height(height) {}
+
+        static void retain(Node* node) {
+            if (node != nullptr) {
+                node->references.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        static void release(Node* node) {
+            if (node == nullptr || node->references.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+            if (node->leaf) {
+                Type* values = valuesOf(node);
+                for (size_type i = node->count; i > 0; --i) {
+                    values[i - 1].~Type();
+                }
+                delete static_cast<Leaf*>(node);
+            }
+            else {
+                Branch* branch = static_cast<Branch*>(node);
+                for (size_type i = 0; i < branch->count; ++i) {
+                    release(branch->children[i]);
+                }
+                delete[] branch->sizes;
+                delete branch;
+            }
+        }
+
+        static Type* valuesOf(Node* node) {
+            return reinterpret_cast<Type*>(static_cast<Leaf*>(node)->storage);
+        }
+
+        static const Type* valuesOf(const Node* node) {
+            return reinterpret_cast<const Type*>(static_cast<const Leaf*>(node)->storage);
+        }
+
+        static Branch* asBranch(Node* node) {
+            return static_cast<Branch*>(node);
+        }
+
+        static const Branch* asBranch(const Node* node) {
+            return static_cast<const Branch*>(node);
+        }
+
+        // Number of elements a child of a branch at the given height can hold.
+        static size_type childCapacity(unsigned height) {
+            return size_type(1) << (BITS * height);
+        }
+
+        static size_type childStart(const Branch* branch, unsigned height, size_type slot) {
+            if (slot == 0) {
+                return 0;
+            }
+            return branch->sizes != nullptr ? branch->sizes[slot - 1] : slot * childCapacity(height);
+        }
+
+        // Children never exceed their capacity, so the radix slot is a lower bound in relaxed branches.
+        static size_type findSlot(const Branch* branch, unsigned height, size_type index) {
+            size_type slot = index >> (BITS * height);
+            if (branch->sizes != nullptr) {
+                while (branch->sizes[slot] <= index) {
+                    ++slot;
+                }
+            }
+            return slot;
+        }
+
+        // Leaf holding the element, index becomes its position in that leaf.
+        const Node* leafFor(size_type& index) const {
+            const Node* node = root.get();
+            for (unsigned level = height; level > 0; --level) {
+                const Branch* branch = asBranch(node);
+                size_type slot = findSlot(branch, level, index);
+                index -= childStart(branch, level, slot);
+                node = branch->children[slot];
+            }
+            return node;
+        }
+
+        static void pushValue(Node* leaf, const Type& item) {
+            new (valuesOf(leaf) + leaf->count) Type(item);
+            ++leaf->count;
+            ++leaf->size;
+        }
+
+        static void pushChild(Node* branch, Ref child) {
+            branch->size += child->size;
+            asBranch(branch)->children[branch->count++] = child.detach();
+        }
+
+        // Recomputes the size and decides whether the branch needs a size table.
+        static void finish(Node* node, unsigned height) {
+            Branch* branch = asBranch(node);
+            bool dense = true;
+            size_type total = 0;
+            for (size_type i = 0; i < branch->count; ++i) {
+                const Node* child = branch->children[i];
+                total += child->size;
+                if (i + 1 < branch->count ? child->size != childCapacity(height)
+                                          : !child->leaf && asBranch(child)->sizes != nullptr) {
+                    dense = false;
+                }
+            }
+            branch->size = total;
+            if (dense) {
+                delete[] branch->sizes;
+                branch->sizes = nullptr;
+                return;
+            }
+            if (branch->sizes == nullptr) {
+                branch->sizes = new size_type[BRANCHING];
+            }
+            total = 0;
+            for (size_type i = 0; i < branch->count; ++i) {
+                total += branch->children[i]->size;
+                branch->sizes[i] = total;
+            }
+        }
+
+        static Ref copyLeaf(const Node* source, size_type firstIncluded, size_type lastExcluded) {
+            Ref leaf(new Leaf());
+            const Type* values = valuesOf(source);
+            for (size_type i = firstIncluded; i < lastExcluded; ++i) {
+                pushValue(leaf.get(), values[i]);
+            }
+            return leaf;
+        }
+
+        static Ref branchOf(Ref* parts, size_type firstIncluded, size_type lastExcluded, unsigned height) {
+            Ref branch(new Branch());
+            for (size_type i = firstIncluded; i < lastExcluded; ++i) {
+                pushChild(branch.get(), std::move(parts[i]));
+            }
+            finish(branch.get(), height);
+            return branch;
+        }
+
+        static Ref copyOf(Node* node, unsigned height) {
+            if (height == 0) {
+                return copyLeaf(node, 0, node->count);
+            }
+            Ref branch(new Branch());
+            for (size_type i = 0; i < node->count; ++i) {
+                pushChild(branch.get(), Ref::share(asBranch(node)->children[i]));
+            }
+            finish(branch.get(), height);
+            return branch;
+        }
+
+        // A transient may change nodes nobody else references, everything else is path copied.
+        static bool ownsExclusively(const Node* node, bool inPlace) {
+            return inPlace && node->references.load(std::memory_order_acquire) == 1;
+        }
+
+        static Ref editable(Node* node, unsigned height, bool inPlace) {
+            return ownsExclusively(node, inPlace) ? Ref::share(node) : copyOf(node, height);
+        }
+
+        static void replaceChild(Node* branch, size_type slot, Ref child) {
+            Node*& current = asBranch(branch)->children[slot];
+            if (child.get() != current) {
+                release(current);
+                current = child.detach();
+            }
+        }
+
+        static Ref assigned(Node* node, unsigned height, size_type index, const Type& item, bool inPlace) {
+            Ref target = editable(node, height, inPlace);
+            if (height == 0) {
+                valuesOf(target.get())[index] = item;
+                return target;
+            }
+            Branch* branch = asBranch(target.get());
+            size_type slot = findSlot(branch, height, index);
+            Ref child = assigned(branch->children[slot], height - 1, index - childStart(branch, height, slot), item,
+                                 ownsExclusively(node, inPlace));
+            replaceChild(branch, slot, std::move(child));
+            return target;
+        }
+
+        // Single element subtree of the given height.
+        static Ref pathTo(unsigned height, const Type& item) {
+            Ref node(new Leaf());
+            pushValue(node.get(), item);
+            for (unsigned level = 1; level <= height; ++level) {
+                Ref branch(new Branch());
+                pushChild(branch.get(), std::move(node));
+                node = std::move(branch);
+            }
+            return node;
+        }
+
+        // Empty when the subtree is already full.
+        static Ref appended(Node* node, unsigned height, const Type& item, bool inPlace) {
+            if (height == 0) {
+                if (node->count == BRANCHING) {
+                    return Ref();
+                }
+                Ref target = editable(node, 0, inPlace);
+                pushValue(target.get(), item);
+                return target;
+            }
+            Ref child = appended(asBranch(node)->children[node->count - 1], height - 1, item,
+                                 ownsExclusively(node, inPlace));
+            if (!child && node->count == BRANCHING) {
+                return Ref();
+            }
+            Ref target = editable(node, height, inPlace);
+            if (child) {
+                replaceChild(target.get(), target->count - 1, std::move(child));
+            }
+            else {
+                pushChild(target.get(), pathTo(height - 1, item));
+            }
+            finish(target.get(), height);
+            return target;
+        }
+
+        static void appendTo(Ref& root, unsigned& height, const Type& item, bool inPlace) {
+            if (!root) {
+                root = pathTo(0, item);
+                height = 0;
+                return;
+            }
+            Ref result = appended(root.get(), height, item, inPlace);
+            if (!result) {
+                result = Ref(new Branch());
+                pushChild(result.get(), root);
+                pushChild(result.get(), pathTo(height, item));
+                finish(result.get(), ++height);
+            }
+            root = std::move(result);
+        }
+
+        // Puts two subtrees side by side, merging along the seam. Gives one or two nodes as high as the higher one.
+        static size_type joined(Node* left, unsigned leftHeight, Node* right, unsigned rightHeight, Ref* out) {
+            if (leftHeight == 0 && rightHeight == 0) {
+                if (left->count == BRANCHING) {
+                    out[0] = Ref::share(left);
+                    out[1] = Ref::share(right);
+                    return 2;
+                }
+                size_type moved = std::min(BRANCHING - left->count, right->count);
+                out[0] = copyLeaf(left, 0, left->count);
+                for (size_type i = 0; i < moved; ++i) {
+                    pushValue(out[0].get(), valuesOf(right)[i]);
+                }
+                if (moved == right->count) {
+                    return 1;
+                }
+                out[1] = copyLeaf(right, moved, right->count);
+                return 2;
+            }
+            Ref parts[2 * BRANCHING + 1];
+            size_type count = 0;
+            Ref middle[2];
+            size_type middleCount;
+            if (leftHeight > rightHeight) {
+                Branch* branch = asBranch(left);
+                for (size_type i = 0; i + 1 < branch->count; ++i) {
+                    parts[count++] = Ref::share(branch->children[i]);
+                }
+                middleCount = joined(branch->children[branch->count - 1], leftHeight - 1, right, rightHeight, middle);
+            }
+            else if (rightHeight > leftHeight) {
+                middleCount = joined(left, leftHeight, asBranch(right)->children[0], rightHeight - 1, middle);
+            }
+            else {
+                Branch* branch = asBranch(left);
+                for (size_type i = 0; i + 1 < branch->count; ++i) {
+                    parts[count++] = Ref::share(branch->children[i]);
+                }
+                middleCount = joined(branch->children[branch->count - 1], leftHeight - 1,
+                                     asBranch(right)->children[0], rightHeight - 1, middle);
+            }
+            for (size_type i = 0; i < middleCount; ++i) {
+                parts[count++] = std::move(middle[i]);
+            }
+            if (rightHeight >= leftHeight) {
+                Branch* branch = asBranch(right);
+                for (size_type i = 1; i < branch->count; ++i) {
+                    parts[count++] = Ref::share(branch->children[i]);
+                }
+            }
+            unsigned joinedHeight = std::max(leftHeight, rightHeight);
+            count = rebalanced(parts, count, joinedHeight - 1);
+            size_type first = count < BRANCHING ? count : BRANCHING;
+            out[0] = branchOf(parts, 0, first, joinedHeight);
+            if (first == count) {
+                return 1;
+            }
+            out[1] = branchOf(parts, first, count, joinedHeight);
+            return 2;
+        }
+
+        // Concatenation plan of RRB trees: while the parts (siblings of the given height, in order) use more than
+        // EXTRA_NODES nodes over the minimum their slots need, the first part which is not nearly full is merged
+        // into the following ones. Lookups then stay within a few steps of the radix slot and the height logarithmic.
+        static size_type rebalanced(Ref* parts, size_type count, unsigned height) {
+            size_type sizes[2 * BRANCHING + 1];
+            size_type slots = 0;
+            for (size_type i = 0; i < count; ++i) {
+                sizes[i] = parts[i]->count;
+                slots += sizes[i];
+            }
+            size_type optimal = (slots + BRANCHING - 1) / BRANCHING;
+            if (count <= optimal + EXTRA_NODES) {
+                return count;
+            }
+            size_type planned = count;
+            size_type i = 0;
+            while (planned > optimal + EXTRA_NODES) {
+                while (sizes[i] >= BRANCHING - 1) {
+                    ++i;
+                }
+                size_type remaining = sizes[i];
+                do {
+                    size_type merged = remaining + sizes[i + 1] < BRANCHING ? remaining + sizes[i + 1] : BRANCHING;
+                    remaining = remaining + sizes[i + 1] - merged;
+                    sizes[i] = merged;
+                    ++i;
+                } while (remaining > 0);
+                for (size_type j = i; j + 1 < planned; ++j) {
+                    sizes[j] = sizes[j + 1];
+                }
+                --planned;
+                --i;
+            }
+
+            Ref result[2 * BRANCHING + 1];
+            size_type source = 0;
+            size_type offset = 0;
+            for (size_type k = 0; k < planned; ++k) {
+                if (offset == 0 && parts[source]->count == sizes[k]) {
+                    result[k] = std::move(parts[source++]);
+                    continue;
+                }
+                result[k] = height == 0 ? Ref(new Leaf()) : Ref(new Branch());
+                Node* node = result[k].get();
+                while (node->count < sizes[k]) {
+                    Node* from = parts[source].get();
+                    size_type taking = std::min(sizes[k] - node->count, from->count - offset);
+                    for (size_type t = offset; t < offset + taking; ++t) {
+                        if (height == 0) {
+                            pushValue(node, valuesOf(from)[t]);
+                        }
+                        else {
+                            pushChild(node, Ref::share(asBranch(from)->children[t]));
+                        }
+                    }
+                    offset += taking;
+                    if (offset == from->count) {
+                        ++source;
+                        offset = 0;
+                    }
+                }
+                if (height > 0) {
+                    finish(node, height);
+                }
+            }
+            for (size_type k = 0; k < planned; ++k) {
+                parts[k] = std::move(result[k]);
+            }
+            return planned;
+        }
+
+        // First count elements, 0 < count.
+        static Ref taken(Node* node, unsigned height, size_type count) {
+            if (count == node->size) {
+                return Ref::share(node);
+            }
+            if (height == 0) {
+                return copyLeaf(node, 0, count);
+            }
+            Branch* branch = asBranch(node);
+            size_type slot = findSlot(branch, height, count - 1);
+            Ref result(new Branch());
+            for (size_type i = 0; i < slot; ++i) {
+                pushChild(result.get(), Ref::share(branch->children[i]));
+            }
+            pushChild(result.get(), taken(branch->children[slot], height - 1, count - childStart(branch, height, slot)));
+            finish(result.get(), height);
+            return result;
+        }
+
+        // Everything but the first count elements, count < size.
+        static Ref dropped(Node* node, unsigned height, size_type count) {
+            if (count == 0) {
+                return Ref::share(node);
+            }
+            if (height == 0) {
+                return copyLeaf(node, count, node->count);
+            }
+            Branch* branch = asBranch(node);
+            size_type slot = findSlot(branch, height, count);
+            Ref result(new Branch());
+            pushChild(result.get(), dropped(branch->children[slot], height - 1, count - childStart(branch, height, slot)));
+            for (size_type i = slot + 1; i < branch->count; ++i) {
+                pushChild(result.get(), Ref::share(branch->children[i]));
+            }
+            finish(result.get(), height);
+            return result;
+        }
+
+        static void trim(Ref& root, unsigned& height) {
+            while (height > 0 && root->count == 1) {
+                root = Ref::share(asBranch(root.get())->children[0]);
+                --height;
+            }
+        }
+
+        template <typename Function>
+        static void visitLeaves(const Node* node, unsigned height, Function& function) {
+            if (height == 0) {
+                function(valuesOf(node), node->count);
+                return;
+            }
+            const Branch* branch = asBranch(node);
+            for (size_type i = 0; i < branch->count; ++i) {
+                visitLeaves(branch->children[i], height - 1, function);
+            }
+        }
+
+        Ref root;
+        unsigned height;
+    };
+
+    template <typename Type>
+    class PersistentVector<Type>::Transient {
+    public:
+        Transient() : height(0) {}
+
+        explicit Transient(const PersistentVector& from) : root(from.root), height(from.height) {}
+
+        Transient(const Transient&) = delete;
+        Transient& operator=(const Transient&) = delete;
+
+        Transient(Transient&& other) : root(std::move(other.root)), height(other.height) {}
+
+        size_type getSize() const {
+            return root ? root->size : 0;
+        }
+
+        void append(const Type& item) {
+            appendTo(root, height, item, true);
+        }
+
+        void set(size_type index, const Type& item) {
+            if (index >= getSize()) {
+                throw std::out_of_range("Index out of range");
+            }
+            root = assigned(root.get(), height, index, item, true);
+        }
+
+        // Freezes the contents into a version, the builder is left empty.
+        PersistentVector persistent() {
+            PersistentVector result(std::move(root), height);
+            height = 0;
+            return result;
+        }
+
+    private:
+        Ref root;
+        unsigned height;
+    };
+
+    // Walks one leaf array at a time, descending from the root only when a leaf runs out.
+    template <typename Type>
+    class PersistentVector<Type>::ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename PersistentVector::value_type;
+        using difference_type = typename PersistentVector::difference_type;
+        using pointer = typename PersistentVector::const_pointer;
+        using reference = typename PersistentVector::const_reference;
+
+        ConstIterator(const PersistentVector& parent, size_type index)
+                : parent(&parent), index(index), current(nullptr), leaf_end(index) {
+            locate();
+        }
+
+        reference operator*() const {
+            if (index >= parent->getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            return *current;
+        }
+
+        pointer operator->() const {
+            return &operator*();
+        }
+
+        ConstIterator& operator++() {
+            if (index >= parent->getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            if (++index == leaf_end) {
+                locate();
+            }
+            else {
+                ++current;
+            }
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator result = *this;
+            operator++();
+            return result;
+        }
+
+        bool operator==(const ConstIterator& other) const {
+            return parent == other.parent && index == other.index;
+        }
+
+        bool operator!=(const ConstIterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        void locate() {
+            if (index >= parent->getSize()) {
+                current = nullptr;
+                return;
+            }
+            size_type offset = index;
+            const Node* leaf = parent->leafFor(offset);
+            current = valuesOf(leaf) + offset;
+            leaf_end = index + leaf->count - offset;
+        }
+
+        const PersistentVector* parent;
+        size_type index;
+        const Type* current;
+        size_type leaf_end;
+    };
+
+}
+
+#endif // AISDI_LINEAR_PERSISTENTVECTOR_H
@@ -0,0 +1,417 @@
+#ifndef AISDI_LINEAR_SEGMENTEDVECTOR_H
+#define AISDI_LINEAR_SEGMENTEDVECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <algorithm>
+#include <new>
+#include <utility>
+
+namespace aisdi {
+
+    // Vector made of geometrically growing blocks: block k holds FIRST_BLOCK_SIZE << k elements.
+    // Growing only allocates a new block, so elements are never copied and references stay valid.
+    template <typename Type>
+    class SegmentedVector {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = Type;
+        using pointer = Type*;
+        using reference = Type&;
+        using const_pointer = const Type*;
+        using const_reference = const Type&;
+
+        class ConstIterator;
+        class Iterator;
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+        SegmentedVector() : elements(0), allocated_blocks(0) {}
+
+        SegmentedVector(std::initializer_list<Type> l) : SegmentedVector() {
+            for (const auto& val : l) {
+                append(val);
+            }
+        }
+
+        SegmentedVector(const SegmentedVector& other) : SegmentedVector() {
+            for (size_type i = 0; i < other.elements; ++i) {
+                append(other[i]);
+            }
+        }
+
+        SegmentedVector(SegmentedVector&& other) : elements(other.elements), allocated_blocks(other.allocated_blocks) {
+            std::copy(other.blocks, other.blocks + other.allocated_blocks, blocks);
+            other.elements = 0;
+            other.allocated_blocks = 0;
+        }
+
+        ~SegmentedVector() {
+            clear();
+            releaseBlocks(0);
+        }
+
+        SegmentedVector& operator=(const SegmentedVector& other) {
+            if (this == &other) {
+                return *this;
+            }
+            clear();
+            for (size_type i = 0; i < other.elements; ++i) {
+                append(other[i]);
+            }
+            return *this;
+        }
+
+        SegmentedVector& operator=(SegmentedVector&& other) {
+            if (this == &other) {
+                return *this;
+            }
+            clear();
+            releaseBlocks(0);
+            std::copy(other.blocks, other.blocks + other.allocated_blocks, blocks);
+            elements = other.elements;
+            allocated_blocks = other.allocated_blocks;
+            other.elements = 0;
+            other.allocated_blocks = 0;
+            return *this;
+        }
+
+        bool isEmpty() const {
+            return getSize() == 0;
+        }
+
+        size_type getSize() const {
+            return elements;
+        }
+
+        reference operator[](size_type index) {
+            return *slot(index);
+        }
+
+        const_reference operator[](size_type index) const {
+            return *slot(index);
+        }
+
+        void append(const Type& item) {
+            pointer place = freeSlot();
+            new (place) Type(item);
+            ++elements;
+        }
+
+        void prepend(const Type& item) {
+            insert(begin(), item);
+        }
+
+        void insert(const const_iterator& insertPosition, const Type& item) {
+            size_type index = insertPosition.index();
+            if (index > elements) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            if (index == elements) {
+                append(item);
+                return;
+            }
+            Type copy(item);
+            pointer place = freeSlot();
+            new (place) Type(std::move(*slot(elements - 1)));
+            ++elements;
+            for (size_type i = elements - 2; i > index; --i) {
+                *slot(i) = std::move(*slot(i - 1));
+            }
+            *slot(index) = std::move(copy);
+        }
+
+        Type popFirst() {
+            if (isEmpty()) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            Type val = std::move(*slot(0));
+            erase(cbegin());
+            return val;
+        }
+
+        Type popLast() {
+            if (isEmpty()) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            Type val = std::move(*slot(elements - 1));
+            destroyTail(elements - 1);
+            return val;
+        }
+
+        void erase(const const_iterator& position) {
+            if (position.index() >= elements) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            erase(position, position + 1);
+        }
+
+        void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded) {
+            size_type first = firstIncluded.index();
+            size_type last = lastExcluded.index();
+            if (first > last || last > elements) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            for (size_type i = last; i < elements; ++i) {
+                *slot(first + i - last) = std::move(*slot(i));
+            }
+            destroyTail(elements - (last - first));
+        }
+
+        // Releases blocks which no longer hold any element.
+        void fitToSize() {
+            size_type needed = 0;
+            while (needed < allocated_blocks && blockStart(needed) < elements) {
+                ++needed;
+            }
+            releaseBlocks(needed);
+        }
+
+        iterator begin() {
+            return iterator(0, *this);
+        }
+
+        iterator end() {
+            return iterator(elements, *this);
+        }
+
+        const_iterator cbegin() const {
+            return const_iterator(0, *this);
+        }
+
+        const_iterator cend() const {
+            return const_iterator(elements, *this);
+        }
+
+        const_iterator begin() const {
+            return cbegin();
+        }
+
+        const_iterator end() const {
+            return cend();
+        }
+
+    private:
+        static const size_type FIRST_BLOCK_SHIFT = 4;
+        static const size_type FIRST_BLOCK_SIZE = size_type(1) << FIRST_BLOCK_SHIFT;
+        static const size_type MAX_BLOCKS = sizeof(size_type) * 8 - FIRST_BLOCK_SHIFT;
+
+        static size_type highestBit(size_type value) {
+#if defined(__GNUC__)
+            return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(value);
+#else
+            size_type bit = 0;
+            while (value >>= 1) {
+                ++bit;
+            }
+            return bit;
+#endif
+        }
+
+        static size_type blockSize(size_type block) {
+            return FIRST_BLOCK_SIZE << block;
+        }
+
+        static size_type blockStart(size_type block) {
+            return blockSize(block) - FIRST_BLOCK_SIZE;
+        }
+
+        pointer slot(size_type index) const {
+            size_type shifted = index + FIRST_BLOCK_SIZE;
+            size_type top = highestBit(shifted);
+            return blocks[top - FIRST_BLOCK_SHIFT] + (shifted - (size_type(1) << top));
+        }
+
+        pointer freeSlot() {
+            size_type shifted = elements + FIRST_BLOCK_SIZE;
+            size_type block = highestBit(shifted) - FIRST_BLOCK_SHIFT;
+            if (block == allocated_blocks) {
+                if (block == MAX_BLOCKS) {
+                    throw std::length_error("SegmentedVector is full");
+                }
+                blocks[block] = static_cast<pointer>(::operator new(sizeof(Type) * blockSize(block)));
+                ++allocated_blocks;
+            }
+            return slot(elements);
+        }
+
+        void destroyTail(size_type newSize) {
+            while (elements > newSize) {
+                --elements;
+                slot(elements)->~Type();
+            }
+        }
+
+        void clear() {
+            destroyTail(0);
+        }
+
+        void releaseBlocks(size_type keep) {
+            while (allocated_blocks > keep) {
+                --allocated_blocks;
+                ::operator delete(blocks[allocated_blocks]);
+            }
+        }
+
+        pointer blocks[MAX_BLOCKS];
+        size_type elements;
+        size_type allocated_blocks;
+    };
+
+    template <typename Type>
+    class SegmentedVector<Type>::ConstIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename SegmentedVector::value_type;
+        using difference_type = typename SegmentedVector::difference_type;
+        using pointer = typename SegmentedVector::const_pointer;
+        using reference = typename SegmentedVector::const_reference;
+
+        explicit ConstIterator(size_type idx, const SegmentedVector<Type>& parent) : current_index(idx), parent(&parent) {}
+
+        reference operator*() const {
+            if (current_index >= parent->getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            return (*parent)[current_index];
+        }
+
+        size_type index() const {
+            return current_index;
+        }
+
+        ConstIterator& operator++() {
+            if (current_index >= parent->getSize()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            ++current_index;
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator result = *this;
+            operator++();
+            return result;
+        }
+
+        ConstIterator& operator--() {
+            if (current_index == 0) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            --current_index;
+            return *this;
+        }
+
+        ConstIterator operator--(int) {
+            ConstIterator result = *this;
+            operator--();
+            return result;
+        }
+
+        ConstIterator& operator+=(difference_type d) {
+            current_index += d;
+            return *this;
+        }
+
+        ConstIterator& operator-=(difference_type d) {
+            current_index -= d;
+            return *this;
+        }
+
+        ConstIterator operator+(difference_type d) const {
+            ConstIterator new_iter = *this;
+            new_iter += d;
+            return new_iter;
+        }
+
+        difference_type operator-(const ConstIterator& other) const {
+            return difference_type(current_index) - difference_type(other.current_index);
+        }
+
+        ConstIterator operator-(difference_type d) const {
+            ConstIterator new_iter = *this;
+            new_iter -= d;
+            return new_iter;
+        }
+
+        bool operator==(const ConstIterator& other) const {
+            return current_index == other.current_index;
+        }
+
+        bool operator!=(const ConstIterator& other) const {
+            return !(*this == other);
+        }
+
+        bool operator<(const ConstIterator& other) const {
+            return current_index < other.current_index;
+        }
+
+        bool operator>(const ConstIterator& other) const {
+            return other < *this;
+        }
+
+        bool operator<=(const ConstIterator& other) const {
+            return !(other < *this);
+        }
+
+        bool operator>=(const ConstIterator& other) const {
+            return !(*this < other);
+        }
+
+    protected:
+        size_type current_index;
+        const SegmentedVector<Type>* parent;
+    };
+
+    template <typename Type>
+    class SegmentedVector<Type>::Iterator : public SegmentedVector<Type>::ConstIterator {
+    public:
+        using pointer = typename SegmentedVector::pointer;
+        using reference = typename SegmentedVector::reference;
+
+        explicit Iterator(size_type idx, SegmentedVector<Type>& parent) : ConstIterator(idx, parent) {}
+
+        Iterator(const ConstIterator& other)
+                : ConstIterator(other) {}
+
+        Iterator& operator++() {
+            ConstIterator::operator++();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto result = *this;
+            ConstIterator::operator++();
+            return result;
+        }
+
+        Iterator& operator--() {
+            ConstIterator::operator--();
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            auto result = *this;
+            ConstIterator::operator--();
+            return result;
+        }
+
+        Iterator operator+(difference_type d) const {
+            return ConstIterator::operator+(d);
+        }
+
+        Iterator operator-(difference_type d) const {
+            return ConstIterator::operator-(d);
+        }
+
+        reference operator*() const {
+            // ugly cast, yet reduces code duplication.
+            return const_cast<reference>(ConstIterator::operator*());
+        }
+    };
+
+}
+
+#endif // AISDI_LINEAR_SEGMENTEDVECTOR_H
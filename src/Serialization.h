@@ -0,0 +1,321 @@
+#ifndef AISDI_LINEAR_SERIALIZATION_H
+#define AISDI_LINEAR_SERIALIZATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+#include <memory>
+
+namespace aisdi {
+
+    namespace detail {
+        class PayloadWriter;
+        class PayloadReader;
+    }
+
+    // Element encoding used by the containers' save/load. Trivially copyable types are stored
+    // as raw bytes (in native byte order), other types need a specialization.
+    template <typename Type, typename Enable = void>
+    struct Codec {
+        static_assert(sizeof(Type) == 0, "No aisdi::Codec specialization for this type");
+    };
+
+    template <typename Type>
+    struct Codec<Type, typename std::enable_if<std::is_trivially_copyable<Type>::value>::type> {
+        static void write(detail::PayloadWriter& writer, const Type& value);
+        static Type read(detail::PayloadReader& reader);
+    };
+
+    template <typename Char, typename Traits, typename Allocator>
+    struct Codec<std::basic_string<Char, Traits, Allocator>> {
+        static void write(detail::PayloadWriter& writer, const std::basic_string<Char, Traits, Allocator>& value);
+        static std::basic_string<Char, Traits, Allocator> read(detail::PayloadReader& reader);
+    };
+
+    namespace detail {
+
+        // Layout: header, payload split into length-prefixed frames, empty frame, FNV-1a checksum of the payload.
+        const std::uint32_t SERIALIZATION_MAGIC = 0x4c534941; // "AISL"
+        const std::uint16_t SERIALIZATION_VERSION = 1;
+        const std::uint16_t RAW_PAYLOAD_FLAG = 1;
+        const std::size_t FRAME_SIZE = 64 * 1024;
+
+        // FNV-1a applied to 64-bit words of the byte stream, independent of how the stream is split into calls.
+        class Checksum {
+        public:
+            Checksum() : state(0xcbf29ce484222325ULL), pending_bytes(0) {}
+
+            void update(const void* bytes, std::size_t count) {
+                const unsigned char* it = static_cast<const unsigned char*>(bytes);
+                while (count > 0 && pending_bytes != 0) {
+                    pushByte(*it++);
+                    --count;
+                }
+                for (; count >= sizeof(std::uint64_t); count -= sizeof(std::uint64_t), it += sizeof(std::uint64_t)) {
+                    std::uint64_t word;
+                    std::memcpy(&word, it, sizeof(word));
+                    mix(word);
+                }
+                while (count > 0) {
+                    pushByte(*it++);
+                    --count;
+                }
+            }
+
+            std::uint64_t value() const {
+                if (pending_bytes == 0) {
+                    return state;
+                }
+                std::uint64_t tail = 0;
+                std::memcpy(&tail, pending, pending_bytes);
+                return (state ^ tail ^ pending_bytes) * PRIME;
+            }
+
+        private:
+            static const std::uint64_t PRIME = 0x100000001b3ULL;
+
+            void mix(std::uint64_t word) {
+                state = (state ^ word) * PRIME;
+            }
+
+            void pushByte(unsigned char byte) {
+                pending[pending_bytes++] = byte;
+                if (pending_bytes == sizeof(std::uint64_t)) {
+                    std::uint64_t word;
+                    std::memcpy(&word, pending, sizeof(word));
+                    mix(word);
+                    pending_bytes = 0;
+                }
+            }
+
+            std::uint64_t state;
+            unsigned char pending[sizeof(std::uint64_t)];
+            unsigned pending_bytes;
+        };
+
+        template <typename Type>
+        struct IsRawSerializable : std::is_trivially_copyable<Type> {};
+
+        class PayloadWriter {
+        public:
+            PayloadWriter(std::ostream& out, std::uint64_t count, std::uint32_t elementSize, bool raw)
+                    : out(out), used(0), buffer(new char[FRAME_SIZE]) {
+                std::uint16_t flags = raw ? RAW_PAYLOAD_FLAG : 0;
+                std::uint32_t reserved = 0;
+                put(&SERIALIZATION_MAGIC, sizeof(SERIALIZATION_MAGIC));
+                put(&SERIALIZATION_VERSION, sizeof(SERIALIZATION_VERSION));
+                put(&flags, sizeof(flags));
+                put(&elementSize, sizeof(elementSize));
+                put(&reserved, sizeof(reserved));
+                put(&count, sizeof(count));
+            }
+
+            PayloadWriter(const PayloadWriter&) = delete;
+            PayloadWriter& operator=(const PayloadWriter&) = delete;
+
+            void write(const void* bytes, std::size_t count) {
+                checksum.update(bytes, count);
+                if (used + count <= FRAME_SIZE) {
+                    std::memcpy(buffer.get() + used, bytes, count);
+                    used += count;
+                    return;
+                }
+                flushFrame();
+                if (count >= FRAME_SIZE) {
+                    // large blocks (e.g. a whole trivially copyable buffer) skip the staging buffer
+                    writeFrame(bytes, count);
+                }
+                else {
+                    std::memcpy(buffer.get(), bytes, count);
+                    used = count;
+                }
+            }
+
+            void finish() {
+                flushFrame();
+                std::uint64_t terminator = 0;
+                std::uint64_t sum = checksum.value();
+                put(&terminator, sizeof(terminator));
+                put(&sum, sizeof(sum));
+                out.flush();
+                if (!out) {
+                    throw std::runtime_error("Cannot write serialized collection");
+                }
+            }
+
+        private:
+            void put(const void* bytes, std::size_t count) {
+                if (!out.write(static_cast<const char*>(bytes), count)) {
+                    throw std::runtime_error("Cannot write serialized collection");
+                }
+            }
+
+            void writeFrame(const void* bytes, std::uint64_t count) {
+                put(&count, sizeof(count));
+                put(bytes, count);
+            }
+
+            void flushFrame() {
+                if (used > 0) {
+                    writeFrame(buffer.get(), used);
+                    used = 0;
+                }
+            }
+
+            std::ostream& out;
+            Checksum checksum;
+            std::size_t used;
+            std::unique_ptr<char[]> buffer;
+        };
+
+        class PayloadReader {
+        public:
+            explicit PayloadReader(std::istream& in) : in(in), frame_left(0) {
+                std::uint32_t magic;
+                std::uint16_t version;
+                std::uint32_t reserved;
+                get(&magic, sizeof(magic));
+                get(&version, sizeof(version));
+                get(&flags, sizeof(flags));
+                get(&element_size, sizeof(element_size));
+                get(&reserved, sizeof(reserved));
+                get(&element_count, sizeof(element_count));
+                if (magic != SERIALIZATION_MAGIC || version != SERIALIZATION_VERSION) {
+                    throw std::runtime_error("Not a serialized collection of a supported version");
+                }
+            }
+
+            PayloadReader(const PayloadReader&) = delete;
+            PayloadReader& operator=(const PayloadReader&) = delete;
+
+            std::uint64_t count() const {
+                return element_count;
+            }
+
+            // How many of count() elements may be allocated before reading them: no more than the rest of the
+            // stream can hold, so a corrupt count fails as truncated data instead of a huge allocation. Streams
+            // that cannot seek are trusted for one frame at a time.
+            std::uint64_t reservableCount(std::size_t elementBytes) const {
+                std::uint64_t available = FRAME_SIZE;
+                std::istream::pos_type here = in.tellg();
+                if (here != std::istream::pos_type(-1)) {
+                    in.seekg(0, std::ios_base::end);
+                    std::istream::pos_type last = in.tellg();
+                    in.seekg(here);
+                    if (last != std::istream::pos_type(-1) && last >= here) {
+                        available = std::uint64_t(last - here);
+                    }
+                }
+                in.clear();
+                return std::min<std::uint64_t>(element_count, available / std::max<std::size_t>(elementBytes, 1));
+            }
+
+            template <typename Type>
+            void expectElements() const {
+                bool raw = (flags & RAW_PAYLOAD_FLAG) != 0;
+                if (raw != IsRawSerializable<Type>::value || (raw && element_size != sizeof(Type))) {
+                    throw std::runtime_error("Serialized element type does not match");
+                }
+            }
+
+            void read(void* bytes, std::size_t count) {
+                char* it = static_cast<char*>(bytes);
+                while (count > 0) {
+                    if (frame_left == 0) {
+                        get(&frame_left, sizeof(frame_left));
+                        if (frame_left == 0) {
+                            throw std::runtime_error("Serialized collection is truncated");
+                        }
+                    }
+                    std::size_t part = std::min<std::uint64_t>(count, frame_left);
+                    get(it, part);
+                    checksum.update(it, part);
+                    frame_left -= part;
+                    it += part;
+                    count -= part;
+                }
+            }
+
+            void finish() {
+                std::uint64_t terminator;
+                std::uint64_t sum;
+                if (frame_left != 0) {
+                    throw std::runtime_error("Serialized collection has trailing data");
+                }
+                get(&terminator, sizeof(terminator));
+                get(&sum, sizeof(sum));
+                if (terminator != 0) {
+                    throw std::runtime_error("Serialized collection has trailing data");
+                }
+                if (sum != checksum.value()) {
+                    throw std::runtime_error("Serialized collection checksum mismatch");
+                }
+            }
+
+        private:
+            void get(void* bytes, std::size_t count) {
+                if (!in.read(static_cast<char*>(bytes), count)) {
+                    throw std::runtime_error("Serialized collection is truncated");
+                }
+            }
+
+            std::istream& in;
+            Checksum checksum;
+            std::uint16_t flags;
+            std::uint32_t element_size;
+            std::uint64_t element_count;
+            std::uint64_t frame_left;
+        };
+
+    }
+
+    template <typename Type>
+    void Codec<Type, typename std::enable_if<std::is_trivially_copyable<Type>::value>::type>::write(
+            detail::PayloadWriter& writer, const Type& value) {
+        writer.write(&value, sizeof(Type));
+    }
+
+    template <typename Type>
+    Type Codec<Type, typename std::enable_if<std::is_trivially_copyable<Type>::value>::type>::read(
+            detail::PayloadReader& reader) {
+        Type value;
+        reader.read(&value, sizeof(Type));
+        return value;
+    }
+
+    template <typename Char, typename Traits, typename Allocator>
+    void Codec<std::basic_string<Char, Traits, Allocator>>::write(
+            detail::PayloadWriter& writer, const std::basic_string<Char, Traits, Allocator>& value) {
+        std::uint64_t length = value.size();
+        writer.write(&length, sizeof(length));
+        writer.write(value.data(), length * sizeof(Char));
+    }
+
+    template <typename Char, typename Traits, typename Allocator>
+    std::basic_string<Char, Traits, Allocator> Codec<std::basic_string<Char, Traits, Allocator>>::read(
+            detail::PayloadReader& reader) {
+        std::uint64_t length;
+        reader.read(&length, sizeof(length));
+        std::basic_string<Char, Traits, Allocator> value;
+        if (length > value.max_size()) {
+            throw std::runtime_error("Serialized collection is too large");
+        }
+        // grown as the characters arrive, a corrupt length must not allocate up front
+        const std::uint64_t chunk = detail::FRAME_SIZE / sizeof(Char);
+        for (std::uint64_t done = 0; done < length; done = value.size()) {
+            value.resize(done + std::min(length - done, chunk));
+            reader.read(&value[done], (value.size() - done) * sizeof(Char));
+        }
+        return value;
+    }
+
+}
+
+#endif // AISDI_LINEAR_SERIALIZATION_H
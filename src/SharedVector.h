@@ -0,0 +1,505 @@
+#ifndef AISDI_LINEAR_SHAREDVECTOR_H
+#define AISDI_LINEAR_SHAREDVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <new>
+#include <atomic>
+#include <string>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ContiguousIterator.h"
+#include "OffsetPtr.h"
+#include "Span.h"
+
+namespace aisdi {
+
+    // Linux only. Vector living in a POSIX shared memory segment, every process opening the same name
+    // sees the same elements without copying them. Modifications take a process-shared writer lock,
+    // element access should happen under a ReadLock, which also picks up growth done by other processes.
+    // Threads sharing one SharedVector read through ReadLock::view(); the unlocked accessors are meant for
+    // a single thread and only reach the part of the segment this process has mapped so far.
+    // A moved-from SharedVector reads as empty, with no data and version 0; locking or modifying it throws.
+    template <typename Type>
+    class SharedVector {
+        static_assert(std::is_trivially_copyable<Type>::value, "SharedVector requires trivially copyable type");
+
+    public:
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = Type;
+        using pointer = Type*;
+        using reference = Type&;
+        using const_pointer = const Type*;
+        using const_reference = const Type&;
+
+        using iterator = ContiguousIterator<SharedVector>;
+        using const_iterator = ContiguousConstIterator<SharedVector>;
+
+        static const std::uint32_t FORMAT_VERSION = 1;
+
+        // Shared lock for zero-copy reading, the elements do not change while it is held.
+        class ReadLock {
+        public:
+            explicit ReadLock(const SharedVector& vector) : vector(&vector) {
+                vector.lock(false);
+            }
+
+            ReadLock(const ReadLock&) = delete;
+            ReadLock& operator=(const ReadLock&) = delete;
+
+            ~ReadLock() {
+                vector->unlock();
+            }
+
+            Span<const Type> view() const {
+                return Span<const Type>(vector->data(), vector->getSize());
+            }
+
+        private:
+            const SharedVector* vector;
+        };
+
+        // Creates the segment or attaches to an existing one, initialCapacity is used only when creating.
+        explicit SharedVector(const std::string& name, size_type initialCapacity = 1024)
+                : file(-1), header(nullptr), mapped_bytes(0) {
+            file = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+            bool created = file >= 0;
+            if (!created && errno == EEXIST) {
+                file = shm_open(name.c_str(), O_RDWR, 0644);
+            }
+            if (file < 0) {
+                throw std::system_error(errno, std::generic_category(), "Cannot open shared memory " + name);
+            }
+            try {
+                if (created) {
+                    create(std::max<size_type>(initialCapacity, 1));
+                }
+                else {
+                    attach();
+                }
+            }
+            catch (...) {
+                close();
+                throw;
+            }
+        }
+
+        SharedVector(const SharedVector&) = delete;
+        SharedVector& operator=(const SharedVector&) = delete;
+
+        SharedVector(SharedVector&& other)
+                : file(other.file), header(other.segment()), mapped_bytes(other.mappedBytes()),
+                  retired(std::move(other.retired)) {
+            other.file = -1;
+            other.header = nullptr;
+            other.mapped_bytes = 0;
+            other.retired.clear();
+        }
+
+        SharedVector& operator=(SharedVector&& other) {
+            if (this == &other) {
+                return *this;
+            }
+            close();
+            file = other.file;
+            header = other.segment();
+            mapped_bytes = other.mappedBytes();
+            retired = std::move(other.retired);
+            other.file = -1;
+            other.header = nullptr;
+            other.mapped_bytes = 0;
+            other.retired.clear();
+            return *this;
+        }
+
+        // Unmaps the segment, which stays available to other processes until remove() is called.
+        ~SharedVector() {
+            close();
+        }
+
+        // Deletes the name, mappings which are already open keep working.
+        static void remove(const std::string& name) {
+            if (shm_unlink(name.c_str()) != 0 && errno != ENOENT) {
+                throw std::system_error(errno, std::generic_category(), "Cannot remove shared memory " + name);
+            }
+        }
+
+        bool isEmpty() const {
+            return getSize() == 0;
+        }
+
+        // Elements appended by other processes past the local mapping show up once a lock has been taken.
+        size_type getSize() const {
+            size_type bytes = mappedBytes();
+            const Header* current = segment();
+            if (current == nullptr) {
+                return 0;
+            }
+            size_type visible = (bytes - HEADER_SIZE) / sizeof(Type);
+            return std::min<size_type>(current->size.load(std::memory_order_acquire), visible);
+        }
+
+        size_type getCapacity() const {
+            if (segment() == nullptr) {
+                return 0;
+            }
+            ReadLock guard(*this);
+            return segment()->capacity;
+        }
+
+        // Incremented by every modification, readers can use it to notice changes without locking.
+        std::uint64_t getVersion() const {
+            const Header* current = segment();
+            return current != nullptr ? current->version.load(std::memory_order_acquire) : 0;
+        }
+
+        pointer data() {
+            Header* current = segment();
+            return current != nullptr ? current->elements.get() : nullptr;
+        }
+
+        const_pointer data() const {
+            const Header* current = segment();
+            return current != nullptr ? current->elements.get() : nullptr;
+        }
+
+        reference operator[](size_type index) {
+            return data()[index];
+        }
+
+        const_reference operator[](size_type index) const {
+            return data()[index];
+        }
+
+        void reserve(size_type capacity) {
+            WriteGuard guard(*this);
+            grow(capacity);
+        }
+
+        void append(const Type& item) {
+            append(&item, 1);
+        }
+
+        // Bulk load under a single lock.
+        void append(const_pointer items, size_type count) {
+            WriteGuard guard(*this);
+            size_type size = getSize();
+            grow(size + count);
+            std::memmove(data() + size, items, count * sizeof(Type));
+            publish(size + count);
+        }
+
+        void prepend(const Type& item) {
+            insert(begin(), item);
+        }
+
+        void insert(const const_iterator& insertPosition, const Type& item) {
+            size_type index = insertPosition - cbegin();
+            Type copy = item;
+            WriteGuard guard(*this);
+            size_type size = getSize();
+            if (index > size) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            grow(size + 1);
+            std::memmove(data() + index + 1, data() + index, (size - index) * sizeof(Type));
+            data()[index] = copy;
+            publish(size + 1);
+        }
+
+        Type popFirst() {
+            WriteGuard guard(*this);
+            size_type size = getSize();
+            if (size == 0) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            Type val = data()[0];
+            std::memmove(data(), data() + 1, (size - 1) * sizeof(Type));
+            publish(size - 1);
+            return val;
+        }
+
+        Type popLast() {
+            WriteGuard guard(*this);
+            size_type size = getSize();
+            if (size == 0) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            Type val = data()[size - 1];
+            publish(size - 1);
+            return val;
+        }
+
+        void erase(const const_iterator& position) {
+            erase(position, position + 1);
+        }
+
+        void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded) {
+            size_type first = firstIncluded - cbegin();
+            size_type last = lastExcluded - cbegin();
+            WriteGuard guard(*this);
+            size_type size = getSize();
+            if (first > last || last > size) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            std::memmove(data() + first, data() + last, (size - last) * sizeof(Type));
+            publish(size - (last - first));
+        }
+
+        iterator begin() {
+            return iterator(data(), *this);
+        }
+
+        iterator end() {
+            return iterator(data() + getSize(), *this);
+        }
+
+        const_iterator cbegin() const {
+            return const_iterator(data(), *this);
+        }
+
+        const_iterator cend() const {
+            return const_iterator(data() + getSize(), *this);
+        }
+
+        const_iterator begin() const {
+            return cbegin();
+        }
+
+        const_iterator end() const {
+            return cend();
+        }
+
+    private:
+        static const std::uint64_t MAGIC = 0x524f544345564853ULL; // "SHVECTOR"
+        static const int ATTACH_ATTEMPTS = 1000;
+
+        static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "SharedVector needs lock-free 64 bit atomics");
+
+        struct Header {
+            std::atomic<std::uint64_t> magic;
+            std::uint32_t version_format;
+            std::uint32_t element_size;
+            std::atomic<std::uint64_t> size;
+            std::atomic<std::uint64_t> version;
+            std::uint64_t capacity;
+            OffsetPtr<Type> elements;
+            pthread_rwlock_t lock;
+        };
+
+        static const size_type HEADER_SIZE = (sizeof(Header) + 63) / 64 * 64;
+
+        static_assert(HEADER_SIZE % alignof(Type) == 0, "Type is over-aligned for SharedVector");
+
+        class WriteGuard {
+        public:
+            explicit WriteGuard(SharedVector& vector) : vector(&vector) {
+                vector.lock(true);
+            }
+
+            WriteGuard(const WriteGuard&) = delete;
+            WriteGuard& operator=(const WriteGuard&) = delete;
+
+            ~WriteGuard() {
+                vector->unlock();
+            }
+
+        private:
+            SharedVector* vector;
+        };
+
+        static size_type bytesFor(size_type capacity) {
+            return HEADER_SIZE + capacity * sizeof(Type);
+        }
+
+        void create(size_type capacity) {
+            resizeSegment(bytesFor(capacity));
+            map(bytesFor(capacity));
+            Header* fresh = new (segment()) Header();
+            fresh->version_format = FORMAT_VERSION;
+            fresh->element_size = sizeof(Type);
+            fresh->capacity = capacity;
+            fresh->elements = reinterpret_cast<pointer>(reinterpret_cast<char*>(fresh) + HEADER_SIZE);
+
+            pthread_rwlockattr_t attributes;
+            pthread_rwlockattr_init(&attributes);
+            pthread_rwlockattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+            int error = pthread_rwlock_init(&fresh->lock, &attributes);
+            pthread_rwlockattr_destroy(&attributes);
+            if (error != 0) {
+                throw std::system_error(error, std::generic_category(), "pthread_rwlock_init failed");
+            }
+            // processes attaching concurrently wait for the magic, so it goes last
+            fresh->magic.store(MAGIC, std::memory_order_release);
+        }
+
+        void attach() {
+            for (int attempt = 0; attempt < ATTACH_ATTEMPTS; ++attempt) {
+                struct stat status;
+                if (fstat(file, &status) != 0) {
+                    throw std::system_error(errno, std::generic_category(), "Cannot stat shared memory");
+                }
+                if (status.st_size >= static_cast<off_t>(HEADER_SIZE)) {
+                    if (segment() == nullptr) {
+                        map(status.st_size);
+                    }
+                    if (segment()->magic.load(std::memory_order_acquire) == MAGIC) {
+                        validate();
+                        return;
+                    }
+                }
+                usleep(1000);
+            }
+            throw std::runtime_error("Shared memory is not a SharedVector");
+        }
+
+        void validate() {
+            if (segment()->version_format != FORMAT_VERSION) {
+                throw std::runtime_error("Shared memory holds a SharedVector of an unsupported version");
+            }
+            if (segment()->element_size != sizeof(Type)) {
+                throw std::runtime_error("SharedVector element size mismatch");
+            }
+            ReadLock guard(*this);
+            if (segment()->size > segment()->capacity) {
+                throw std::runtime_error("SharedVector is corrupted");
+            }
+        }
+
+        void map(size_type bytes) {
+            void* address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+            if (address == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "mmap failed");
+            }
+            header.store(static_cast<Header*>(address), std::memory_order_release);
+            mapped_bytes.store(bytes, std::memory_order_release);
+        }
+
+        Header* segment() const {
+            return header.load(std::memory_order_acquire);
+        }
+
+        size_type mappedBytes() const {
+            return mapped_bytes.load(std::memory_order_acquire);
+        }
+
+        // Grows the local mapping to what another process may have added, the lock has to be held.
+        void followSegment() const {
+            remap(bytesFor(segment()->capacity));
+        }
+
+        // Several threads may follow the segment under read locks, so they take turns here. A mapping which
+        // cannot grow in place is kept until close(), other threads may still be using its addresses; the
+        // header goes out before mapped_bytes, so whoever sees the new size also sees the new mapping.
+        void remap(size_type bytes) const {
+            std::lock_guard<std::mutex> guard(remapping);
+            size_type current = mappedBytes();
+            if (bytes <= current) {
+                return;
+            }
+            Header* old = segment();
+            if (mremap(old, current, bytes, 0) == MAP_FAILED) {
+                void* address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+                if (address == MAP_FAILED) {
+                    throw std::system_error(errno, std::generic_category(), "mmap failed");
+                }
+                try {
+                    retired.push_back(std::make_pair(old, current));
+                }
+                catch (...) {
+                    munmap(address, bytes);
+                    throw;
+                }
+                header.store(static_cast<Header*>(address), std::memory_order_release);
+            }
+            mapped_bytes.store(bytes, std::memory_order_release);
+        }
+
+        void lock(bool exclusive) const {
+            if (segment() == nullptr) {
+                throw std::logic_error("SharedVector was moved from");
+            }
+            pthread_rwlock_t* shared = &segment()->lock;
+            int error = exclusive ? pthread_rwlock_wrlock(shared) : pthread_rwlock_rdlock(shared);
+            if (error != 0) {
+                throw std::system_error(error, std::generic_category(), "Cannot lock SharedVector");
+            }
+            try {
+                followSegment();
+            }
+            catch (...) {
+                unlock();
+                throw;
+            }
+        }
+
+        void unlock() const {
+            pthread_rwlock_unlock(&segment()->lock);
+        }
+
+        // Write lock has to be held.
+        void grow(size_type count) {
+            if (count <= segment()->capacity) {
+                return;
+            }
+            size_type capacity = std::max(count, size_type(segment()->capacity * 2));
+            size_type bytes = bytesFor(capacity);
+            resizeSegment(bytes);
+            remap(bytes);
+            segment()->capacity = capacity;
+        }
+
+        // Write lock has to be held.
+        void publish(size_type size) {
+            segment()->size.store(size, std::memory_order_release);
+            segment()->version.fetch_add(1, std::memory_order_release);
+        }
+
+        void resizeSegment(size_type bytes) {
+            if (ftruncate(file, bytes) != 0) {
+                throw std::system_error(errno, std::generic_category(), "ftruncate failed");
+            }
+        }
+
+        void close() {
+            if (segment() != nullptr) {
+                munmap(segment(), mappedBytes());
+                header = nullptr;
+                mapped_bytes = 0;
+            }
+            for (const auto& mapping : retired) {
+                munmap(mapping.first, mapping.second);
+            }
+            retired.clear();
+            if (file >= 0) {
+                ::close(file);
+                file = -1;
+            }
+        }
+
+        int file;
+        // the mapping follows growth of the segment from const readers as well
+        mutable std::atomic<Header*> header;
+        mutable std::atomic<size_type> mapped_bytes;
+        mutable std::mutex remapping;
+        mutable std::vector<std::pair<Header*, size_type>> retired;
+    };
+
+}
+
+#endif // AISDI_LINEAR_SHAREDVECTOR_H
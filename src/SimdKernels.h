@@ -0,0 +1,456 @@
+#ifndef AISDI_LINEAR_SIMDKERNELS_H
+#define AISDI_LINEAR_SIMDKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <algorithm>
+
+// Kernels are written with GCC vector extensions: the 16 byte instantiation is plain SSE2 on x86-64,
+// the 32 byte one is compiled for AVX2 and picked at runtime when the CPU supports it.
+#if defined(__GNUC__)
+#define AISDI_SIMD 1
+#define AISDI_SIMD_INLINE inline __attribute__((always_inline))
+#if defined(__x86_64__)
+#define AISDI_SIMD_AVX2 1
+#endif
+#endif
+
+namespace aisdi {
+
+    namespace detail {
+
+        namespace simd {
+
+            // Types with 32 or 64 bit lanes go through the vector kernels, everything else is scanned element by element.
+            template <typename Type>
+            struct IsVectorizable : std::integral_constant<bool, std::is_arithmetic<Type>::value
+                    && !std::is_same<Type, bool>::value && (sizeof(Type) == 4 || sizeof(Type) == 8)> {};
+
+            // Types whose equality is equality of their bytes, so whole buffers can be compared with memcmp.
+            template <typename Type>
+            struct IsBitwiseComparable : std::integral_constant<bool, std::is_integral<Type>::value
+                    || std::is_enum<Type>::value || std::is_pointer<Type>::value> {};
+
+            // Integers are summed in 64 bits (wrapping on overflow), floating point values in at least double precision.
+            template <typename Type, bool Arithmetic = std::is_arithmetic<Type>::value>
+            struct SumType {
+                using type = Type;
+            };
+
+            template <typename Type>
+            struct SumType<Type, true> {
+                using type = typename std::conditional<std::is_floating_point<Type>::value,
+                        typename std::common_type<Type, double>::type,
+                        typename std::conditional<std::is_signed<Type>::value, long long, unsigned long long>::type>::type;
+                using accumulator = typename std::conditional<std::is_floating_point<Type>::value,
+                        type, unsigned long long>::type;
+            };
+
+            // Starting value for the min/max scans, chosen so that NaNs never replace it.
+            template <typename Type, bool Max>
+            Type extremeSeed() {
+                if (std::numeric_limits<Type>::has_infinity) {
+                    return Max ? -std::numeric_limits<Type>::infinity() : std::numeric_limits<Type>::infinity();
+                }
+                return Max ? std::numeric_limits<Type>::lowest() : std::numeric_limits<Type>::max();
+            }
+
+            template <typename Type, bool Max>
+            Type better(Type candidate, Type best) {
+                return (Max ? candidate > best : candidate < best) ? candidate : best;
+            }
+
+            struct Find {
+                template <typename Type>
+                static std::size_t scalar(const Type* data, std::size_t first, std::size_t size, Type value) {
+                    for (std::size_t i = first; i < size; ++i) {
+                        if (data[i] == value) {
+                            return i;
+                        }
+                    }
+                    return size;
+                }
+
+#if defined(AISDI_SIMD)
+                template <std::size_t Bytes, typename Type>
+                static AISDI_SIMD_INLINE std::size_t run(const Type* data, std::size_t size, Type value);
+#endif
+            };
+
+            struct Mismatch {
+                template <typename Type>
+                static std::size_t scalar(const Type* data, std::size_t first, std::size_t size, const Type* other) {
+                    for (std::size_t i = first; i < size; ++i) {
+                        if (!(data[i] == other[i])) {
+                            return i;
+                        }
+                    }
+                    return size;
+                }
+
+#if defined(AISDI_SIMD)
+                template <std::size_t Bytes, typename Type>
+                static AISDI_SIMD_INLINE std::size_t run(const Type* data, std::size_t size, const Type* other);
+#endif
+            };
+
+            struct Count {
+                template <typename Type>
+                static std::size_t scalar(const Type* data, std::size_t first, std::size_t size, Type value) {
+                    std::size_t total = 0;
+                    for (std::size_t i = first; i < size; ++i) {
+                        total += data[i] == value ? 1 : 0;
+                    }
+                    return total;
+                }
+
+#if defined(AISDI_SIMD)
+                template <std::size_t Bytes, typename Type>
+                static AISDI_SIMD_INLINE std::size_t run(const Type* data, std::size_t size, Type value);
+#endif
+            };
+
+            struct FindAny {
+                template <typename Type>
+                static std::size_t scalar(const Type* data, std::size_t first, std::size_t size,
+                                          const Type* values, std::size_t valueCount) {
+                    for (std::size_t i = first; i < size; ++i) {
+                        for (std::size_t j = 0; j < valueCount; ++j) {
+                            if (data[i] == values[j]) {
+                                return i;
+                            }
+                        }
+                    }
+                    return size;
+                }
+
+#if defined(AISDI_SIMD)
+                template <std::size_t Bytes, typename Type>
+                static AISDI_SIMD_INLINE std::size_t run(const Type* data, std::size_t size,
+                                                         const Type* values, std::size_t valueCount);
+#endif
+            };
+
+            template <bool Max>
+            struct Extreme {
+                template <typename Type>
+                static Type scalar(const Type* data, std::size_t first, std::size_t size) {
+                    Type best = extremeSeed<Type, Max>();
+                    for (std::size_t i = first; i < size; ++i) {
+                        best = better<Type, Max>(data[i], best);
+                    }
+                    return best;
+                }
+
+#if defined(AISDI_SIMD)
+                template <std::size_t Bytes, typename Type>
+                static AISDI_SIMD_INLINE Type run(const Type* data, std::size_t size);
+#endif
+            };
+
+            struct Sum {
+                template <typename Type>
+                static typename SumType<Type>::accumulator scalar(const Type* data, std::size_t first, std::size_t size) {
+                    typename SumType<Type>::accumulator total = 0;
+                    for (std::size_t i = first; i < size; ++i) {
+                        total += static_cast<typename SumType<Type>::accumulator>(data[i]);
+                    }
+                    return total;
+                }
+
+#if defined(AISDI_SIMD)
+                template <std::size_t Bytes, typename Type>
+                static AISDI_SIMD_INLINE typename SumType<Type>::accumulator run(const Type* data, std::size_t size);
+#endif
+            };
+
+#if defined(AISDI_SIMD)
+            template <typename Type, std::size_t Bytes>
+            struct Lanes {
+                typedef Type type __attribute__((vector_size(Bytes)));
+                static const std::size_t COUNT = Bytes / sizeof(Type);
+            };
+
+            template <typename Vec, typename Type>
+            AISDI_SIMD_INLINE void splat(Vec& out, Type value) {
+                for (std::size_t i = 0; i < sizeof(Vec) / sizeof(Type); ++i) {
+                    out[i] = value;
+                }
+            }
+
+            template <typename Mask>
+            AISDI_SIMD_INLINE bool anyLane(const Mask& mask) {
+                std::uint64_t words[sizeof(Mask) / sizeof(std::uint64_t)];
+                std::memcpy(words, &mask, sizeof(words));
+                std::uint64_t any = 0;
+                for (std::size_t i = 0; i < sizeof(Mask) / sizeof(std::uint64_t); ++i) {
+                    any |= words[i];
+                }
+                return any != 0;
+            }
+
+            template <std::size_t Bytes, typename Type>
+            std::size_t Find::run(const Type* data, std::size_t size, Type value) {
+                typedef typename Lanes<Type, Bytes>::type Vec;
+                const std::size_t width = Lanes<Type, Bytes>::COUNT;
+                Vec needle;
+                splat(needle, value);
+                std::size_t i = 0;
+                for (; i + width <= size; i += width) {
+                    Vec chunk;
+                    std::memcpy(&chunk, data + i, sizeof(chunk));
+                    if (anyLane(chunk == needle)) {
+                        break;
+                    }
+                }
+                // the exact position within the matching chunk (or the tail) is found by the scalar loop
+                return scalar(data, i, size, value);
+            }
+
+            template <std::size_t Bytes, typename Type>
+            std::size_t Mismatch::run(const Type* data, std::size_t size, const Type* other) {
+                typedef typename Lanes<Type, Bytes>::type Vec;
+                const std::size_t width = Lanes<Type, Bytes>::COUNT;
+                std::size_t i = 0;
+                for (; i + width <= size; i += width) {
+                    Vec chunk;
+                    Vec otherChunk;
+                    std::memcpy(&chunk, data + i, sizeof(chunk));
+                    std::memcpy(&otherChunk, other + i, sizeof(otherChunk));
+                    if (anyLane(chunk != otherChunk)) {
+                        break;
+                    }
+                }
+                return scalar(data, i, size, other);
+            }
+
+            template <std::size_t Bytes, typename Type>
+            std::size_t Count::run(const Type* data, std::size_t size, Type value) {
+                typedef typename Lanes<Type, Bytes>::type Vec;
+                typedef decltype(Vec() == Vec()) Mask;
+                const std::size_t width = Lanes<Type, Bytes>::COUNT;
+                // lane counters are flushed before they could overflow a 32 bit lane
+                const std::size_t flushEvery = std::size_t(1) << 30;
+                Vec needle;
+                splat(needle, value);
+                std::size_t total = 0;
+                std::size_t i = 0;
+                while (i + width <= size) {
+                    Mask counters = Mask();
+                    for (std::size_t steps = 0; steps < flushEvery && i + width <= size; ++steps, i += width) {
+                        Vec chunk;
+                        std::memcpy(&chunk, data + i, sizeof(chunk));
+                        counters -= chunk == needle;
+                    }
+                    for (std::size_t lane = 0; lane < width; ++lane) {
+                        total += counters[lane];
+                    }
+                }
+                return total + scalar(data, i, size, value);
+            }
+
+            template <std::size_t Bytes, typename Type>
+            std::size_t FindAny::run(const Type* data, std::size_t size, const Type* values, std::size_t valueCount) {
+                typedef typename Lanes<Type, Bytes>::type Vec;
+                const std::size_t width = Lanes<Type, Bytes>::COUNT;
+                if (valueCount == 0) {
+                    return size;
+                }
+                std::size_t i = 0;
+                for (; i + width <= size; i += width) {
+                    Vec chunk;
+                    Vec needle;
+                    std::memcpy(&chunk, data + i, sizeof(chunk));
+                    splat(needle, values[0]);
+                    auto matches = chunk == needle;
+                    for (std::size_t j = 1; j < valueCount; ++j) {
+                        splat(needle, values[j]);
+                        matches |= chunk == needle;
+                    }
+                    if (anyLane(matches)) {
+                        break;
+                    }
+                }
+                return scalar(data, i, size, values, valueCount);
+            }
+
+            template <bool Max>
+            template <std::size_t Bytes, typename Type>
+            Type Extreme<Max>::run(const Type* data, std::size_t size) {
+                typedef typename Lanes<Type, Bytes>::type Vec;
+                const std::size_t width = Lanes<Type, Bytes>::COUNT;
+                Vec best;
+                splat(best, extremeSeed<Type, Max>());
+                std::size_t i = 0;
+                for (; i + width <= size; i += width) {
+                    Vec chunk;
+                    std::memcpy(&chunk, data + i, sizeof(chunk));
+                    best = (Max ? chunk > best : chunk < best) ? chunk : best;
+                }
+                Type result = scalar(data, i, size);
+                for (std::size_t lane = 0; lane < width; ++lane) {
+                    result = better<Type, Max>(best[lane], result);
+                }
+                return result;
+            }
+
+            template <std::size_t Bytes, typename Type>
+            typename SumType<Type>::accumulator Sum::run(const Type* data, std::size_t size) {
+                typedef typename SumType<Type>::accumulator Accumulator;
+                typedef typename Lanes<Type, Bytes>::type Vec;
+                const std::size_t width = Lanes<Type, Bytes>::COUNT;
+                typedef Accumulator Wide __attribute__((vector_size(width * sizeof(Accumulator))));
+                Wide totals = Wide();
+                std::size_t i = 0;
+                for (; i + width <= size; i += width) {
+                    Vec chunk;
+                    std::memcpy(&chunk, data + i, sizeof(chunk));
+                    totals += __builtin_convertvector(chunk, Wide);
+                }
+                Accumulator result = scalar(data, i, size);
+                for (std::size_t lane = 0; lane < width; ++lane) {
+                    result += totals[lane];
+                }
+                return result;
+            }
+#endif
+
+#if defined(AISDI_SIMD_AVX2)
+            inline bool hasAvx2() {
+                static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+                return supported;
+            }
+
+            template <typename Op, typename... Args>
+            __attribute__((target("avx2"))) auto runAvx2(Args... args) -> decltype(Op::template run<32>(args...)) {
+                return Op::template run<32>(args...);
+            }
+#endif
+
+            template <typename Op, typename Type, typename... Args>
+            auto dispatch(const Type* data, std::size_t size, Args... args)
+                    -> decltype(Op::scalar(data, 0, size, args...)) {
+#if defined(AISDI_SIMD_AVX2)
+                if (hasAvx2()) {
+                    return runAvx2<Op>(data, size, args...);
+                }
+#endif
+#if defined(AISDI_SIMD)
+                return Op::template run<16>(data, size, args...);
+#else
+                return Op::scalar(data, 0, size, args...);
+#endif
+            }
+
+            template <typename Type>
+            std::size_t find(const Type* data, std::size_t size, const Type& value, std::true_type) {
+                return dispatch<Find>(data, size, value);
+            }
+
+            template <typename Type>
+            std::size_t find(const Type* data, std::size_t size, const Type& value, std::false_type) {
+                return std::find(data, data + size, value) - data;
+            }
+
+            template <typename Type>
+            std::size_t firstMismatch(const Type* lhs, const Type* rhs, std::size_t size, std::true_type) {
+                return dispatch<Mismatch>(lhs, size, rhs);
+            }
+
+            template <typename Type>
+            std::size_t firstMismatch(const Type* lhs, const Type* rhs, std::size_t size, std::false_type) {
+                return std::mismatch(lhs, lhs + size, rhs).first - lhs;
+            }
+
+            template <typename Type>
+            bool equal(const Type* lhs, const Type* rhs, std::size_t size, std::true_type) {
+                return size == 0 || std::memcmp(lhs, rhs, size * sizeof(Type)) == 0;
+            }
+
+            template <typename Type>
+            bool equal(const Type* lhs, const Type* rhs, std::size_t size, std::false_type) {
+                return firstMismatch(lhs, rhs, size, IsVectorizable<Type>()) == size;
+            }
+
+            template <typename Type>
+            bool lexicographicalLess(const Type* lhs, std::size_t lhsSize, const Type* rhs, std::size_t rhsSize,
+                                     std::true_type) {
+                const std::size_t common = std::min(lhsSize, rhsSize);
+                // elements that are neither equal nor ordered (NaN) do not decide the order
+                for (std::size_t i = firstMismatch(lhs, rhs, common, std::true_type()); i < common;
+                     i += 1 + firstMismatch(lhs + i + 1, rhs + i + 1, common - i - 1, std::true_type())) {
+                    if (lhs[i] < rhs[i]) {
+                        return true;
+                    }
+                    if (rhs[i] < lhs[i]) {
+                        return false;
+                    }
+                }
+                return lhsSize < rhsSize;
+            }
+
+            template <typename Type>
+            bool lexicographicalLess(const Type* lhs, std::size_t lhsSize, const Type* rhs, std::size_t rhsSize,
+                                     std::false_type) {
+                return std::lexicographical_compare(lhs, lhs + lhsSize, rhs, rhs + rhsSize);
+            }
+
+            template <typename Type>
+            std::size_t count(const Type* data, std::size_t size, const Type& value, std::true_type) {
+                return dispatch<Count>(data, size, value);
+            }
+
+            template <typename Type>
+            std::size_t count(const Type* data, std::size_t size, const Type& value, std::false_type) {
+                return std::count(data, data + size, value);
+            }
+
+            template <typename Type>
+            std::size_t findAny(const Type* data, std::size_t size, const Type* values, std::size_t valueCount,
+                                std::true_type) {
+                return dispatch<FindAny>(data, size, values, valueCount);
+            }
+
+            template <typename Type>
+            std::size_t findAny(const Type* data, std::size_t size, const Type* values, std::size_t valueCount,
+                                std::false_type) {
+                return FindAny::scalar(data, 0, size, values, valueCount);
+            }
+
+            // Position of the first smallest (Max = false) or largest value, NaNs are skipped.
+            template <bool Max, typename Type>
+            std::size_t extremeIndex(const Type* data, std::size_t size, std::true_type) {
+                std::size_t index = find(data, size, dispatch<Extreme<Max>>(data, size), std::true_type());
+                // only NaNs
+                return index == size ? 0 : index;
+            }
+
+            template <bool Max, typename Type>
+            std::size_t extremeIndex(const Type* data, std::size_t size, std::false_type) {
+                return (Max ? std::max_element(data, data + size) : std::min_element(data, data + size)) - data;
+            }
+
+            template <typename Type>
+            typename SumType<Type>::type sum(const Type* data, std::size_t size, std::true_type) {
+                return static_cast<typename SumType<Type>::type>(dispatch<Sum>(data, size));
+            }
+
+            template <typename Type>
+            typename SumType<Type>::type sum(const Type* data, std::size_t size, std::false_type) {
+                typename SumType<Type>::type total = typename SumType<Type>::type();
+                for (std::size_t i = 0; i < size; ++i) {
+                    total = total + data[i];
+                }
+                return total;
+            }
+
+        }
+
+    }
+
+}
+
+#endif // AISDI_LINEAR_SIMDKERNELS_H
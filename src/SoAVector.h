@@ -0,0 +1,165 @@
+#ifndef AISDI_LINEAR_SOAVECTOR_H
+#define AISDI_LINEAR_SOAVECTOR_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "Vector.h"
+#include "Span.h"
+#include "IndexSequence.h"
+
+namespace aisdi {
+
+    // Structure of arrays: every field is kept in its own Vector, so scanning a few fields
+    // touches only their columns. Rows are addressed by index.
+    template <typename... Fields>
+    class SoAVector {
+        static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+    public:
+        using size_type = std::size_t;
+        using value_type = std::tuple<Fields...>;
+
+        template <std::size_t Column>
+        using column_type = typename std::tuple_element<Column, value_type>::type;
+
+        static const size_type COLUMNS = sizeof...(Fields);
+
+        bool isEmpty() const {
+            return getSize() == 0;
+        }
+
+        size_type getSize() const {
+            return std::get<0>(columns).getSize();
+        }
+
+        void reserve(size_type capacity) {
+            reserve(capacity, Sequence());
+        }
+
+        void append(const Fields&... values) {
+            insert(Sequence(), getSize(), values...);
+        }
+
+        void prepend(const Fields&... values) {
+            insert(0, values...);
+        }
+
+        void insert(size_type position, const Fields&... values) {
+            if (position > getSize()) {
+                throw std::out_of_range("Position out of range");
+            }
+            insert(Sequence(), position, values...);
+        }
+
+        value_type get(size_type position) const {
+            if (position >= getSize()) {
+                throw std::out_of_range("Position out of range");
+            }
+            return get(position, Sequence());
+        }
+
+        value_type popFirst() {
+            if (isEmpty()) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            value_type val = get(0, Sequence());
+            erase(0);
+            return val;
+        }
+
+        value_type popLast() {
+            if (isEmpty()) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            value_type val = get(getSize() - 1, Sequence());
+            erase(getSize() - 1);
+            return val;
+        }
+
+        void erase(size_type position) {
+            if (position >= getSize()) {
+                throw std::out_of_range("Position out of range");
+            }
+            erase(position, position + 1);
+        }
+
+        void erase(size_type firstIncluded, size_type lastExcluded) {
+            if (firstIncluded > lastExcluded || lastExcluded > getSize()) {
+                throw std::out_of_range("Position out of range");
+            }
+            erase(Sequence(), firstIncluded, lastExcluded);
+        }
+
+        template <std::size_t Column>
+        Span<column_type<Column>> column() {
+            auto& values = std::get<Column>(columns);
+            return Span<column_type<Column>>(values.data(), values.getSize());
+        }
+
+        template <std::size_t Column>
+        Span<const column_type<Column>> column() const {
+            const auto& values = std::get<Column>(columns);
+            return Span<const column_type<Column>>(values.data(), values.getSize());
+        }
+
+    private:
+        using Sequence = typename detail::MakeIndexSequence<sizeof...(Fields)>::type;
+
+        template <std::size_t... Columns>
+        void reserve(size_type capacity, detail::IndexSequence<Columns...>) {
+            detail::expand({ (std::get<Columns>(columns).reserve(capacity), 0)... });
+        }
+
+        // Every column gets room first, so running out of memory changes nothing. When copying a field
+        // throws, the row is taken out of the columns that already hold it and the columns stay in step.
+        template <std::size_t... Columns>
+        void insert(detail::IndexSequence<Columns...>, size_type position, const Fields&... values) {
+            size_type size = getSize();
+            detail::expand({ (makeRoom<Columns>(size), 0)... });
+            try {
+                detail::expand({ (std::get<Columns>(columns).insert(
+                        std::get<Columns>(columns).cbegin() + position, values), 0)... });
+            }
+            catch (...) {
+                detail::expand({ (dropAddedRow<Columns>(size, position), 0)... });
+                throw;
+            }
+        }
+
+        template <std::size_t Column>
+        void makeRoom(size_type size) {
+            auto& values = std::get<Column>(columns);
+            if (values.getCapacity() <= size) {
+                values.reserve(size < 2 ? 4 : size * 2);
+            }
+        }
+
+        template <std::size_t Column>
+        void dropAddedRow(size_type size, size_type position) {
+            auto& values = std::get<Column>(columns);
+            if (values.getSize() > size) {
+                values.erase(values.cbegin() + position);
+            }
+        }
+
+        template <std::size_t... Columns>
+        value_type get(size_type position, detail::IndexSequence<Columns...>) const {
+            return value_type(std::get<Columns>(columns).data()[position]...);
+        }
+
+        template <std::size_t... Columns>
+        void erase(detail::IndexSequence<Columns...>, size_type firstIncluded, size_type lastExcluded) {
+            detail::expand({ (std::get<Columns>(columns).erase(
+                    std::get<Columns>(columns).cbegin() + firstIncluded,
+                    std::get<Columns>(columns).cbegin() + lastExcluded), 0)... });
+        }
+
+        std::tuple<Vector<Fields>...> columns;
+    };
+
+}
+
+#endif // AISDI_LINEAR_SOAVECTOR_H
@@ -0,0 +1,53 @@
+#ifndef AISDI_LINEAR_SPAN_H
+#define AISDI_LINEAR_SPAN_H
+
+#include <cstddef>
+
+namespace aisdi {
+
+    // Non-owning view of a contiguous run of elements, iterated with raw pointers.
+    template <typename Type>
+    class Span {
+    public:
+        using size_type = std::size_t;
+        using value_type = Type;
+        using pointer = Type*;
+        using reference = Type&;
+        using iterator = Type*;
+
+        Span() : first(nullptr), count(0) {}
+
+        Span(pointer first, size_type count) : first(first), count(count) {}
+
+        bool isEmpty() const {
+            return count == 0;
+        }
+
+        size_type getSize() const {
+            return count;
+        }
+
+        pointer data() const {
+            return first;
+        }
+
+        reference operator[](size_type index) const {
+            return first[index];
+        }
+
+        iterator begin() const {
+            return first;
+        }
+
+        iterator end() const {
+            return first + count;
+        }
+
+    private:
+        pointer first;
+        size_type count;
+    };
+
+}
+
+#endif // AISDI_LINEAR_SPAN_H
@@ -2,18 +2,41 @@
 #define AISDI_LINEAR_VECTOR_H
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <initializer_list>
 #include <stdexcept>
 #include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <istream>
+#include <ostream>
+
+#include "Serialization.h"
+#include "SimdKernels.h"
+#include "Hashing.h"
+#include "Allocators.h"
 
 namespace aisdi {
 
-    template <typename Type>
+    // Allocator is a standard allocator for Type. Its alignment (see AllocatorAlignment) applies to the
+    // start of the buffer; when it spans several elements the capacity is rounded up to a whole number
+    // of such blocks, so the buffer can be scanned in full-width steps.
+    template <typename Type, typename Alloc = std::allocator<Type>>
     class Vector {
+        using AllocTraits = std::allocator_traits<Alloc>;
+
+        static_assert(std::is_same<typename AllocTraits::value_type, Type>::value, "Allocator must allocate Type");
+        static_assert(std::is_same<typename AllocTraits::pointer, Type*>::value, "Allocator must use raw pointers");
+        static_assert((AllocatorAlignment<Alloc>::value & (AllocatorAlignment<Alloc>::value - 1)) == 0,
+                      "Vector alignment must be a power of two");
+
     public:
         using difference_type = std::ptrdiff_t;
         using size_type = std::size_t;
         using value_type = Type;
+        using allocator_type = Alloc;
         using pointer = Type*;
         using reference = Type&;
         using const_pointer = const Type*;
@@ -24,42 +47,76 @@ namespace aisdi {
         using iterator = Iterator;
         using const_iterator = ConstIterator;
 
-        Vector() {
-            data_array = new Type[INIT_SIZE];
-            allocated_size = INIT_SIZE;
+        static const size_type ALIGNMENT = AllocatorAlignment<Alloc>::value;
+
+        Vector() : Vector(Alloc()) {}
+
+        explicit Vector(const Alloc& alloc) : allocator(alloc) {
+            allocated_size = paddedCapacity(INIT_SIZE);
+            data_array = allocateArray(allocated_size);
             elements = 0;
         }
 
-        Vector(std::initializer_list<Type> l) {
-            elements = allocated_size = l.size();
-            data_array = new Type[allocated_size];
+        Vector(std::initializer_list<Type> l, const Alloc& alloc = Alloc()) : allocator(alloc) {
+            elements = l.size();
+            allocated_size = paddedCapacity(elements);
+            data_array = allocateArray(allocated_size);
             std::copy(l.begin(), l.end(), data_array);
         }
 
-        Vector(const Vector& other) {
-            elements = allocated_size = other.getSize();
-            data_array = new Type[allocated_size];
+        Vector(const Vector& other) : allocator(AllocTraits::select_on_container_copy_construction(other.allocator)) {
+            elements = other.getSize();
+            allocated_size = paddedCapacity(elements);
+            data_array = allocateArray(allocated_size);
             std::copy(other.begin(), other.end(), data_array);
         }
 
-        Vector(Vector&& other) {
+        Vector(Vector&& other) : allocator(std::move(other.allocator)) {
             data_array = other.data_array;
             other.data_array = nullptr;
             elements = other.elements;
             allocated_size = other.allocated_size;
+            other.elements = 0;
+            other.allocated_size = 0;
         }
 
         ~Vector() {
-            delete[] data_array;
+            releaseArray(data_array, allocated_size);
         }
 
         Vector& operator=(const Vector& other) {
             if (this == &other) {
                 return *this;
             }
-            delete[] data_array;
-            data_array = new Type[other.allocated_size];
-            std::copy(other.cbegin(), other.cend(), begin());
+            if (AllocTraits::propagate_on_container_copy_assignment::value) {
+                // memory of the old allocator has to go back to it before it is replaced
+                if (allocator != other.allocator) {
+                    releaseArray(data_array, allocated_size);
+                    data_array = nullptr;
+                    elements = allocated_size = 0;
+                }
+                allocator = other.allocator;
+            }
+            if (other.elements <= allocated_size) {
+                // every slot is already constructed, so the values are assigned over the existing ones
+                std::copy(other.data_array, other.data_array + other.elements, data_array);
+                if (!std::is_trivially_destructible<Type>::value && other.elements < elements) {
+                    // dropped elements give their resources back instead of lingering past the end
+                    std::fill(data_array + other.elements, data_array + elements, Type());
+                }
+                elements = other.elements;
+                return *this;
+            }
+            pointer new_arr = allocateArray(other.allocated_size);
+            try {
+                std::copy(other.data_array, other.data_array + other.elements, new_arr);
+            }
+            catch (...) {
+                releaseArray(new_arr, other.allocated_size);
+                throw;
+            }
+            releaseArray(data_array, allocated_size);
+            data_array = new_arr;
             allocated_size = other.allocated_size;
             elements = other.elements;
             return *this;
@@ -69,14 +126,39 @@ namespace aisdi {
             if (this == &other) {
                 return *this;
             }
-            delete[] data_array;
+            if (!AllocTraits::propagate_on_container_move_assignment::value && allocator != other.allocator) {
+                // the buffer cannot change owners, so the elements are moved one by one
+                pointer new_arr = allocateArray(other.allocated_size);
+                try {
+                    std::move(other.data_array, other.data_array + other.elements, new_arr);
+                }
+                catch (...) {
+                    releaseArray(new_arr, other.allocated_size);
+                    throw;
+                }
+                releaseArray(data_array, allocated_size);
+                data_array = new_arr;
+                allocated_size = other.allocated_size;
+                elements = other.elements;
+                return *this;
+            }
+            releaseArray(data_array, allocated_size);
+            if (AllocTraits::propagate_on_container_move_assignment::value) {
+                allocator = std::move(other.allocator);
+            }
             data_array = other.data_array;
             other.data_array = nullptr;
             allocated_size = other.allocated_size;
             elements = other.elements;
+            other.elements = 0;
+            other.allocated_size = 0;
             return *this;
         }
 
+        allocator_type get_allocator() const {
+            return allocator;
+        }
+
         bool isEmpty() const {
             return getSize() == 0;
         }
@@ -89,20 +171,44 @@ namespace aisdi {
             insert(end(), item);
         }
 
+        void append(Type&& item) {
+            insert(end(), std::move(item));
+        }
+
         void prepend(const Type& item) {
             insert(begin(), item);
         }
 
+        void prepend(Type&& item) {
+            insert(begin(), std::move(item));
+        }
+
         void insert(const const_iterator& insertPosition, const Type& item) {
-            difference_type dst =  insertPosition - cbegin();
             if (elements == allocated_size) {
-                reallocate();
+                // item may be one of the elements about to be reallocated
+                insert(insertPosition, Type(item));
+                return;
+            }
+            difference_type dst = insertPosition - cbegin();
+            const Type* source = std::addressof(item);
+            std::less<const Type*> before;
+            if (!before(source, data_array + dst) && before(source, data_array + elements)) {
+                // item is one of the elements shifted to make room
+                ++source;
             }
-            for (pointer it = data_array + elements - 1; it >= data_array + dst; --it) {
-                *(it + 1) = *it;
+            std::move_backward(data_array + dst, data_array + elements, data_array + elements + 1);
+            ++elements;
+            *(begin() + dst) = *source;
+        }
+
+        void insert(const const_iterator& insertPosition, Type&& item) {
+            difference_type dst =  insertPosition - cbegin();
+            if (elements == allocated_size) {
+                reallocate(std::max(allocated_size * 2, INIT_SIZE));
             }
+            std::move_backward(data_array + dst, data_array + elements, data_array + elements + 1);
             ++elements;
-            *(begin() + dst) = item;
+            *(begin() + dst) = std::move(item);
         }
 
         Type popFirst() {
@@ -124,21 +230,189 @@ namespace aisdi {
         }
 
         void erase(const const_iterator& position) {
+            if (position < cbegin() || position >= cend()) {
+                throw std::out_of_range("Iterator out of range");
+            }
             std::copy(position + 1, cend(), iterator(position));
             --elements;
         }
 
         void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded) {
+            if (firstIncluded < cbegin() || firstIncluded > lastExcluded || lastExcluded > cend()) {
+                throw std::out_of_range("Iterator out of range");
+            }
             std::copy(lastExcluded, cend(), iterator(firstIncluded));
             elements -= lastExcluded - firstIncluded;
         }
 
+        // Fills the hole with the last element, so the order is not preserved.
+        // Returned iterator points to the element moved into the hole (or to end()).
+        iterator swapRemove(const const_iterator& position) {
+            if (position < cbegin() || position >= cend()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            size_type index = position - cbegin();
+            --elements;
+            if (index != elements) {
+                data_array[index] = std::move(data_array[elements]);
+            }
+            return begin() + index;
+        }
+
+        template <typename Predicate>
+        size_type swapRemoveIf(Predicate pred) {
+            size_type removed = 0;
+            size_type i = 0;
+            while (i < elements) {
+                if (pred(data_array[i])) {
+                    --elements;
+                    if (i != elements) {
+                        data_array[i] = std::move(data_array[elements]);
+                    }
+                    ++removed;
+                }
+                else {
+                    ++i;
+                }
+            }
+            return removed;
+        }
+
+        template <typename Positions>
+        size_type eraseAt(const Positions& sortedPositions) {
+            return closeGaps(sortedPositions, PositionBounds());
+        }
+
+        size_type eraseAt(std::initializer_list<size_type> sortedPositions) {
+            return closeGaps(sortedPositions, PositionBounds());
+        }
+
+        template <typename Ranges>
+        size_type eraseRanges(const Ranges& sortedRanges) {
+            return closeGaps(sortedRanges, RangeBounds());
+        }
+
+        size_type eraseRanges(std::initializer_list<std::pair<size_type, size_type>> sortedRanges) {
+            return closeGaps(sortedRanges, RangeBounds());
+        }
+
+        template <typename Predicate>
+        size_type eraseIf(Predicate pred) {
+            size_type kept = compact(pred, std::is_arithmetic<Type>());
+            size_type removed = elements - kept;
+            elements = kept;
+            return removed;
+        }
+
+        size_type removeValue(const Type& value) {
+            return eraseIf([&value](const Type& item) { return item == value; });
+        }
+
+        size_type uniqueInPlace() {
+            if (isEmpty()) {
+                return 0;
+            }
+            size_type kept = 1;
+            for (size_type i = 1; i < elements; ++i) {
+                if (!(data_array[i] == data_array[kept - 1])) {
+                    if (i != kept) {
+                        data_array[kept] = std::move(data_array[i]);
+                    }
+                    ++kept;
+                }
+            }
+            size_type removed = elements - kept;
+            elements = kept;
+            return removed;
+        }
+
         void fitToSize() {
-            auto new_arr = new Type[getSize()];
-            std::copy(begin(), end(), new_arr);
-            allocated_size = getSize();
-            delete[] data_array;
-            data_array = new_arr;
+            replaceArray(paddedCapacity(getSize()));
+        }
+
+        void reserve(size_type capacity) {
+            if (capacity > allocated_size) {
+                reallocate(capacity);
+            }
+        }
+
+        size_type getCapacity() const {
+            return allocated_size;
+        }
+
+        // The buffer start is known to be ALIGNMENT-aligned, which lets the compiler use aligned loads.
+        pointer data() {
+            return static_cast<pointer>(detail::assumeAligned<ALIGNMENT>(data_array));
+        }
+
+        const_pointer data() const {
+            return static_cast<const_pointer>(detail::assumeAligned<ALIGNMENT>(data_array));
+        }
+
+        // Linear scans over the raw buffer, vectorized for 32 and 64 bit arithmetic types (see SimdKernels.h).
+
+        iterator find(const Type& value) {
+            return iterator(data_array + detail::simd::find(data_array, elements, value, Vectorizable()), *this);
+        }
+
+        const_iterator find(const Type& value) const {
+            return const_iterator(data_array + detail::simd::find(data_array, elements, value, Vectorizable()), *this);
+        }
+
+        bool contains(const Type& value) const {
+            return detail::simd::find(data_array, elements, value, Vectorizable()) != elements;
+        }
+
+        size_type count(const Type& value) const {
+            return detail::simd::count(data_array, elements, value, Vectorizable());
+        }
+
+        // Index of the first element equal to any of values, getSize() if there is none.
+        size_type indexOfAny(const Vector& values) const {
+            return detail::simd::findAny(data_array, elements, values.data_array, values.elements, Vectorizable());
+        }
+
+        size_type indexOfAny(std::initializer_list<Type> values) const {
+            return detail::simd::findAny(data_array, elements, values.begin(), values.size(), Vectorizable());
+        }
+
+        // First smallest/largest element or end() when empty, NaNs are skipped unless there is nothing else.
+        const_iterator minElement() const {
+            return extremeElement<false>();
+        }
+
+        const_iterator maxElement() const {
+            return extremeElement<true>();
+        }
+
+        // Integers are summed as 64 bit values, floats as doubles.
+        typename detail::simd::SumType<Type>::type sum() const {
+            return detail::simd::sum(data_array, elements, Vectorizable());
+        }
+
+        // Seeded hash of the contents, integral and enum elements are hashed as one byte buffer.
+        std::uint64_t hash(std::uint64_t seed = 0) const {
+            return detail::hashElements(data_array, elements, seed, detail::simd::IsBitwiseComparable<Type>());
+        }
+
+        // Binary format described in Serialization.h, trivially copyable elements are written in one block.
+        void save(std::ostream& out) const {
+            detail::PayloadWriter writer(out, elements, sizeof(Type), detail::IsRawSerializable<Type>::value);
+            saveElements(writer, detail::IsRawSerializable<Type>());
+            writer.finish();
+        }
+
+        void load(std::istream& in) {
+            detail::PayloadReader reader(in);
+            reader.expectElements<Type>();
+            if (reader.count() > AllocTraits::max_size(allocator)) {
+                throw std::runtime_error("Serialized collection is too large");
+            }
+            Vector loaded(allocator);
+            loaded.reserve(reader.reservableCount(sizeof(Type)));
+            loaded.loadElements(reader, reader.count(), detail::IsRawSerializable<Type>());
+            reader.finish();
+            *this = std::move(loaded);
         }
 
         iterator begin() {
@@ -166,14 +440,184 @@ namespace aisdi {
         }
 
     private:
-        void reallocate() {
-            auto new_arr = new Type[allocated_size * 2];
-            std::copy(begin(), end(), new_arr);
-            allocated_size *= 2;
-            delete[] data_array;
+        using bounds = std::pair<size_type, size_type>;
+        using Vectorizable = detail::simd::IsVectorizable<Type>;
+
+        template <bool Max>
+        const_iterator extremeElement() const {
+            if (isEmpty()) {
+                return cend();
+            }
+            return const_iterator(data_array + detail::simd::extremeIndex<Max>(data_array, elements, Vectorizable()), *this);
+        }
+
+        struct PositionBounds {
+            bounds operator()(size_type position) const {
+                return bounds(position, position + 1);
+            }
+        };
+
+        struct RangeBounds {
+            template <typename Range>
+            bounds operator()(const Range& range) const {
+                return bounds(range.first, range.second);
+            }
+        };
+
+        // Removes every [first, last) gap in a single pass, each surviving element is moved at most once.
+        template <typename Gaps, typename Bounds>
+        size_type closeGaps(const Gaps& gaps, Bounds toBounds) {
+            size_type previous_end = 0;
+            for (const auto& gap : gaps) {
+                bounds range = toBounds(gap);
+                if (range.first < previous_end || range.first > range.second) {
+                    throw std::invalid_argument("Erased positions must be sorted and disjoint");
+                }
+                if (range.second > elements) {
+                    throw std::out_of_range("Erased position out of range");
+                }
+                previous_end = range.second;
+            }
+            size_type write = 0;
+            size_type read = 0;
+            for (const auto& gap : gaps) {
+                bounds range = toBounds(gap);
+                if (read != write) {
+                    std::move(data_array + read, data_array + range.first, data_array + write);
+                }
+                write += range.first - read;
+                read = range.second;
+            }
+            if (read != write) {
+                std::move(data_array + read, data_array + elements, data_array + write);
+            }
+            size_type removed = read - write;
+            elements -= removed;
+            return removed;
+        }
+
+        template <typename Predicate>
+        size_type compact(Predicate& pred, std::false_type) {
+            size_type kept = 0;
+            for (size_type i = 0; i < elements; ++i) {
+                if (!pred(data_array[i])) {
+                    if (i != kept) {
+                        data_array[kept] = std::move(data_array[i]);
+                    }
+                    ++kept;
+                }
+            }
+            return kept;
+        }
+
+        // Branchless: every value is stored, but the write cursor only advances past the kept ones,
+        // which lets the compiler vectorize the loop for arithmetic types.
+        template <typename Predicate>
+        size_type compact(Predicate& pred, std::true_type) {
+            size_type kept = 0;
+            for (size_type i = 0; i < elements; ++i) {
+                Type value = data_array[i];
+                data_array[kept] = value;
+                kept += !pred(value);
+            }
+            return kept;
+        }
+
+        void saveElements(detail::PayloadWriter& writer, std::true_type) const {
+            writer.write(data_array, elements * sizeof(Type));
+        }
+
+        void saveElements(detail::PayloadWriter& writer, std::false_type) const {
+            for (size_type i = 0; i < elements; ++i) {
+                Codec<Type>::write(writer, data_array[i]);
+            }
+        }
+
+        // The buffer only grows ahead of data actually read, see PayloadReader::reservableCount.
+        void loadElements(detail::PayloadReader& reader, size_type count, std::true_type) {
+            const size_type chunk = std::max<size_type>(detail::FRAME_SIZE / sizeof(Type), 1);
+            while (elements < count) {
+                size_type part = std::min(count - elements, chunk);
+                if (elements + part > allocated_size) {
+                    reallocate(std::max(elements + part, allocated_size * 2));
+                }
+                reader.read(data_array + elements, part * sizeof(Type));
+                elements += part;
+            }
+        }
+
+        void loadElements(detail::PayloadReader& reader, size_type count, std::false_type) {
+            for (size_type i = 0; i < count; ++i) {
+                append(Codec<Type>::read(reader));
+            }
+        }
+
+        void reallocate(size_type new_size) {
+            replaceArray(paddedCapacity(new_size));
+        }
+
+        // Copies the elements into a new array of new_size slots; the old array stays if copying throws.
+        void replaceArray(size_type new_size) {
+            pointer new_arr = allocateArray(new_size);
+            try {
+                std::copy(begin(), end(), new_arr);
+            }
+            catch (...) {
+                releaseArray(new_arr, new_size);
+                throw;
+            }
+            releaseArray(data_array, allocated_size);
+            allocated_size = new_size;
             data_array = new_arr;
         }
 
+        static size_type paddedCapacity(size_type count) {
+            const size_type block = ALIGNMENT > sizeof(Type) ? ALIGNMENT / sizeof(Type) : 1;
+            return (count + block - 1) / block * block;
+        }
+
+        // Like new Type[count], but through the allocator. Trivial elements stay uninitialized as they do
+        // with new Type[], so growing does not zero-fill the spare capacity.
+        pointer allocateArray(size_type count) {
+            pointer array = AllocTraits::allocate(allocator, count);
+            if (TRIVIAL_SLOTS) {
+                return array;
+            }
+            size_type constructed = 0;
+            try {
+                for (; constructed < count; ++constructed) {
+                    AllocTraits::construct(allocator, array + constructed);
+                }
+            }
+            catch (...) {
+                releaseArray(array, constructed, count);
+                throw;
+            }
+            return array;
+        }
+
+        void releaseArray(pointer array, size_type count) {
+            releaseArray(array, count, count);
+        }
+
+        void releaseArray(pointer array, size_type constructed, size_type count) {
+            if (array == nullptr || DROPS_STORAGE) {
+                return;
+            }
+            while (!TRIVIAL_SLOTS && constructed > 0) {
+                AllocTraits::destroy(allocator, array + --constructed);
+            }
+            AllocTraits::deallocate(allocator, array, count);
+        }
+
+        static const bool TRIVIAL_SLOTS = std::is_trivially_default_constructible<Type>::value
+                                          && std::is_trivially_destructible<Type>::value;
+
+        // Arena-like allocators reclaim trivially destructible arrays without our help.
+        static const bool DROPS_STORAGE = std::is_trivially_destructible<Type>::value
+                                          && AllocatorReleasesInBulk<Alloc>::value;
+
+        Alloc allocator;
         pointer data_array;
         size_type elements;
         size_type allocated_size;
@@ -181,26 +625,30 @@ namespace aisdi {
         size_type INIT_SIZE = 4;
     };
 
-    template <typename Type>
-    class Vector<Type>::ConstIterator {
+    // Buffer aligned to a cache line (and any SIMD register up to AVX-512).
+    template <typename Type, std::size_t Alignment = 64>
+    using AlignedVector = Vector<Type, AlignedAllocator<Type, Alignment>>;
+
+    template <typename Type, typename Alloc>
+    class Vector<Type, Alloc>::ConstIterator {
     public:
-        using iterator_category = std::bidirectional_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
         using value_type = typename Vector::value_type;
         using difference_type = typename Vector::difference_type;
         using pointer = typename Vector::const_pointer;
         using reference = typename Vector::const_reference;
 
-        explicit ConstIterator(pointer ptr, const Vector<Type>& parent) : current_pointer(ptr), parent(parent) {}
+        explicit ConstIterator(pointer ptr, const Vector& parent) : current_pointer(ptr), parent(&parent) {}
 
         reference operator*() const {
-            if (*this < parent.begin() || *this >= parent.end()) {
+            if (*this < parent->begin() || *this >= parent->end()) {
                 throw std::out_of_range("Iterator out of range");
             }
             return *(current_pointer);
         }
 
         ConstIterator& operator++() {
-            if (*this >= parent.end()) {
+            if (*this >= parent->end()) {
                 throw std::out_of_range("Iterator out of range");
             }
             ++current_pointer;
@@ -208,7 +656,7 @@ namespace aisdi {
         }
 
         ConstIterator operator++(int) {
-            if (*this >= parent.end()) {
+            if (*this >= parent->end()) {
                 throw std::out_of_range("Iterator out of range");
             }
             ConstIterator result = *this;
@@ -217,7 +665,7 @@ namespace aisdi {
         }
 
         ConstIterator& operator--() {
-            if (*this <= parent.begin()) {
+            if (*this <= parent->begin()) {
                 throw std::out_of_range("Iterator out of range");
             }
             --current_pointer;
@@ -225,7 +673,7 @@ namespace aisdi {
         }
 
         ConstIterator operator--(int) {
-            if (*this <= parent.begin()) {
+            if (*this <= parent->begin()) {
                 throw std::out_of_range("Iterator out of range");
             }
             ConstIterator result = *this;
@@ -259,6 +707,10 @@ namespace aisdi {
             return new_iter;
         }
 
+        reference operator[](difference_type d) const {
+            return *(*this + d);
+        }
+
         bool operator==(const ConstIterator& other) const {
             return current_pointer == other.current_pointer;
         }
@@ -285,16 +737,16 @@ namespace aisdi {
 
     protected:
         pointer current_pointer;
-        const Vector<Type>& parent;
+        const Vector* parent;
     };
 
-    template <typename Type>
-    class Vector<Type>::Iterator : public Vector<Type>::ConstIterator {
+    template <typename Type, typename Alloc>
+    class Vector<Type, Alloc>::Iterator : public Vector<Type, Alloc>::ConstIterator {
     public:
         using pointer = typename Vector::pointer;
         using reference = typename Vector::reference;
 
-        explicit Iterator(pointer ptr, Vector<Type>& parent) : ConstIterator(ptr, parent) {}
+        explicit Iterator(pointer ptr, Vector& parent) : ConstIterator(ptr, parent) {}
 
         Iterator(const ConstIterator& other)
                 : ConstIterator(other) {}
@@ -321,10 +773,22 @@ namespace aisdi {
             return result;
         }
 
+        Iterator& operator+=(difference_type d) {
+            ConstIterator::operator+=(d);
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type d) {
+            ConstIterator::operator-=(d);
+            return *this;
+        }
+
         Iterator operator+(difference_type d) const {
             return ConstIterator::operator+(d);
         }
 
+        using ConstIterator::operator-;
+
         Iterator operator-(difference_type d) const {
             return ConstIterator::operator-(d);
         }
@@ -333,6 +797,54 @@ namespace aisdi {
             // ugly cast, yet reduces code duplication.
             return const_cast<reference>(ConstIterator::operator*());
         }
+
+        reference operator[](difference_type d) const {
+            return *(*this + d);
+        }
+    };
+
+    // Sizes are compared first, then integral/enum buffers with memcmp and arithmetic ones with the SIMD kernels.
+    template <typename Type, typename Alloc>
+    bool operator==(const Vector<Type, Alloc>& lhs, const Vector<Type, Alloc>& rhs) {
+        return lhs.getSize() == rhs.getSize()
+               && detail::simd::equal(lhs.data(), rhs.data(), lhs.getSize(), detail::simd::IsBitwiseComparable<Type>());
+    }
+
+    template <typename Type, typename Alloc>
+    bool operator!=(const Vector<Type, Alloc>& lhs, const Vector<Type, Alloc>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    template <typename Type, typename Alloc>
+    bool operator<(const Vector<Type, Alloc>& lhs, const Vector<Type, Alloc>& rhs) {
+        return detail::simd::lexicographicalLess(lhs.data(), lhs.getSize(), rhs.data(), rhs.getSize(),
+                                                 detail::simd::IsVectorizable<Type>());
+    }
+
+    template <typename Type, typename Alloc>
+    bool operator>(const Vector<Type, Alloc>& lhs, const Vector<Type, Alloc>& rhs) {
+        return rhs < lhs;
+    }
+
+    template <typename Type, typename Alloc>
+    bool operator<=(const Vector<Type, Alloc>& lhs, const Vector<Type, Alloc>& rhs) {
+        return !(rhs < lhs);
+    }
+
+    template <typename Type, typename Alloc>
+    bool operator>=(const Vector<Type, Alloc>& lhs, const Vector<Type, Alloc>& rhs) {
+        return !(lhs < rhs);
+    }
+
+}
+
+namespace std {
+
+    template <typename Type, typename Alloc>
+    struct hash<aisdi::Vector<Type, Alloc>> {
+        std::size_t operator()(const aisdi::Vector<Type, Alloc>& vector) const {
+            return vector.hash();
+        }
     };
 
 }
@@ -0,0 +1,398 @@
+#ifndef AISDI_LINEAR_VMVECTOR_H
+#define AISDI_LINEAR_VMVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <algorithm>
+#include <cerrno>
+#include <new>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "ContiguousIterator.h"
+
+namespace aisdi {
+
+    // Linux only. Reserves an address range up front and commits pages as the vector grows, so the buffer
+    // does not move and growth does not copy elements while the reservation lasts. An explicit maximum is a
+    // hard limit; a default-constructed vector moves to a reservation twice as large once DEFAULT_RESERVATION
+    // is used up, remapping the pages of trivially copyable elements and move-constructing other elements.
+    // That move invalidates every pointer, reference and iterator into the vector.
+    template <typename Type>
+    class VmVector {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+        using value_type = Type;
+        using pointer = Type*;
+        using reference = Type&;
+        using const_pointer = const Type*;
+        using const_reference = const Type&;
+
+        using iterator = ContiguousIterator<VmVector>;
+        using const_iterator = ContiguousConstIterator<VmVector>;
+
+        static const size_type DEFAULT_RESERVATION = size_type(1) << 26;
+
+        VmVector() : VmVector(DEFAULT_RESERVATION / sizeof(Type)) {
+            growable = true;
+        }
+
+        explicit VmVector(size_type maxElements, bool hugePages = false)
+                : elements(0), committed_bytes(0), huge_pages(hugePages), growable(false) {
+            if (maxElements > size_type(-1) / sizeof(Type)) {
+                throw std::length_error("VmVector reservation too large");
+            }
+            data_array = static_cast<pointer>(reserveAddressSpace(maxElements * sizeof(Type)));
+        }
+
+        VmVector(std::initializer_list<Type> l) : VmVector() {
+            for (const auto& val : l) {
+                append(val);
+            }
+        }
+
+        VmVector(const VmVector& other) : VmVector(other.getCapacity(), other.huge_pages) {
+            growable = other.growable;
+            for (const auto& val : other) {
+                append(val);
+            }
+        }
+
+        VmVector(VmVector&& other)
+                : data_array(other.data_array), elements(other.elements), reserved_bytes(other.reserved_bytes),
+                  committed_bytes(other.committed_bytes), huge_pages(other.huge_pages), growable(other.growable) {
+            other.data_array = nullptr;
+            other.elements = 0;
+            other.reserved_bytes = 0;
+            other.committed_bytes = 0;
+        }
+
+        ~VmVector() {
+            release();
+        }
+
+        VmVector& operator=(const VmVector& other) {
+            if (this == &other) {
+                return *this;
+            }
+            VmVector copy(other);
+            return *this = std::move(copy);
+        }
+
+        VmVector& operator=(VmVector&& other) {
+            if (this == &other) {
+                return *this;
+            }
+            release();
+            data_array = other.data_array;
+            elements = other.elements;
+            reserved_bytes = other.reserved_bytes;
+            committed_bytes = other.committed_bytes;
+            huge_pages = other.huge_pages;
+            growable = other.growable;
+            other.data_array = nullptr;
+            other.elements = 0;
+            other.reserved_bytes = 0;
+            other.committed_bytes = 0;
+            return *this;
+        }
+
+        bool isEmpty() const {
+            return getSize() == 0;
+        }
+
+        size_type getSize() const {
+            return elements;
+        }
+
+        size_type getCapacity() const {
+            return reserved_bytes / sizeof(Type);
+        }
+
+        size_type getCommittedBytes() const {
+            return committed_bytes;
+        }
+
+        pointer data() {
+            return data_array;
+        }
+
+        const_pointer data() const {
+            return data_array;
+        }
+
+        reference operator[](size_type index) {
+            return data_array[index];
+        }
+
+        const_reference operator[](size_type index) const {
+            return data_array[index];
+        }
+
+        void append(const Type& item) {
+            if ((elements + 1) * sizeof(Type) > reserved_bytes) {
+                // item may live in the range that growth is about to unmap
+                Type copy(item);
+                commit(elements + 1);
+                new (data_array + elements) Type(std::move(copy));
+            } else {
+                commit(elements + 1);
+                new (data_array + elements) Type(item);
+            }
+            ++elements;
+        }
+
+        void prepend(const Type& item) {
+            insert(begin(), item);
+        }
+
+        void insert(const const_iterator& insertPosition, const Type& item) {
+            size_type index = insertPosition - cbegin();
+            if (index > elements) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            if (index == elements) {
+                append(item);
+                return;
+            }
+            Type copy(item);
+            commit(elements + 1);
+            new (data_array + elements) Type(std::move(data_array[elements - 1]));
+            ++elements;
+            std::move_backward(data_array + index, data_array + elements - 2, data_array + elements - 1);
+            data_array[index] = std::move(copy);
+        }
+
+        Type popFirst() {
+            if (isEmpty()) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            Type val = std::move(data_array[0]);
+            erase(cbegin());
+            return val;
+        }
+
+        Type popLast() {
+            if (isEmpty()) {
+                throw std::logic_error("You cannot pop from empty collection");
+            }
+            Type val = std::move(data_array[elements - 1]);
+            shrink(elements - 1);
+            return val;
+        }
+
+        void erase(const const_iterator& position) {
+            if (position < cbegin() || position >= cend()) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            erase(position, position + 1);
+        }
+
+        void erase(const const_iterator& firstIncluded, const const_iterator& lastExcluded) {
+            size_type first = firstIncluded - cbegin();
+            size_type last = lastExcluded - cbegin();
+            if (first > last || last > elements) {
+                throw std::out_of_range("Iterator out of range");
+            }
+            std::move(data_array + last, data_array + elements, data_array + first);
+            shrink(elements - (last - first));
+        }
+
+        // Returns the pages past the last element to the kernel, the address range stays reserved.
+        void fitToSize() {
+            if (!decommit(roundToPages(elements * sizeof(Type)))) {
+                throw std::system_error(errno, std::generic_category(), "Cannot release VmVector pages");
+            }
+        }
+
+        iterator begin() {
+            return iterator(data_array, *this);
+        }
+
+        iterator end() {
+            return iterator(data_array + elements, *this);
+        }
+
+        const_iterator cbegin() const {
+            return const_iterator(data_array, *this);
+        }
+
+        const_iterator cend() const {
+            return const_iterator(data_array + elements, *this);
+        }
+
+        const_iterator begin() const {
+            return cbegin();
+        }
+
+        const_iterator end() const {
+            return cend();
+        }
+
+    private:
+        static const size_type HUGE_PAGE_SIZE = size_type(2) << 20;
+        static const size_type SHRINK_THRESHOLD = size_type(1) << 16;
+
+        static size_type pageSize() {
+            static const size_type page = sysconf(_SC_PAGESIZE);
+            return page;
+        }
+
+        size_type roundToPages(size_type bytes) const {
+            size_type granularity = huge_pages ? HUGE_PAGE_SIZE : pageSize();
+            return (bytes + granularity - 1) / granularity * granularity;
+        }
+
+        // Maps bytes of inaccessible address space and sets reserved_bytes. Huge page ranges are trimmed to
+        // start on a huge page boundary, otherwise the kernel cannot back them with huge pages.
+        void* reserveAddressSpace(size_type bytes) {
+            size_type reserved = roundToPages(std::max<size_type>(bytes, sizeof(Type)));
+            size_type slack = huge_pages ? HUGE_PAGE_SIZE : 0;
+            if (reserved < bytes || reserved + slack < reserved) {
+                throw std::length_error("VmVector reservation too large");
+            }
+            void* mapped = mmap(nullptr, reserved + slack, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                                -1, 0);
+            if (mapped == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            char* base = static_cast<char*>(mapped);
+            if (slack > 0) {
+                size_type head = (HUGE_PAGE_SIZE - reinterpret_cast<std::uintptr_t>(base) % HUGE_PAGE_SIZE)
+                                 % HUGE_PAGE_SIZE;
+                if (head > 0) {
+                    munmap(base, head);
+                }
+                if (slack - head > 0) {
+                    munmap(base + head + reserved, slack - head);
+                }
+                base += head;
+#ifdef MADV_HUGEPAGE
+                madvise(base, reserved, MADV_HUGEPAGE);
+#endif
+            }
+            reserved_bytes = reserved;
+            return base;
+        }
+
+        void commit(size_type count) {
+            size_type needed = count * sizeof(Type);
+            if (needed <= committed_bytes) {
+                return;
+            }
+            if (needed > reserved_bytes) {
+                if (!growable) {
+                    throw std::length_error("VmVector reservation exhausted");
+                }
+                growReservation(std::max(needed, reserved_bytes * 2));
+            }
+            size_type target = std::min(reserved_bytes, roundToPages(std::max(needed, committed_bytes * 2)));
+            char* from = reinterpret_cast<char*>(data_array) + committed_bytes;
+            if (mprotect(from, target - committed_bytes, PROT_READ | PROT_WRITE) != 0) {
+                throw std::bad_alloc();
+            }
+            committed_bytes = target;
+        }
+
+        void growReservation(size_type bytes) {
+            size_type old_reserved = reserved_bytes;
+            char* old_base = reinterpret_cast<char*>(data_array);
+            char* base = static_cast<char*>(reserveAddressSpace(bytes));
+            if (!relocate(old_base, base)) {
+                munmap(base, reserved_bytes);
+                reserved_bytes = old_reserved;
+                throw std::bad_alloc();
+            }
+            munmap(old_base + committed_bytes, old_reserved - committed_bytes);
+            data_array = reinterpret_cast<pointer>(base);
+        }
+
+        // Moves the committed pages to the new range; the old committed pages are gone afterwards.
+        bool relocate(char* from, char* to) {
+            if (committed_bytes == 0) {
+                return true;
+            }
+            if (std::is_trivially_copyable<Type>::value) {
+                return mremap(from, committed_bytes, committed_bytes, MREMAP_MAYMOVE | MREMAP_FIXED, to) != MAP_FAILED;
+            }
+            if (mprotect(to, committed_bytes, PROT_READ | PROT_WRITE) != 0) {
+                return false;
+            }
+            pointer source = reinterpret_cast<pointer>(from);
+            pointer target = reinterpret_cast<pointer>(to);
+            size_type moved = 0;
+            try {
+                for (; moved < elements; ++moved) {
+                    new (target + moved) Type(std::move_if_noexcept(source[moved]));
+                }
+            } catch (...) {
+                while (moved > 0) {
+                    target[--moved].~Type();
+                }
+                return false;
+            }
+            for (size_type i = 0; i < elements; ++i) {
+                source[i].~Type();
+            }
+            munmap(from, committed_bytes);
+            return true;
+        }
+
+        // Releases the committed pages past keep bytes; false when the kernel refused.
+        bool decommit(size_type keep) {
+            if (keep >= committed_bytes) {
+                return true;
+            }
+            char* from = reinterpret_cast<char*>(data_array) + keep;
+            if (madvise(from, committed_bytes - keep, MADV_DONTNEED) != 0
+                    || mprotect(from, committed_bytes - keep, PROT_NONE) != 0) {
+                return false;
+            }
+            committed_bytes = keep;
+            return true;
+        }
+
+        void destroyTail(size_type newSize) {
+            while (elements > newSize) {
+                --elements;
+                data_array[elements].~Type();
+            }
+        }
+
+        void shrink(size_type newSize) {
+            destroyTail(newSize);
+            // give pages back once three quarters of the committed range is unused, keeping room to regrow
+            size_type used = roundToPages(elements * sizeof(Type));
+            if (used * 4 <= committed_bytes && committed_bytes > SHRINK_THRESHOLD) {
+                size_type keep = roundToPages(2 * elements * sizeof(Type));
+                decommit(keep > SHRINK_THRESHOLD ? keep : SHRINK_THRESHOLD);
+            }
+        }
+
+        void release() {
+            if (data_array == nullptr) {
+                return;
+            }
+            destroyTail(0);
+            munmap(data_array, reserved_bytes);
+            data_array = nullptr;
+        }
+
+        pointer data_array;
+        size_type elements;
+        size_type reserved_bytes;
+        size_type committed_bytes;
+        bool huge_pages;
+        bool growable;
+    };
+
+}
+
+#endif // AISDI_LINEAR_VMVECTOR_H
@@ -1,105 +1,420 @@
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <string>
 #include <iostream>
-#include <map>
-#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "Vector.h"
 #include "LinkedList.h"
+#include "AdaptiveSequence.h"
+#include "SoAVector.h"
+#include "Arena.h"
+#include "Benchmark.h"
 
 namespace {
 
-    using Stats = struct Stats {
-        std::map<std::string, long long> time {
-                {"10_insert_begin", 0},
-                {"10_insert_middle", 0},
-                {"10_insert_end", 0},
-                {"100_insert_begin", 0},
-                {"100_insert_middle", 0},
-                {"100_insert_end", 0},
-                {"1000_insert_begin", 0},
-                {"1000_insert_middle", 0},
-                {"1000_insert_end", 0},
-                {"10000_insert_begin", 0},
-                {"10000_insert_middle", 0},
-                {"10000_insert_end", 0},
-                {"100000_insert_begin", 0},
-                {"100000_insert_middle", 0},
-                {"100000_insert_end", 0},
-        };
-        long executions = 0L;
-
-        void print_results() {
-            for (auto& pair : time) {
-                std::cout << pair.first << "= " << float(pair.second) / executions << std::endl;
-            }
-        }
-    };
+    using aisdi::bench::Sample;
+    using aisdi::bench::Stopwatch;
 
     template<typename T>
     using LinearCollection = aisdi::Vector<T>;
 
-    std::clock_t test_begin(size_t size) {
+    volatile std::int64_t scan_sink;
+
+    // Operations that do not build the collection from scratch are timed in batches of at most this many, each
+    // operation on its own lap.
+    const std::size_t BATCH = 1000;
+
+    std::size_t batchFor(std::size_t size) {
+        return size < BATCH ? size : BATCH;
+    }
+
+    template <typename Collection>
+    Collection filled(std::size_t size) {
+        Collection collection;
+        for (std::size_t i = 0; i < size; ++i) {
+            collection.append(int(i));
+        }
+        return collection;
+    }
+
+    // std::next steps in constant time through random access iterators, so middle insert and erase time the
+    // collection and not the walk; lists still walk to the middle, which is part of what those operations cost.
+    template <typename Collection>
+    typename Collection::const_iterator middleOf(const Collection& collection) {
+        return std::next(collection.cbegin(), collection.getSize() / 2);
+    }
+
+    // Registers every operation of the common collection interface under prefix/operation.
+    template <typename Collection>
+    void addCollectionCases(aisdi::bench::Suite& suite, const std::string& prefix) {
+        suite.add(prefix + "/append", [](std::size_t size) {
+            Collection collection;
+            Stopwatch watch(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                collection.append(int(i));
+                watch.lap();
+            }
+            return watch.stop(size);
+        });
+        suite.add(prefix + "/prepend", [](std::size_t size) {
+            Collection collection = filled<Collection>(size);
+            const std::size_t batch = batchFor(size);
+            Stopwatch watch(batch);
+            for (std::size_t i = 0; i < batch; ++i) {
+                collection.prepend(int(i));
+                watch.lap();
+            }
+            return watch.stop(batch);
+        });
+        suite.add(prefix + "/insert_middle", [](std::size_t size) {
+            Collection collection = filled<Collection>(size);
+            const std::size_t batch = batchFor(size);
+            Stopwatch watch(batch);
+            for (std::size_t i = 0; i < batch; ++i) {
+                collection.insert(middleOf(collection), int(i));
+                watch.lap();
+            }
+            return watch.stop(batch);
+        });
+        suite.add(prefix + "/erase_middle", [](std::size_t size) {
+            Collection collection = filled<Collection>(size);
+            const std::size_t batch = batchFor(size);
+            Stopwatch watch(batch);
+            for (std::size_t i = 0; i < batch; ++i) {
+                collection.erase(middleOf(collection));
+                watch.lap();
+            }
+            return watch.stop(batch);
+        });
+        suite.add(prefix + "/erase_range", [](std::size_t size) {
+            Collection collection = filled<Collection>(size);
+            const auto first = std::next(collection.cbegin(), size / 4);
+            const auto last = std::next(first, size / 2);
+            Stopwatch watch;
+            collection.erase(first, last);
+            return watch.stop(size / 2);
+        });
+        suite.add(prefix + "/pop_first", [](std::size_t size) {
+            Collection collection = filled<Collection>(size);
+            const std::size_t batch = batchFor(size);
+            std::int64_t total = 0;
+            Stopwatch watch(batch);
+            for (std::size_t i = 0; i < batch; ++i) {
+                total += collection.popFirst();
+                watch.lap();
+            }
+            Sample sample = watch.stop(batch);
+            scan_sink = total;
+            return sample;
+        });
+        suite.add(prefix + "/pop_last", [](std::size_t size) {
+            Collection collection = filled<Collection>(size);
+            const std::size_t batch = batchFor(size);
+            std::int64_t total = 0;
+            Stopwatch watch(batch);
+            for (std::size_t i = 0; i < batch; ++i) {
+                total += collection.popLast();
+                watch.lap();
+            }
+            Sample sample = watch.stop(batch);
+            scan_sink = total;
+            return sample;
+        });
+        suite.add(prefix + "/iterate", [](std::size_t size) {
+            const Collection collection = filled<Collection>(size);
+            std::int64_t total = 0;
+            Stopwatch watch;
+            for (int item : collection) {
+                total += item;
+            }
+            Sample sample = watch.stop(size);
+            scan_sink = total;
+            return sample;
+        });
+        suite.add(prefix + "/copy_construct", [](std::size_t size) {
+            const Collection source = filled<Collection>(size);
+            Stopwatch watch;
+            Collection copy(source);
+            Sample sample = watch.stop(size);
+            scan_sink = copy.getSize();
+            return sample;
+        });
+        suite.add(prefix + "/move_construct", [](std::size_t size) {
+            Collection source = filled<Collection>(size);
+            Stopwatch watch;
+            Collection moved(std::move(source));
+            Sample sample = watch.stop(1);
+            scan_sink = moved.getSize();
+            return sample;
+        });
+        suite.add(prefix + "/copy_assign", [](std::size_t size) {
+            const Collection source = filled<Collection>(size);
+            Collection target = filled<Collection>(size);
+            Stopwatch watch;
+            target = source;
+            Sample sample = watch.stop(size);
+            scan_sink = target.getSize();
+            return sample;
+        });
+        suite.add(prefix + "/move_assign", [](std::size_t size) {
+            Collection source = filled<Collection>(size);
+            Collection target = filled<Collection>(size);
+            Stopwatch watch;
+            target = std::move(source);
+            Sample sample = watch.stop(1);
+            scan_sink = target.getSize();
+            return sample;
+        });
+    }
+
+    struct Record {
+        std::int64_t id;
+        std::int64_t price;
+        std::int64_t quantity;
+        std::int64_t created;
+        std::int64_t updated;
+        std::int64_t owner;
+        std::int64_t flags;
+        std::int64_t version;
+    };
+
+    using RecordColumns = aisdi::SoAVector<std::int64_t, std::int64_t, std::int64_t, std::int64_t,
+                                           std::int64_t, std::int64_t, std::int64_t, std::int64_t>;
+
+    const std::size_t SCAN_ROWS = 1000000;
+
+    Sample test_scan_aos() {
+        aisdi::Vector<Record> records;
+        records.reserve(SCAN_ROWS);
+        for (std::int64_t i = 0; i < std::int64_t(SCAN_ROWS); ++i) {
+            records.append(Record{i, i % 100, i % 7, i, i, i, i, i});
+        }
+        const Record* rows = records.data();
+        std::int64_t total = 0;
+        Stopwatch watch;
+        for (std::size_t i = 0; i < SCAN_ROWS; ++i) {
+            total += rows[i].price * rows[i].quantity;
+        }
+        Sample sample = watch.stop(SCAN_ROWS);
+        scan_sink = total;
+        return sample;
+    }
+
+    Sample test_scan_soa() {
+        RecordColumns records;
+        records.reserve(SCAN_ROWS);
+        for (std::int64_t i = 0; i < std::int64_t(SCAN_ROWS); ++i) {
+            records.append(i, i % 100, i % 7, i, i, i, i, i);
+        }
+        const auto prices = records.column<1>();
+        const auto quantities = records.column<2>();
+        std::int64_t total = 0;
+        Stopwatch watch;
+        for (std::size_t i = 0; i < SCAN_ROWS; ++i) {
+            total += prices[i] * quantities[i];
+        }
+        Sample sample = watch.stop(SCAN_ROWS);
+        scan_sink = total;
+        return sample;
+    }
+
+    const std::size_t SEARCH_SIZE = 1000000;
+    const int MISSING_VALUE = -1;
+
+    LinearCollection<int> searched_collection() {
         LinearCollection<int> collection;
-        std::clock_t ts, tf;
-        for (unsigned int i = 0; i < size; ++i) {
-            collection.append(i);
+        collection.reserve(SEARCH_SIZE);
+        for (std::size_t i = 0; i < SEARCH_SIZE; ++i) {
+            collection.append(int(i % 1000));
         }
+        return collection;
+    }
+
+    Sample test_find_iterator(const LinearCollection<int>& collection) {
+        Stopwatch watch;
         auto it = collection.begin();
-        ts = std::clock();
-        collection.insert(it, 103);
-        tf = std::clock();
-        return tf - ts;
+        while (it != collection.end() && *it != MISSING_VALUE) {
+            ++it;
+        }
+        Sample sample = watch.stop(SEARCH_SIZE);
+        scan_sink = it == collection.end();
+        return sample;
     }
 
-    std::clock_t test_middle(size_t size) {
-        LinearCollection<int> collection;
-        std::clock_t ts, tf;
-        for (unsigned int i = 0; i < size; ++i) {
-            collection.append(i);
+    Sample test_find_simd(const LinearCollection<int>& collection) {
+        Stopwatch watch;
+        auto it = collection.find(MISSING_VALUE);
+        Sample sample = watch.stop(SEARCH_SIZE);
+        scan_sink = it == collection.end();
+        return sample;
+    }
+
+    Sample test_count_iterator(const LinearCollection<int>& collection) {
+        std::size_t total = 0;
+        Stopwatch watch;
+        for (int item : collection) {
+            total += item == 7;
         }
-        auto it = collection.begin() + collection.getSize() / 2;
-        ts = std::clock();
-        collection.insert(it, 103);
-        tf = std::clock();
-        return tf - ts;
+        Sample sample = watch.stop(SEARCH_SIZE);
+        scan_sink = total;
+        return sample;
     }
 
-    std::clock_t test_end(size_t size) {
-        LinearCollection<int> collection;
-        std::clock_t ts, tf;
-        for (unsigned int i = 0; i < size; ++i) {
-            collection.append(i);
+    Sample test_count_simd(const LinearCollection<int>& collection) {
+        Stopwatch watch;
+        std::size_t total = collection.count(7);
+        Sample sample = watch.stop(SEARCH_SIZE);
+        scan_sink = total;
+        return sample;
+    }
+
+    Sample test_min_iterator(const LinearCollection<int>& collection) {
+        Stopwatch watch;
+        auto best = collection.begin();
+        for (auto it = collection.begin(); it != collection.end(); ++it) {
+            if (*it < *best) {
+                best = it;
+            }
+        }
+        Sample sample = watch.stop(SEARCH_SIZE);
+        scan_sink = *best;
+        return sample;
+    }
+
+    Sample test_min_simd(const LinearCollection<int>& collection) {
+        Stopwatch watch;
+        auto best = collection.minElement();
+        Sample sample = watch.stop(SEARCH_SIZE);
+        scan_sink = *best;
+        return sample;
+    }
+
+    Sample test_sum_iterator(const LinearCollection<int>& collection) {
+        std::int64_t total = 0;
+        Stopwatch watch;
+        for (int item : collection) {
+            total += item;
+        }
+        Sample sample = watch.stop(SEARCH_SIZE);
+        scan_sink = total;
+        return sample;
+    }
+
+    Sample test_sum_simd(const LinearCollection<int>& collection) {
+        Stopwatch watch;
+        std::int64_t total = collection.sum();
+        Sample sample = watch.stop(SEARCH_SIZE);
+        scan_sink = total;
+        return sample;
+    }
+
+    const std::size_t REQUEST_COUNT = 1000;
+    const std::size_t REQUEST_ITEMS = 256;
+
+    // A request builds a few short-lived collections and throws them away.
+    template <typename IntAlloc>
+    std::int64_t serve_request(const IntAlloc& allocator) {
+        aisdi::Vector<int, IntAlloc> values(allocator);
+        aisdi::LinkedList<int, IntAlloc> pending(allocator);
+        for (std::size_t i = 0; i < REQUEST_ITEMS; ++i) {
+            values.append(int(i));
+            pending.append(int(i));
         }
-        auto it = collection.end();
-        ts = std::clock();
-        collection.insert(it, 103);
-        tf = std::clock();
-        return tf - ts;
-    }
-
-    void perfomTest(Stats& statistics) {
-        statistics.executions += 1;
-        std::cout << "Iteration: " << statistics.executions << std::endl;
-        std::vector<int> sizes{10, 100, 1000, 10000, 100000};
-
-        for (int size : sizes) {
-            statistics.time[std::to_string(size) + "_insert_begin"] += test_begin(size);
-            statistics.time[std::to_string(size) + "_insert_middle"] += test_middle(size);
-            statistics.time[std::to_string(size) + "_insert_end"] += test_end(size);
+        return values.sum() + pending.getSize();
+    }
+
+    Sample test_requests_heap() {
+        std::int64_t total = 0;
+        Stopwatch watch;
+        for (std::size_t i = 0; i < REQUEST_COUNT; ++i) {
+            total += serve_request(std::allocator<int>());
+        }
+        Sample sample = watch.stop(REQUEST_COUNT);
+        scan_sink = total;
+        return sample;
+    }
+
+    Sample test_requests_arena() {
+        std::int64_t total = 0;
+        alignas(std::max_align_t) static char buffer[16 * 1024];
+        aisdi::Arena arena(buffer, sizeof(buffer));
+        Stopwatch watch;
+        for (std::size_t i = 0; i < REQUEST_COUNT; ++i) {
+            total += serve_request(aisdi::ArenaAllocator<int>(arena));
+            arena.reset();
+        }
+        Sample sample = watch.stop(REQUEST_COUNT);
+        scan_sink = total;
+        return sample;
+    }
+
+    aisdi::bench::Suite buildSuite() {
+        aisdi::bench::Suite suite;
+        addCollectionCases<aisdi::Vector<int>>(suite, "vector");
+        addCollectionCases<aisdi::LinkedList<int>>(suite, "linked_list");
+        addCollectionCases<aisdi::AdaptiveSequence<int>>(suite, "adaptive_sequence");
+
+        suite.addFixed("scan_2_of_8_aos", SCAN_ROWS, [](std::size_t) { return test_scan_aos(); });
+        suite.addFixed("scan_2_of_8_soa", SCAN_ROWS, [](std::size_t) { return test_scan_soa(); });
+
+        // the searched collection is built once and shared by the search cases
+        static const LinearCollection<int> searched = searched_collection();
+        suite.addFixed("find_iterator", SEARCH_SIZE, [](std::size_t) { return test_find_iterator(searched); });
+        suite.addFixed("find_simd", SEARCH_SIZE, [](std::size_t) { return test_find_simd(searched); });
+        suite.addFixed("count_iterator", SEARCH_SIZE, [](std::size_t) { return test_count_iterator(searched); });
+        suite.addFixed("count_simd", SEARCH_SIZE, [](std::size_t) { return test_count_simd(searched); });
+        suite.addFixed("min_iterator", SEARCH_SIZE, [](std::size_t) { return test_min_iterator(searched); });
+        suite.addFixed("min_simd", SEARCH_SIZE, [](std::size_t) { return test_min_simd(searched); });
+        suite.addFixed("sum_iterator", SEARCH_SIZE, [](std::size_t) { return test_sum_iterator(searched); });
+        suite.addFixed("sum_simd", SEARCH_SIZE, [](std::size_t) { return test_sum_simd(searched); });
+
+        suite.addFixed("requests_heap", REQUEST_COUNT, [](std::size_t) { return test_requests_heap(); });
+        suite.addFixed("requests_arena", REQUEST_COUNT, [](std::size_t) { return test_requests_arena(); });
+        return suite;
+    }
+
+    bool writeReport(const std::string& path, const std::vector<aisdi::bench::Result>& results,
+                     void (*write)(const std::vector<aisdi::bench::Result>&, std::ostream&)) {
+        std::ofstream out(path);
+        write(results, out);
+        out.close();
+        if (!out) {
+            std::cerr << "Cannot write " << path << std::endl;
+            return false;
         }
+        return true;
     }
 }
 
 int main(int argc, char** argv)
 {
-    Stats stats;
-    const std::size_t repeatCount = argc > 1 ? std::atoll(argv[1]) : 1;
-    std::cout << "Testing for " << repeatCount << " iterations..." << std::endl;
-    for (std::size_t i = 0; i < repeatCount; ++i) {
-        perfomTest(stats);
+    aisdi::bench::Config config;
+    try {
+        config = aisdi::bench::parseArguments(argc, argv);
+    }
+    catch (const std::invalid_argument& error) {
+        std::cerr << error.what() << std::endl << aisdi::bench::usage(argv[0]) << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (config.help) {
+        std::cout << aisdi::bench::usage(argv[0]) << std::endl;
+        return EXIT_SUCCESS;
+    }
+    std::cout << "Testing for " << config.repetitions << " iterations after " << config.warmups
+              << " warmup runs..." << std::endl;
+    const std::vector<aisdi::bench::Result> results = buildSuite().run(config, std::cout);
+    aisdi::bench::printResults(results, std::cout);
+    if (!config.csvPath.empty() && !writeReport(config.csvPath, results, aisdi::bench::writeCsv)) {
+        return EXIT_FAILURE;
+    }
+    if (!config.jsonPath.empty() && !writeReport(config.jsonPath, results, aisdi::bench::writeJson)) {
+        return EXIT_FAILURE;
     }
-    stats.print_results();
     return 0;
 }
@@ -0,0 +1,292 @@
+#include <AdaptiveSequence.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+template <typename T>
+using LinearCollection = aisdi::AdaptiveSequence<T>;
+
+using Layout = aisdi::SequenceLayout;
+
+using TestedTypes = boost::mpl::list<std::int32_t,
+                                     std::uint64_t,
+                                     std::complex<std::int32_t>>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(AdaptiveSequenceTests)
+
+template <typename T>
+void thenCollectionContainsValues(const LinearCollection<T>& collection,
+                                  std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL(collection.getSize(), expected.size());
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmptyAndContiguous,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.getLayout() == Layout::Contiguous);
+  BOOST_CHECK_THROW(*collection.begin(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenPopping_ThenExceptionIsThrown,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+
+  BOOST_CHECK_THROW(collection.popFirst(), std::logic_error);
+  BOOST_CHECK_THROW(collection.popLast(), std::logic_error);
+  BOOST_CHECK_THROW(collection.insert(collection.cbegin() + 1, T(1)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEachLayout_WhenEditing_ThenContentsAreTheSame,
+                              T,
+                              TestedTypes)
+{
+  for (Layout layout : { Layout::Contiguous, Layout::Ring, Layout::Gap, Layout::Chunked }) {
+    LinearCollection<T> collection{layout};
+    collection.setAdaptive(false);
+
+    collection.append(2);
+    collection.append(4);
+    collection.prepend(1);
+    collection.insert(collection.cbegin() + 2, 3);
+    collection.append(5);
+    collection.append(6);
+
+    BOOST_CHECK_EQUAL(collection.popFirst(), T(1));
+    BOOST_CHECK_EQUAL(collection.popLast(), T(6));
+    collection.erase(collection.cbegin() + 1);
+    thenCollectionContainsValues(collection, { 2, 4, 5 });
+    collection.erase(collection.cbegin(), collection.cend());
+    BOOST_CHECK(collection.isEmpty());
+    BOOST_CHECK(collection.getStats().switches == 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCopiedAndMoved_ThenLayoutIsKept,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  collection.setLayout(Layout::Gap);
+
+  LinearCollection<T> copy = collection;
+  LinearCollection<T> moved = std::move(collection);
+  LinearCollection<T> assigned;
+  assigned = copy;
+  copy.append(4);
+
+  BOOST_CHECK(copy.getLayout() == Layout::Gap);
+  BOOST_CHECK(moved.getLayout() == Layout::Gap);
+  thenCollectionContainsValues(copy, { 1, 2, 3, 4 });
+  thenCollectionContainsValues(moved, { 1, 2, 3 });
+  thenCollectionContainsValues(assigned, { 1, 2, 3 });
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenAppendsAndReads_WhenObserved_ThenLayoutStaysContiguous)
+{
+  LinearCollection<int> collection;
+  long sum = 0;
+
+  for (int i = 0; i < 10000; ++i) {
+    collection.append(i);
+    sum += collection[i / 2];
+  }
+
+  BOOST_CHECK(collection.getLayout() == Layout::Contiguous);
+  BOOST_CHECK_EQUAL(collection.getStats().switches, 0);
+  BOOST_CHECK_EQUAL(collection.getStats().backEdits, 10000);
+  BOOST_CHECK_EQUAL(collection.getStats().reads, 10000);
+  BOOST_CHECK(sum > 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenConstSequence_WhenRead_ThenNothingIsCounted)
+{
+  LinearCollection<int> collection{Layout::Chunked};
+  for (int i = 0; i < 1000; ++i) {
+    collection.append(i);
+  }
+  const LinearCollection<int>& reader = collection;
+  const std::size_t edits = collection.getStats().backEdits;
+
+  long sum = reader[500];
+  for (int value : reader) {
+    sum += value;
+  }
+
+  BOOST_CHECK_EQUAL(sum, 500 + 999 * 1000 / 2);
+  BOOST_CHECK_EQUAL(collection.getStats().reads, 0);
+  BOOST_CHECK_EQUAL(collection.getStats().backEdits, edits);
+  BOOST_CHECK_EQUAL(collection[500], 500);
+  BOOST_CHECK_EQUAL(collection.getStats().reads, 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenIteratorIntoChunkedLayout_WhenSequenceChanges_ThenItStillReadsByIndex)
+{
+  LinearCollection<int> collection{Layout::Chunked};
+  collection.setAdaptive(false);
+  for (int i = 0; i < 1000; ++i) {
+    collection.append(i);
+  }
+  const auto position = collection.cbegin() + 900;
+  BOOST_CHECK_EQUAL(*position, 900);
+
+  collection.erase(collection.cbegin() + 500, collection.cend());
+  collection.erase(collection.cbegin(), collection.cbegin() + 100);
+  for (int i = 0; i < 600; ++i) {
+    collection.append(-i);
+  }
+
+  BOOST_CHECK_EQUAL(*position, -500);
+}
+
+BOOST_AUTO_TEST_CASE(GivenQueueTraffic_WhenObserved_ThenRingBufferIsChosen)
+{
+  LinearCollection<int> collection;
+  for (int i = 0; i < 1000; ++i) {
+    collection.append(i);
+  }
+
+  for (int i = 1000; i < 3000; ++i) {
+    BOOST_CHECK_EQUAL(collection.popFirst(), i - 1000);
+    collection.append(i);
+  }
+
+  BOOST_CHECK(collection.getLayout() == Layout::Ring);
+  BOOST_CHECK_EQUAL(collection.getStats().switches, 1);
+  BOOST_CHECK(collection.getStats().windowCosts[std::size_t(Layout::Ring)]
+              < collection.getStats().windowCosts[std::size_t(Layout::Contiguous)]);
+  BOOST_CHECK_EQUAL(collection.getSize(), 1000);
+  BOOST_CHECK_EQUAL(collection[0], 2000);
+}
+
+BOOST_AUTO_TEST_CASE(GivenTypingAtOneSpot_WhenObserved_ThenGapBufferIsChosen)
+{
+  LinearCollection<int> collection;
+  for (int i = 0; i < 1000; ++i) {
+    collection.append(0);
+  }
+
+  for (int i = 0; i < 1000; ++i) {
+    collection.insert(collection.cbegin() + 500 + i, i + 1);
+  }
+
+  BOOST_CHECK(collection.getLayout() == Layout::Gap);
+  BOOST_CHECK_EQUAL(collection.getSize(), 2000);
+  BOOST_CHECK_EQUAL(collection[499], 0);
+  BOOST_CHECK_EQUAL(collection[500], 1);
+  BOOST_CHECK_EQUAL(collection[1499], 1000);
+  BOOST_CHECK_EQUAL(collection[1500], 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenScatteredInserts_WhenObserved_ThenChunkedListIsChosen)
+{
+  LinearCollection<int> collection;
+  std::vector<int> expected;
+  std::mt19937 random(42);
+  for (int i = 0; i < 20000; ++i) {
+    collection.append(i);
+    expected.push_back(i);
+  }
+
+  for (int i = 0; i < 2000; ++i) {
+    std::size_t index = random() % expected.size();
+    collection.insert(collection.cbegin() + index, -i);
+    expected.insert(expected.begin() + index, -i);
+  }
+
+  BOOST_CHECK(collection.getLayout() == Layout::Chunked);
+  BOOST_CHECK_EQUAL(collection.getStats().middleEdits, 2000);
+  BOOST_CHECK_EQUAL_COLLECTIONS(collection.begin(), collection.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(GivenPinnedLayout_WhenTrafficFavoursOther_ThenLayoutIsKept)
+{
+  LinearCollection<int> collection;
+  collection.setAdaptive(false);
+  for (int i = 0; i < 1000; ++i) {
+    collection.append(i);
+  }
+
+  for (int i = 0; i < 1000; ++i) {
+    collection.popFirst();
+    collection.append(i);
+  }
+
+  BOOST_CHECK(collection.getLayout() == Layout::Contiguous);
+  BOOST_CHECK_EQUAL(collection.getStats().switches, 0);
+  BOOST_CHECK(collection.getStats().windowCosts[std::size_t(Layout::Ring)]
+              < collection.getStats().windowCosts[std::size_t(Layout::Contiguous)]);
+}
+
+BOOST_AUTO_TEST_CASE(GivenRandomEdits_WhenAppliedToEveryLayout_ThenTheyMatchStdVector)
+{
+  for (Layout layout : { Layout::Contiguous, Layout::Ring, Layout::Gap, Layout::Chunked }) {
+    LinearCollection<std::string> collection{layout};
+    collection.setAdaptive(false);
+    std::vector<std::string> expected;
+    std::mt19937 random(42);
+
+    for (int i = 0; i < 5000; ++i) {
+      std::size_t size = expected.size();
+      std::size_t index = size == 0 ? 0 : random() % size;
+      std::string value(20, char('a' + i % 26));
+      switch (random() % 6) {
+        case 0:
+          collection.append(value);
+          expected.push_back(value);
+          break;
+        case 1:
+          collection.prepend(value);
+          expected.insert(expected.begin(), value);
+          break;
+        case 2:
+        case 3:
+          collection.insert(collection.cbegin() + index, value);
+          expected.insert(expected.begin() + index, value);
+          break;
+        case 4:
+          if (size > 0) {
+            std::size_t length = std::min<std::size_t>(random() % 100, size - index);
+            collection.erase(collection.cbegin() + index, collection.cbegin() + index + length);
+            expected.erase(expected.begin() + index, expected.begin() + index + length);
+          }
+          break;
+        default:
+          if (size > 0) {
+            BOOST_REQUIRE_EQUAL(collection.popFirst(), expected.front());
+            expected.erase(expected.begin());
+          }
+          break;
+      }
+      BOOST_REQUIRE_EQUAL(collection.getSize(), expected.size());
+    }
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(collection.begin(), collection.end(), expected.begin(), expected.end());
+    collection.setLayout(Layout(std::size_t(layout) == 3 ? 0 : std::size_t(layout) + 1));
+    BOOST_CHECK_EQUAL_COLLECTIONS(collection.begin(), collection.end(), expected.begin(), expected.end());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,180 @@
+#include <Arena.h>
+#include <Vector.h>
+#include <LinkedList.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+namespace
+{
+
+using aisdi::Arena;
+using aisdi::ArenaAllocator;
+
+bool isAlignedTo(const void* address, std::size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(address) % alignment == 0;
+}
+
+bool isInside(const void* address, const char* begin, std::size_t size)
+{
+  const char* byte = static_cast<const char*>(address);
+  return byte >= begin && byte < begin + size;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ArenaTests)
+
+BOOST_AUTO_TEST_CASE(GivenArena_WhenCreatedWithZeroChunkSize_ThenExceptionIsThrown)
+{
+  BOOST_CHECK_THROW(Arena(0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyArena_WhenAllocating_ThenMemoryIsAlignedAndDistinct)
+{
+  Arena arena(256);
+
+  void* first = arena.allocate(3, 1);
+  void* second = arena.allocate(8, 8);
+  void* third = arena.allocate(16, 64);
+
+  BOOST_CHECK(isAlignedTo(second, 8));
+  BOOST_CHECK(isAlignedTo(third, 64));
+  BOOST_CHECK(static_cast<char*>(second) >= static_cast<char*>(first) + 3);
+  BOOST_CHECK(static_cast<char*>(third) >= static_cast<char*>(second) + 8);
+  BOOST_CHECK_EQUAL(arena.getUsedBytes(), 27);
+}
+
+BOOST_AUTO_TEST_CASE(GivenFullChunk_WhenAllocating_ThenNewChunkIsReserved)
+{
+  Arena arena(256);
+
+  arena.allocate(200);
+  const std::size_t reserved = arena.getReservedBytes();
+  arena.allocate(200);
+
+  BOOST_CHECK_EQUAL(arena.getReservedBytes(), 2 * reserved);
+}
+
+BOOST_AUTO_TEST_CASE(GivenArena_WhenAllocatingMoreThanChunk_ThenItGetsChunkOfItsOwn)
+{
+  Arena arena(256);
+
+  char* memory = static_cast<char*>(arena.allocate(4096));
+  memory[0] = memory[4095] = 'x';
+
+  BOOST_CHECK(arena.getReservedBytes() > 4096);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSeededArena_WhenAllocatingWithinBuffer_ThenNoChunkIsReserved)
+{
+  alignas(std::max_align_t) char buffer[128];
+  Arena arena(buffer, sizeof(buffer));
+
+  void* first = arena.allocate(64);
+  void* second = arena.allocate(32);
+
+  BOOST_CHECK(isInside(first, buffer, sizeof(buffer)));
+  BOOST_CHECK(isInside(second, buffer, sizeof(buffer)));
+  BOOST_CHECK_EQUAL(arena.getReservedBytes(), sizeof(buffer));
+}
+
+BOOST_AUTO_TEST_CASE(GivenSeededArena_WhenBufferIsExhausted_ThenChunksAreUsed)
+{
+  alignas(std::max_align_t) char buffer[128];
+  Arena arena(buffer, sizeof(buffer), 256);
+
+  arena.allocate(100);
+  void* spilled = arena.allocate(100);
+
+  BOOST_CHECK(!isInside(spilled, buffer, sizeof(buffer)));
+  BOOST_CHECK(arena.getReservedBytes() > sizeof(buffer));
+}
+
+BOOST_AUTO_TEST_CASE(GivenUsedArena_WhenResetting_ThenEverythingIsReleasedAtOnce)
+{
+  alignas(std::max_align_t) char buffer[128];
+  Arena arena(buffer, sizeof(buffer), 256);
+  arena.allocate(100);
+  arena.allocate(1000);
+
+  arena.reset();
+
+  BOOST_CHECK_EQUAL(arena.getUsedBytes(), 0);
+  BOOST_CHECK_EQUAL(arena.getReservedBytes(), sizeof(buffer));
+  BOOST_CHECK(isInside(arena.allocate(64), buffer, sizeof(buffer)));
+}
+
+BOOST_AUTO_TEST_CASE(GivenAllocators_WhenComparing_ThenTheyAreEqualForSameArena)
+{
+  Arena arena;
+  Arena other;
+
+  const ArenaAllocator<int> allocator(arena);
+  const ArenaAllocator<double> rebound(allocator);
+
+  BOOST_CHECK(allocator == rebound);
+  BOOST_CHECK(allocator != ArenaAllocator<int>(other));
+  BOOST_CHECK(aisdi::AllocatorReleasesInBulk<ArenaAllocator<int>>::value);
+  BOOST_CHECK(!aisdi::AllocatorReleasesInBulk<std::allocator<int>>::value);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVectorInArena_WhenGrowing_ThenElementsAreKeptAndMemoryComesFromArena)
+{
+  Arena arena;
+  aisdi::Vector<int, ArenaAllocator<int>> collection{ArenaAllocator<int>(arena)};
+
+  for (int i = 0; i < 1000; ++i) {
+    collection.append(i);
+  }
+  collection.erase(collection.begin(), collection.begin() + 500);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 500);
+  BOOST_CHECK_EQUAL(*collection.begin(), 500);
+  BOOST_CHECK_EQUAL(collection.sum(), 374750);
+  BOOST_CHECK(arena.getUsedBytes() >= 1000 * sizeof(int));
+}
+
+BOOST_AUTO_TEST_CASE(GivenLinkedListInArena_WhenErasing_ThenRemainingElementsAreKept)
+{
+  Arena arena;
+  aisdi::LinkedList<int, ArenaAllocator<int>> collection{ArenaAllocator<int>(arena)};
+
+  for (int i = 0; i < 100; ++i) {
+    collection.append(i);
+  }
+  collection.erase(collection.begin(), collection.begin() + 90);
+  collection.popFirst();
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 9);
+  BOOST_CHECK_EQUAL(*collection.begin(), 91);
+  BOOST_CHECK(arena.getUsedBytes() > 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollectionsOfStringsInArena_WhenDestroyed_ThenElementDestructorsStillRun)
+{
+  const std::string longText(100, 'x');
+  Arena arena;
+  {
+    aisdi::Vector<std::string, ArenaAllocator<std::string>> vector{ArenaAllocator<std::string>(arena)};
+    aisdi::LinkedList<std::string, ArenaAllocator<std::string>> list{ArenaAllocator<std::string>(arena)};
+    for (int i = 0; i < 10; ++i) {
+      vector.append(longText);
+      list.append(longText);
+    }
+    list.erase(list.begin(), list.begin() + 5);
+
+    BOOST_CHECK_EQUAL(vector.getSize(), 10);
+    BOOST_CHECK_EQUAL(list.getSize(), 5);
+  }
+  arena.reset();
+
+  BOOST_CHECK_EQUAL(arena.getUsedBytes(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,257 @@
+#include <Benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+using aisdi::bench::Config;
+using aisdi::bench::Histogram;
+using aisdi::bench::Result;
+using aisdi::bench::Sample;
+using aisdi::bench::Suite;
+
+BOOST_AUTO_TEST_SUITE(BenchmarkTests)
+
+namespace
+{
+
+Config parse(std::vector<const char*> arguments)
+{
+  arguments.insert(arguments.begin(), "aisdiLinear");
+  return aisdi::bench::parseArguments(int(arguments.size()), arguments.data());
+}
+
+Sample fixedSample(std::size_t nanos, std::size_t operations)
+{
+  return Sample{std::chrono::duration_cast<aisdi::bench::Clock::duration>(std::chrono::nanoseconds(nanos)),
+                operations, {}};
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(GivenNoArguments_WhenParsing_ThenDefaultsAreUsed)
+{
+  const Config config = parse({});
+
+  BOOST_CHECK_EQUAL(config.repetitions, 5);
+  BOOST_CHECK_EQUAL(config.warmups, 1);
+  BOOST_CHECK_EQUAL(config.sizes.size(), 5);
+  BOOST_CHECK(config.filter.empty());
+  BOOST_CHECK(!config.help);
+}
+
+BOOST_AUTO_TEST_CASE(GivenOptions_WhenParsing_ThenTheyAreApplied)
+{
+  const Config config = parse({ "--repetitions=7", "--warmup=0", "--sizes=5,50,500", "--filter=vector/" });
+  const std::vector<std::size_t> sizes = { 5, 50, 500 };
+
+  BOOST_CHECK_EQUAL(config.repetitions, 7);
+  BOOST_CHECK_EQUAL(config.warmups, 0);
+  BOOST_CHECK_EQUAL_COLLECTIONS(config.sizes.begin(), config.sizes.end(), sizes.begin(), sizes.end());
+  BOOST_CHECK_EQUAL(config.filter, "vector/");
+}
+
+BOOST_AUTO_TEST_CASE(GivenBareNumber_WhenParsing_ThenItIsRepetitionCount)
+{
+  BOOST_CHECK_EQUAL(parse({ "12" }).repetitions, 12);
+  BOOST_CHECK(parse({ "--help" }).help);
+}
+
+BOOST_AUTO_TEST_CASE(GivenInvalidArguments_WhenParsing_ThenExceptionIsThrown)
+{
+  BOOST_CHECK_THROW(parse({ "--repetitions=0" }), std::invalid_argument);
+  BOOST_CHECK_THROW(parse({ "--repetitions=-3" }), std::invalid_argument);
+  BOOST_CHECK_THROW(parse({ "--warmup=x" }), std::invalid_argument);
+  BOOST_CHECK_THROW(parse({ "--sizes=10,,20" }), std::invalid_argument);
+  BOOST_CHECK_THROW(parse({ "--sizes=0" }), std::invalid_argument);
+  BOOST_CHECK_THROW(parse({ "--sizes=10k" }), std::invalid_argument);
+  BOOST_CHECK_THROW(parse({ "--unknown" }), std::invalid_argument);
+  BOOST_CHECK_THROW(parse({ "--csv=" }), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(GivenReportPaths_WhenParsing_ThenTheyAreKept)
+{
+  const Config config = parse({ "--csv=out.csv", "--json=out.json" });
+
+  BOOST_CHECK_EQUAL(config.csvPath, "out.csv");
+  BOOST_CHECK_EQUAL(config.jsonPath, "out.json");
+}
+
+BOOST_AUTO_TEST_CASE(GivenSuite_WhenRun_ThenEveryCaseRunsWarmupsAndRepetitionsPerSize)
+{
+  Suite suite;
+  std::vector<std::size_t> calls;
+  suite.add("sized", [&calls](std::size_t size) {
+    calls.push_back(size);
+    return fixedSample(size * 10, size);
+  });
+  suite.addFixed("fixed", 1000, [&calls](std::size_t size) {
+    calls.push_back(size);
+    return fixedSample(500, 0);
+  });
+  Config config;
+  config.sizes = { 2, 4 };
+  config.repetitions = 3;
+  config.warmups = 1;
+  std::ostringstream progress;
+
+  const std::vector<Result> results = suite.run(config, progress);
+
+  BOOST_REQUIRE_EQUAL(results.size(), 3);
+  BOOST_CHECK_EQUAL(calls.size(), 12);
+  BOOST_CHECK_EQUAL(results[0].name, "sized");
+  BOOST_CHECK_EQUAL(results[1].size, 4);
+  BOOST_CHECK_EQUAL(results[1].count(), 3);
+  BOOST_CHECK_EQUAL(results[1].batches(), 3);
+  BOOST_CHECK_CLOSE(results[1].mean(), 10.0, 0.001);
+  BOOST_CHECK_EQUAL(results[2].size, 1000);
+  BOOST_CHECK_CLOSE(results[2].min(), 500.0, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(GivenLappedCase_WhenRun_ThenEveryOperationIsASample)
+{
+  Suite suite;
+  suite.add("lapped", [](std::size_t size) {
+    Sample sample = fixedSample(1000 * size, size);
+    for (std::size_t i = 0; i < size; ++i) {
+      const std::size_t nanos = i + 1 == size ? 100000 : 100;
+      sample.laps.push_back(std::chrono::duration_cast<aisdi::bench::Clock::duration>(std::chrono::nanoseconds(nanos)));
+    }
+    return sample;
+  });
+  Config config;
+  config.sizes = { 1000 };
+  config.repetitions = 2;
+  config.warmups = 0;
+  std::ostringstream progress;
+
+  const std::vector<Result> results = suite.run(config, progress);
+
+  BOOST_REQUIRE_EQUAL(results.size(), 1);
+  BOOST_CHECK_EQUAL(results[0].count(), 2000);
+  BOOST_CHECK_EQUAL(results[0].batches(), 2);
+  BOOST_CHECK_CLOSE(results[0].mean(), 1000.0, 0.001);
+  BOOST_CHECK_CLOSE(results[0].median(), 100.0, 0.001);
+  BOOST_CHECK_CLOSE(results[0].percentile(99.9), 100000.0, 1.6);
+  BOOST_CHECK_CLOSE(results[0].max(), 100000.0, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(GivenStopwatch_WhenLapped_ThenEveryLapIsKept)
+{
+  aisdi::bench::Stopwatch watch(3);
+  for (int i = 0; i < 3; ++i) {
+    watch.lap();
+  }
+
+  const Sample sample = watch.stop(3);
+
+  BOOST_CHECK_EQUAL(sample.laps.size(), 3);
+  aisdi::bench::Clock::duration lapped(0);
+  for (aisdi::bench::Clock::duration lap : sample.laps) {
+    lapped += lap;
+  }
+  BOOST_CHECK(lapped <= sample.elapsed);
+}
+
+BOOST_AUTO_TEST_CASE(GivenFilter_WhenRun_ThenOnlyMatchingCasesRun)
+{
+  Suite suite;
+  std::size_t calls = 0;
+  suite.add("vector/append", [&calls](std::size_t) { ++calls; return fixedSample(1, 1); });
+  suite.add("linked_list/append", [&calls](std::size_t) { ++calls; return fixedSample(1, 1); });
+  Config config;
+  config.sizes = { 1 };
+  config.repetitions = 1;
+  config.warmups = 0;
+  config.filter = "linked";
+  std::ostringstream progress;
+
+  const std::vector<Result> results = suite.run(config, progress);
+
+  BOOST_REQUIRE_EQUAL(results.size(), 1);
+  BOOST_CHECK_EQUAL(results[0].name, "linked_list/append");
+  BOOST_CHECK_EQUAL(calls, 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSmallValues_WhenRecorded_ThenHistogramIsExact)
+{
+  Histogram histogram;
+  for (std::uint64_t value = 1; value <= 100; ++value) {
+    histogram.record(value);
+  }
+
+  BOOST_CHECK_EQUAL(histogram.count(), 100);
+  BOOST_CHECK_EQUAL(histogram.min(), 1);
+  BOOST_CHECK_EQUAL(histogram.max(), 100);
+  BOOST_CHECK_EQUAL(histogram.valueAtQuantile(0.5), 50);
+  BOOST_CHECK_EQUAL(histogram.valueAtQuantile(0.9), 90);
+  BOOST_CHECK_EQUAL(histogram.valueAtQuantile(0.99), 99);
+  BOOST_CHECK_EQUAL(histogram.valueAtQuantile(1.0), 100);
+}
+
+BOOST_AUTO_TEST_CASE(GivenLargeValues_WhenRecorded_ThenRelativeErrorIsBounded)
+{
+  for (std::uint64_t value = 100; value < (std::uint64_t(1) << 40); value = value * 3 + 7) {
+    Histogram histogram;
+    histogram.record(value - 1);
+    histogram.record(value);
+    histogram.record(value * 2);
+
+    const double reported = double(histogram.valueAtQuantile(0.5));
+    BOOST_CHECK_SMALL((reported - value) / value, 0.016);
+    BOOST_CHECK(Histogram::bucketLow(Histogram::bucketOf(value)) <= value);
+    BOOST_CHECK(Histogram::bucketHigh(Histogram::bucketOf(value)) >= value);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenSamples_WhenSummarised_ThenStatisticsAndOutliersAreReported)
+{
+  aisdi::bench::Result result("case", 10);
+  for (int i = 0; i < 99; ++i) {
+    result.add(10.0 + (i % 3));
+    result.addBatch(10.0 + (i % 3));
+  }
+  result.add(1000.0);
+  result.addBatch(1000.0);
+
+  BOOST_CHECK_EQUAL(result.count(), 100);
+  BOOST_CHECK_EQUAL(result.batches(), 100);
+  BOOST_CHECK_CLOSE(result.min(), 10.0, 0.001);
+  BOOST_CHECK_CLOSE(result.max(), 1000.0, 0.001);
+  BOOST_CHECK_CLOSE(result.median(), 11.0, 1.6);
+  BOOST_CHECK_CLOSE(result.percentile(99.9), 1000.0, 0.001);
+  BOOST_CHECK_CLOSE(result.mean(), (99 * 11.0 + 1000.0) / 100, 0.001);
+  BOOST_CHECK(result.stddev() > 90 && result.stddev() < 110);
+  BOOST_CHECK_EQUAL(result.outliers().low, 0);
+  BOOST_CHECK_EQUAL(result.outliers().high, 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenResults_WhenWrittenAsCsvAndJson_ThenEveryResultIsPresent)
+{
+  std::vector<Result> results;
+  results.push_back(Result("vector/append", 10));
+  results.push_back(Result("odd \"name\", quoted", 20));
+  results[0].add(1.5);
+  results[0].addBatch(1.5);
+  results[1].add(2.5);
+  std::ostringstream csv;
+  std::ostringstream json;
+
+  aisdi::bench::writeCsv(results, csv);
+  aisdi::bench::writeJson(results, json);
+
+  BOOST_CHECK_EQUAL(csv.str().find("benchmark,size,samples,batches,min_ns,median_ns,p90_ns,p99_ns,p999_ns"), 0);
+  BOOST_CHECK(csv.str().find("\nvector/append,10,1,1,1.500,1.500,") != std::string::npos);
+  BOOST_CHECK(csv.str().find("\n\"odd \"\"name\"\", quoted\",20,1,0,2.500,") != std::string::npos);
+  BOOST_CHECK(json.str().find("{\"name\":\"vector/append\",\"size\":10,\"samples\":1,\"batches\":1,\"min_ns\":1.500") != std::string::npos);
+  BOOST_CHECK(json.str().find("\"name\":\"odd \\\"name\\\", quoted\"") != std::string::npos);
+  BOOST_CHECK(json.str().find("\"histogram\":[[1.488,1.503,1]]") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
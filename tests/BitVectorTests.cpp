@@ -0,0 +1,221 @@
+#include <BitVector.h>
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+namespace
+{
+
+using aisdi::BitVector;
+
+void thenCollectionContainsValues(const BitVector& collection, std::initializer_list<bool> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(collection.begin(), collection.end(), expected.begin(), expected.end());
+}
+
+BitVector patternOf(std::size_t size, std::size_t step)
+{
+  BitVector bits(size);
+  for (std::size_t i = 0; i < size; i += step) {
+    bits.set(i);
+  }
+  return bits;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(BitVectorTests)
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty)
+{
+  const BitVector bits;
+
+  BOOST_CHECK(bits.isEmpty());
+  BOOST_CHECK(bits.begin() == bits.end());
+  BOOST_CHECK_EQUAL(bits.count(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCreatedWithSizeAndValue_ThenAllBitsHaveThatValue)
+{
+  const BitVector bits(130, true);
+
+  BOOST_CHECK_EQUAL(bits.getSize(), 130);
+  BOOST_CHECK_EQUAL(bits.getWordCount(), 3);
+  BOOST_CHECK_EQUAL(bits.count(), 130);
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyCollection_WhenAppendingBits_ThenTheyArePackedIntoWords)
+{
+  BitVector bits;
+
+  for (int i = 0; i < 200; ++i) {
+    bits.append(i % 3 == 0);
+  }
+
+  BOOST_CHECK_EQUAL(bits.getSize(), 200);
+  BOOST_CHECK_EQUAL(bits.getWordCount(), 4);
+  BOOST_CHECK_EQUAL(bits.count(), 67);
+  BOOST_CHECK(bits.get(198));
+  BOOST_CHECK(!bits.get(199));
+}
+
+BOOST_AUTO_TEST_CASE(GivenReference_WhenAssigning_ThenBitIsChanged)
+{
+  BitVector bits = { false, false, true };
+
+  bits[0] = true;
+  bits[2] = bits[1];
+  *(bits.begin() + 1) = true;
+
+  thenCollectionContainsValues(bits, { true, true, false });
+  BOOST_CHECK_THROW(bits[3], std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonEmptyCollection_WhenInsertingAcrossWords_ThenLaterBitsAreShifted)
+{
+  BitVector bits = patternOf(130, 2);
+
+  bits.insert(bits.begin() + 1, true);
+  bits.prepend(false);
+
+  BOOST_CHECK_EQUAL(bits.getSize(), 132);
+  BOOST_CHECK_EQUAL(bits.count(), 66);
+  BOOST_CHECK(!bits.get(0));
+  BOOST_CHECK(bits.get(1));
+  BOOST_CHECK(bits.get(2));
+  BOOST_CHECK(!bits.get(3));
+  BOOST_CHECK(bits.get(4));
+  BOOST_CHECK(bits.get(130));
+  BOOST_CHECK(!bits.get(131));
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonEmptyCollection_WhenErasingRange_ThenLaterBitsAreShiftedDown)
+{
+  BitVector bits = patternOf(300, 3);
+
+  bits.erase(bits.begin() + 5, bits.begin() + 105);
+
+  BOOST_CHECK_EQUAL(bits.getSize(), 200);
+  for (std::size_t i = 0; i < bits.getSize(); ++i) {
+    const std::size_t original = i < 5 ? i : i + 100;
+    BOOST_CHECK_EQUAL(bits.get(i), original % 3 == 0);
+  }
+  BOOST_CHECK_EQUAL(bits.count(), 67);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonEmptyCollection_WhenPopping_ThenBitsAreRemovedAndReturned)
+{
+  BitVector bits = { true, false, false };
+
+  BOOST_CHECK_EQUAL(bits.popFirst(), true);
+  BOOST_CHECK_EQUAL(bits.popLast(), false);
+  thenCollectionContainsValues(bits, { false });
+  bits.erase(bits.begin());
+  BOOST_CHECK_THROW(bits.popLast(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSparseBits_WhenFindingSetBits_ThenAllAreVisitedInOrder)
+{
+  BitVector bits(1000);
+  const std::vector<std::size_t> expected = { 3, 64, 65, 500, 999 };
+  for (auto position : expected) {
+    bits.set(position);
+  }
+
+  std::vector<std::size_t> found;
+  for (auto it = bits.findFirst(); it != BitVector::npos; it = bits.findNext(it)) {
+    found.push_back(it);
+  }
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(found.begin(), found.end(), expected.begin(), expected.end());
+  BOOST_CHECK(BitVector(10).findFirst() == BitVector::npos);
+}
+
+BOOST_AUTO_TEST_CASE(GivenTwoCollections_WhenCombiningThem_ThenWordsAreCombined)
+{
+  const BitVector left = { true, true, false, false };
+  const BitVector right = { true, false, true, false };
+
+  thenCollectionContainsValues(left & right, { true, false, false, false });
+  thenCollectionContainsValues(left | right, { true, true, true, false });
+  thenCollectionContainsValues(left ^ right, { false, true, true, false });
+  BitVector shorter(3);
+  BOOST_CHECK_THROW(shorter &= left, std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(GivenBits_WhenRanking_ThenSetBitsBeforePositionAreCounted)
+{
+  const BitVector bits = patternOf(5000, 3);
+
+  for (std::size_t position = 0; position <= 5000; position += 7) {
+    BOOST_CHECK_EQUAL(bits.rank(position), (position + 2) / 3);
+  }
+  BOOST_CHECK_EQUAL(bits.rank(5000), bits.count());
+}
+
+BOOST_AUTO_TEST_CASE(GivenRankIndex_WhenRanking_ThenSetBitsBeforePositionAreCounted)
+{
+  BitVector bits = patternOf(5000, 3);
+  bits.buildRankIndex();
+  const BitVector& indexed = bits;
+
+  for (std::size_t position = 0; position <= 5000; position += 7) {
+    BOOST_CHECK_EQUAL(indexed.rank(position), (position + 2) / 3);
+  }
+  BOOST_CHECK_EQUAL(indexed.select(100), 300);
+}
+
+BOOST_AUTO_TEST_CASE(GivenRankIndex_WhenModifyingBits_ThenStaleIndexIsNotUsed)
+{
+  BitVector bits = patternOf(5000, 3);
+  bits.buildRankIndex();
+
+  bits.set(1);
+  bits.flip(0);
+
+  BOOST_CHECK_EQUAL(bits.rank(4000), 4000 / 3 + 1);
+  BOOST_CHECK_EQUAL(bits.select(0), 1);
+  bits.buildRankIndex();
+  BOOST_CHECK_EQUAL(bits.rank(4000), 4000 / 3 + 1);
+  BOOST_CHECK_EQUAL(bits.select(0), 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenBits_WhenSelecting_ThenPositionOfKthSetBitIsReturned)
+{
+  BitVector bits = patternOf(5000, 3);
+
+  for (std::size_t k = 0; k < bits.count(); k += 11) {
+    BOOST_CHECK_EQUAL(bits.select(k), 3 * k);
+  }
+  BOOST_CHECK_THROW(bits.select(bits.count()), std::out_of_range);
+
+  bits.set(1);
+  BOOST_CHECK_EQUAL(bits.select(1), 1);
+  BOOST_CHECK_EQUAL(bits.rank(4), 3);
+}
+
+BOOST_AUTO_TEST_CASE(GivenIterators_WhenAdvancingAndComparing_ThenTheyActAsRandomAccessIterators)
+{
+  BitVector bits = patternOf(200, 3);
+
+  const auto it = std::next(bits.cbegin(), 99);
+  auto mutableIt = bits.begin();
+  std::advance(mutableIt, 150);
+  mutableIt -= 50;
+  mutableIt[1] = true;
+
+  BOOST_CHECK(*it);
+  BOOST_CHECK(it[3]);
+  BOOST_CHECK(!it[1]);
+  BOOST_CHECK(bits.get(101));
+  BOOST_CHECK(it < mutableIt);
+  BOOST_CHECK(mutableIt >= it);
+  BOOST_CHECK_EQUAL(std::distance(bits.cbegin(), it), 99);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,199 @@
+#include <CompressedIntVector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+namespace
+{
+
+using aisdi::CompressedIntVector;
+
+void thenCollectionContainsValues(const CompressedIntVector& collection,
+                                  std::initializer_list<std::uint64_t> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(collection.begin(), collection.end(), expected.begin(), expected.end());
+}
+
+std::vector<std::uint64_t> sortedValues(std::size_t count)
+{
+  std::vector<std::uint64_t> values;
+  std::uint64_t value = 1000;
+  for (std::size_t i = 0; i < count; ++i) {
+    value += (i * 7919) % 13;
+    values.push_back(value);
+  }
+  return values;
+}
+
+CompressedIntVector compressedOf(const std::vector<std::uint64_t>& values)
+{
+  CompressedIntVector collection;
+  for (std::uint64_t value : values) {
+    collection.append(value);
+  }
+  return collection;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(CompressedIntVectorTests)
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty)
+{
+  const CompressedIntVector collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+  BOOST_CHECK_EQUAL(collection.getCompressedBytes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCreatedWithInitializerList_ThenItContainsValues)
+{
+  const CompressedIntVector collection = { 1, 1, 5, 90, 1ULL << 40 };
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 5);
+  thenCollectionContainsValues(collection, { 1, 1, 5, 90, 1ULL << 40 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonEmptyCollection_WhenAppendingSmallerValue_ThenExceptionIsThrown)
+{
+  CompressedIntVector collection = { 10, 20 };
+
+  BOOST_CHECK_THROW(collection.append(19), std::invalid_argument);
+  BOOST_CHECK_EQUAL(collection.getSize(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(GivenManyValues_WhenIterating_ThenAllAreDecodedInOrder)
+{
+  const std::vector<std::uint64_t> values = sortedValues(1000);
+  const CompressedIntVector collection = compressedOf(values);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), values.size());
+  BOOST_CHECK_EQUAL_COLLECTIONS(collection.begin(), collection.end(), values.begin(), values.end());
+}
+
+BOOST_AUTO_TEST_CASE(GivenManyValues_WhenGettingByIndex_ThenValueIsReturned)
+{
+  const std::vector<std::uint64_t> values = sortedValues(1000);
+  const CompressedIntVector collection = compressedOf(values);
+
+  for (std::size_t i = 0; i < values.size(); i += 37) {
+    BOOST_CHECK_EQUAL(collection.get(i), values[i]);
+  }
+  BOOST_CHECK_EQUAL(collection.get(999), values[999]);
+  BOOST_CHECK_THROW(collection.get(1000), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSmallDeltas_WhenCompressed_ThenItTakesFewBitsPerValue)
+{
+  const CompressedIntVector collection = compressedOf(sortedValues(1024));
+
+  // deltas are below 16, so every full block needs at most 4 bits per value
+  BOOST_CHECK_LE(collection.getCompressedBytes(), 8 * (1024 * 4 / 64 + 8 * 3));
+}
+
+BOOST_AUTO_TEST_CASE(GivenRepeatedValue_WhenCompressed_ThenBlocksHaveNoPayload)
+{
+  CompressedIntVector collection;
+
+  for (int i = 0; i < 300; ++i) {
+    collection.append(42);
+  }
+
+  BOOST_CHECK_EQUAL(collection.get(0), 42);
+  BOOST_CHECK_EQUAL(collection.get(255), 42);
+  BOOST_CHECK_EQUAL(collection.get(299), 42);
+  BOOST_CHECK_LT(collection.getCompressedBytes(), 64);
+}
+
+BOOST_AUTO_TEST_CASE(GivenRepeatedValueAfterPackedBlock_WhenDecoded_ThenNothingIsWrittenPastPayload)
+{
+  std::vector<std::uint64_t> values;
+  for (std::uint64_t i = 0; i < 128; ++i) {
+    values.push_back(i * 3);
+  }
+  // the first block fills the payload buffer exactly, the second one has no payload at all
+  values.resize(256, values.back());
+  values.push_back(values.back() + 1);
+
+  const CompressedIntVector collection = compressedOf(values);
+  aisdi::Vector<std::uint64_t> out;
+  collection.decodeInto(out);
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(out.begin(), out.end(), values.begin(), values.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(collection.begin(), collection.end(), values.begin(), values.end());
+  BOOST_CHECK_EQUAL(collection.get(200), values.back() - 1);
+  BOOST_CHECK_EQUAL(collection.lowerBound(values.back()), 256);
+}
+
+BOOST_AUTO_TEST_CASE(GivenFullWidthDeltas_WhenCompressed_ThenValuesAreKept)
+{
+  std::vector<std::uint64_t> values(1, 0);
+  for (int i = 1; i < 127; ++i) {
+    values.push_back(values.back() + (std::uint64_t(1) << 56));
+  }
+  // the jump to the maximum needs all 64 bits
+  values.resize(330, ~std::uint64_t(0));
+
+  const CompressedIntVector collection = compressedOf(values);
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(collection.begin(), collection.end(), values.begin(), values.end());
+}
+
+BOOST_AUTO_TEST_CASE(GivenManyValues_WhenSearchingLowerBound_ThenFirstNotSmallerIndexIsReturned)
+{
+  const std::vector<std::uint64_t> values = sortedValues(1000);
+  const CompressedIntVector collection = compressedOf(values);
+
+  for (std::uint64_t probe = 990; probe < values.back() + 3; probe += 5) {
+    std::size_t expected = std::lower_bound(values.begin(), values.end(), probe) - values.begin();
+    BOOST_CHECK_EQUAL(collection.lowerBound(probe), expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenRunsCrossingBlocks_WhenSearchingLowerBound_ThenFirstOccurrenceIsFound)
+{
+  CompressedIntVector collection;
+  for (int i = 0; i < 100; ++i) {
+    collection.append(1);
+  }
+  for (int i = 0; i < 200; ++i) {
+    collection.append(7);
+  }
+
+  BOOST_CHECK_EQUAL(collection.lowerBound(0), 0);
+  BOOST_CHECK_EQUAL(collection.lowerBound(2), 100);
+  BOOST_CHECK_EQUAL(collection.lowerBound(7), 100);
+  BOOST_CHECK_EQUAL(collection.lowerBound(8), 300);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenDecodingIntoVector_ThenValuesAreAppended)
+{
+  const std::vector<std::uint64_t> values = sortedValues(500);
+  const CompressedIntVector collection = compressedOf(values);
+  aisdi::Vector<std::uint64_t> out = { 1 };
+
+  collection.decodeInto(out);
+
+  BOOST_CHECK_EQUAL(out.getSize(), 501);
+  BOOST_CHECK_EQUAL(*out.begin(), 1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(out.begin() + 1, out.end(), values.begin(), values.end());
+}
+
+BOOST_AUTO_TEST_CASE(GivenEndIterator_WhenDereferencingOrIncrementing_ThenExceptionIsThrown)
+{
+  const CompressedIntVector collection = { 3 };
+
+  BOOST_CHECK_THROW(*collection.end(), std::out_of_range);
+  auto it = collection.end();
+  BOOST_CHECK_THROW(++it, std::out_of_range);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,184 @@
+#include <CowLinkedList.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+template <typename T>
+using LinearCollection = aisdi::CowLinkedList<T>;
+
+using TestedTypes = boost::mpl::list<std::int32_t,
+                                     std::uint64_t,
+                                     std::complex<std::int32_t>>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(CowLinkedListTests)
+
+template <typename T>
+void thenCollectionContainsValues(const LinearCollection<T>& collection,
+                                  std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL(collection.getSize(), expected.size());
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(!collection.isShared());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCopied_ThenNodesAreShared,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { 1, 2, 3 };
+
+  const LinearCollection<T> copy = collection;
+  LinearCollection<T> assigned;
+  assigned = copy;
+  const LinearCollection<T>& reader = assigned;
+
+  BOOST_CHECK(collection.isShared());
+  BOOST_CHECK(&*copy.begin() == &*collection.begin());
+  BOOST_CHECK(&*reader.begin() == &*collection.begin());
+  thenCollectionContainsValues(reader, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSharedCollection_WhenInsertingAtOldPosition_ThenCopyIsUpdatedAtSameIndex,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { 1, 3, 5 };
+  LinearCollection<T> copy = collection;
+
+  copy.insert(std::next(copy.cbegin(), 1), 2);
+  copy.insert(copy.cend(), 6);
+  copy.insert(std::next(copy.cbegin(), 3), 4);
+
+  thenCollectionContainsValues(collection, { 1, 3, 5 });
+  thenCollectionContainsValues(copy, { 1, 2, 3, 4, 5, 6 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSharedCollection_WhenErasing_ThenOnlyCopyChanges,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { 1, 2, 3, 4, 5 };
+  LinearCollection<T> first = collection;
+  LinearCollection<T> second = collection;
+
+  first.erase(std::next(first.cbegin(), 2));
+  second.erase(std::next(second.cbegin(), 1), std::next(second.cbegin(), 4));
+
+  thenCollectionContainsValues(collection, { 1, 2, 3, 4, 5 });
+  thenCollectionContainsValues(first, { 1, 2, 4, 5 });
+  thenCollectionContainsValues(second, { 1, 5 });
+  BOOST_CHECK(!collection.isShared());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSharedCollection_WhenPoppingOrAppending_ThenItDetaches,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { 1, 2, 3 };
+  LinearCollection<T> copy = collection;
+  LinearCollection<T> other = collection;
+
+  BOOST_CHECK_EQUAL(copy.popFirst(), T(1));
+  BOOST_CHECK_EQUAL(copy.popLast(), T(3));
+  other.append(4);
+  other.prepend(0);
+
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+  thenCollectionContainsValues(copy, { 2 });
+  thenCollectionContainsValues(other, { 0, 1, 2, 3, 4 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSharedCollection_WhenTakingNonConstIterator_ThenItDetaches,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { 1, 2, 3 };
+  LinearCollection<T> copy = collection;
+
+  *copy.begin() = T(7);
+
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+  thenCollectionContainsValues(copy, { 7, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenMovedAndMutated_ThenNodesAreNotCopied,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  const auto* first = &*collection.getList().begin();
+
+  LinearCollection<T> moved{std::move(collection)};
+  LinearCollection<T> assigned;
+  assigned = std::move(moved);
+  *assigned.begin() = T(4);
+
+  BOOST_CHECK(!assigned.isShared());
+  BOOST_CHECK(&*assigned.getList().begin() == first);
+  thenCollectionContainsValues(assigned, { 4, 2, 3 });
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(moved.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenSoleOwner_WhenErasing_ThenIteratorIsUsedDirectly)
+{
+  LinearCollection<std::string> collection = { "a", "b", "c" };
+  const std::string* last = &*std::next(collection.cbegin(), 2);
+
+  collection.erase(std::next(collection.cbegin(), 1));
+
+  BOOST_CHECK(&*std::next(collection.cbegin(), 1) == last);
+}
+
+BOOST_AUTO_TEST_CASE(GivenListHandedToManyConsumers_WhenTheyRead_ThenAllSeeSameNodes)
+{
+  LinearCollection<std::int32_t> collection;
+  for (std::int32_t i = 0; i < 10000; ++i) {
+    collection.append(i);
+  }
+  std::vector<std::int64_t> sums(16, 0);
+  std::vector<std::thread> consumers;
+
+  for (std::size_t i = 0; i < sums.size(); ++i) {
+    consumers.emplace_back([collection, &sums, i]() {
+      for (std::int32_t item : collection) {
+        sums[i] += item;
+      }
+    });
+  }
+  collection.append(10000);
+  for (std::thread& consumer : consumers) {
+    consumer.join();
+  }
+
+  for (std::int64_t sum : sums) {
+    BOOST_CHECK_EQUAL(sum, 49995000);
+  }
+  BOOST_CHECK_EQUAL(collection.getSize(), 10001);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,181 @@
+#include <CowVector.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+template <typename T>
+using LinearCollection = aisdi::CowVector<T>;
+
+using TestedTypes = boost::mpl::list<std::int32_t,
+                                     std::uint64_t,
+                                     std::complex<std::int32_t>>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(CowVectorTests)
+
+template <typename T>
+void thenCollectionContainsValues(const LinearCollection<T>& collection,
+                                  std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(!collection.isShared());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCopied_ThenBufferIsShared,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { 1, 2, 3 };
+
+  const LinearCollection<T> copy = collection;
+  LinearCollection<T> assigned;
+  assigned = copy;
+  const LinearCollection<T>& reader = assigned;
+
+  BOOST_CHECK(collection.isShared());
+  BOOST_CHECK(copy.data() == collection.data());
+  BOOST_CHECK(reader.data() == collection.data());
+  thenCollectionContainsValues(reader, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSharedCollection_WhenMutated_ThenOnlyMutatedCopyChanges,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  LinearCollection<T> copy = collection;
+
+  copy.insert(copy.cbegin() + 1, 4);
+  copy.erase(copy.cbegin());
+  copy.append(5);
+  copy.prepend(6);
+
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+  thenCollectionContainsValues(copy, { 6, 4, 2, 3, 5 });
+  BOOST_CHECK(!collection.isShared());
+  BOOST_CHECK(!copy.isShared());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSharedCollection_WhenPopping_ThenItDetaches,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  LinearCollection<T> copy = collection;
+
+  BOOST_CHECK_EQUAL(copy.popFirst(), T(1));
+  BOOST_CHECK_EQUAL(copy.popLast(), T(3));
+
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+  thenCollectionContainsValues(copy, { 2 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSharedCollection_WhenTakingNonConstIterator_ThenItDetaches,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  LinearCollection<T> copy = collection;
+
+  *copy.begin() = T(7);
+
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+  thenCollectionContainsValues(copy, { 7, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenMovedAndMutated_ThenBufferIsNotCopied,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  const auto* first = collection.getVector().data();
+
+  LinearCollection<T> moved{std::move(collection)};
+  LinearCollection<T> assigned;
+  assigned = std::move(moved);
+  *assigned.begin() = T(4);
+
+  BOOST_CHECK(!assigned.isShared());
+  BOOST_CHECK(assigned.getVector().data() == first);
+  thenCollectionContainsValues(assigned, { 4, 2, 3 });
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(moved.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSoleOwner_WhenMutated_ThenBufferIsNotCopied,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  const auto* buffer = collection.data();
+
+  *collection.begin() = T(4);
+
+  BOOST_CHECK(collection.data() == buffer);
+  thenCollectionContainsValues(collection, { 4, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollections_WhenComparing_ThenContentsDecide)
+{
+  const LinearCollection<std::string> collection = { "a", "b" };
+  const LinearCollection<std::string> copy = collection;
+  LinearCollection<std::string> other = { "a" };
+
+  BOOST_CHECK(collection == copy);
+  BOOST_CHECK(collection != other);
+  other.append("b");
+  BOOST_CHECK(collection == other);
+}
+
+BOOST_AUTO_TEST_CASE(GivenSnapshotsInOtherThreads_WhenOriginalIsModified_ThenSnapshotsStayIntact)
+{
+  LinearCollection<std::int32_t> collection;
+  for (std::int32_t i = 0; i < 1000; ++i) {
+    collection.append(i);
+  }
+  std::vector<std::int64_t> sums(8, 0);
+  std::vector<std::thread> readers;
+
+  for (std::size_t i = 0; i < sums.size(); ++i) {
+    const LinearCollection<std::int32_t> snapshot = collection;
+    readers.emplace_back([snapshot, &sums, i]() {
+      for (int round = 0; round < 100; ++round) {
+        const LinearCollection<std::int32_t> local = snapshot;
+        sums[i] = local.getVector().sum();
+      }
+    });
+    collection.append(0);
+    *collection.begin() = std::int32_t(i + 1);
+  }
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+
+  for (std::size_t i = 0; i < sums.size(); ++i) {
+    BOOST_CHECK_EQUAL(sums[i], 499500 + std::int64_t(i));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,162 @@
+#include <ForwardList.h>
+#include <Arena.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+template <typename T>
+using LinearCollection = aisdi::ForwardList<T>;
+
+using TestedTypes = boost::mpl::list<std::int32_t,
+                                     std::uint64_t,
+                                     std::complex<std::int32_t>>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(ForwardListTests)
+
+template <typename T>
+void thenCollectionContainsValues(const LinearCollection<T>& collection,
+                                  std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL(collection.getSize(), expected.size());
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+  BOOST_CHECK_THROW(*collection.begin(), std::out_of_range);
+  BOOST_CHECK_THROW(*collection.cbeforeBegin(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenAppendingAndPrepending_ThenOrderIsKept,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+
+  collection.append(2);
+  collection.append(3);
+  collection.prepend(1);
+  collection.append(4);
+
+  thenCollectionContainsValues(collection, { 1, 2, 3, 4 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenPoppingFirst_ThenElementsComeInOrder,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2 };
+
+  BOOST_CHECK_EQUAL(collection.popFirst(), T(1));
+  BOOST_CHECK_EQUAL(collection.popFirst(), T(2));
+  BOOST_CHECK_THROW(collection.popFirst(), std::logic_error);
+
+  collection.append(3);
+  thenCollectionContainsValues(collection, { 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenInsertingAfter_ThenElementFollowsPosition,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 3 };
+
+  auto inserted = collection.insertAfter(collection.begin(), 2);
+  collection.insertAfter(collection.beforeBegin(), 0);
+  collection.insertAfter(++++++collection.begin(), 4);
+  collection.append(5);
+
+  BOOST_CHECK_EQUAL(*inserted, T(2));
+  thenCollectionContainsValues(collection, { 0, 1, 2, 3, 4, 5 });
+  BOOST_CHECK_THROW(collection.insertAfter(collection.end(), 6), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenErasingAfter_ThenFollowingElementIsRemoved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  auto next = collection.eraseAfter(collection.begin());
+  BOOST_CHECK_EQUAL(*next, T(3));
+  collection.eraseAfter(collection.begin());
+  collection.append(4);
+  collection.eraseAfter(collection.beforeBegin());
+
+  thenCollectionContainsValues(collection, { 4 });
+  BOOST_CHECK_THROW(collection.eraseAfter(collection.begin()), std::out_of_range);
+  BOOST_CHECK_THROW(collection.eraseAfter(collection.end()), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCopiedAndMoved_ThenTailKeepsWorking,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> empty;
+  LinearCollection<T> collection = { 1, 2 };
+
+  LinearCollection<T> copy = collection;
+  LinearCollection<T> moved = std::move(collection);
+  LinearCollection<T> movedEmpty = std::move(empty);
+  copy.append(3);
+  moved.append(4);
+  movedEmpty.append(5);
+  collection.append(6);
+
+  thenCollectionContainsValues(copy, { 1, 2, 3 });
+  thenCollectionContainsValues(moved, { 1, 2, 4 });
+  thenCollectionContainsValues(movedEmpty, { 5 });
+  thenCollectionContainsValues(collection, { 6 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenAssigned_ThenContentsAreReplaced,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> source = { 1, 2, 3 };
+  LinearCollection<T> collection = { 4 };
+  LinearCollection<T> other = { 5, 6 };
+
+  collection = source;
+  other = LinearCollection<T>{ 7 };
+  collection.append(8);
+  other.append(9);
+
+  thenCollectionContainsValues(collection, { 1, 2, 3, 8 });
+  thenCollectionContainsValues(other, { 7, 9 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollectionInArena_WhenDestroyed_ThenStringsAreStillReleased)
+{
+  aisdi::Arena arena;
+  aisdi::ForwardList<std::string, aisdi::ArenaAllocator<std::string>> collection{
+    aisdi::ArenaAllocator<std::string>(arena)};
+
+  for (int i = 0; i < 10; ++i) {
+    collection.append(std::string(100, char('a' + i)));
+  }
+  collection.eraseAfter(collection.begin());
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 9);
+  BOOST_CHECK_EQUAL(*++collection.begin(), std::string(100, 'c'));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,15 +1,25 @@
 #include <LinkedList.h>
+#include <FdSerialization.h>
 
 #include <initializer_list>
 #include <complex>
 #include <cstdint>
 #include <cstddef>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <unistd.h>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/test_tools.hpp>
 
 #include <boost/mpl/list.hpp>
 
+#include "TrackingAllocator.h"
+
 namespace
 {
 
@@ -137,7 +147,7 @@ using TestedTypes = boost::mpl::list<std::int32_t,
 using std::begin;
 using std::end;
 
-BOOST_FIXTURE_TEST_SUITE(VectorTests, Fixture)
+BOOST_FIXTURE_TEST_SUITE(LinkedListTests, Fixture)
 
 template <typename T>
 void thenCollectionContainsValues(const LinearCollection<T>& collection,
@@ -488,6 +498,25 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenMovingToOther_ThenSecondC
   BOOST_CHECK(other.isEmpty());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMovedFromCollection_WhenReused_ThenItBehavesAsEmptyCollection,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  LinearCollection<T> constructed{std::move(collection)};
+  LinearCollection<T> assigned;
+  assigned = std::move(constructed);
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(constructed.begin() == constructed.end());
+  collection.append(4);
+  constructed.prepend(5);
+
+  thenCollectionContainsValues(collection, { 4 });
+  thenCollectionContainsValues(constructed, { 5 });
+  thenCollectionContainsValues(assigned, { 1, 2, 3 });
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenAssigningToOther_ThenAllElementsAreCopied,
                               T,
                               TestedTypes)
@@ -513,6 +542,56 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAssigningToOther_ThenOthe
   BOOST_CHECK(other.isEmpty());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionsOfSameSize_WhenAssigning_ThenNodesAreReused,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { 1, 2, 3, 4 };
+  LinearCollection<T> other = { 100, 200, 300, 400 };
+  const T* first = &*other.cbegin();
+
+  OperationCountingObject::resetCounters();
+  other = collection;
+
+  BOOST_CHECK(&*other.cbegin() == first);
+  thenCollectionContainsValues(other, { 1, 2, 3, 4 });
+  thenConstructedObjectsCountWas<T>(0);
+  thenAssignedObjectsCountWas<T>(4);
+  thenDestroyedObjectsCountWas<T>(0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLongerCollection_WhenAssigningShorterOne_ThenSurplusNodesAreFreed,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { 1, 2 };
+  LinearCollection<T> other = { 100, 200, 300, 400, 500 };
+
+  OperationCountingObject::resetCounters();
+  other = collection;
+
+  thenAssignedObjectsCountWas<T>(2);
+  thenDestroyedObjectsCountWas<T>(3);
+  other.append(3);
+  thenCollectionContainsValues(other, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenShorterCollection_WhenAssigningLongerOne_ThenMissingNodesAreAppended,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { 1, 2, 3, 4, 5 };
+  LinearCollection<T> other = { 100, 200 };
+
+  OperationCountingObject::resetCounters();
+  other = collection;
+
+  thenAssignedObjectsCountWas<T>(2);
+  thenCopiedObjectsCountWas<T>(3);
+  other.prepend(0);
+  thenCollectionContainsValues(other, { 0, 1, 2, 3, 4, 5 });
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenSelfAssigning_ThenNothingHappens,
                               T,
                               TestedTypes)
@@ -932,6 +1011,401 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingRange_ThenSizeI
   BOOST_CHECK_EQUAL(collection.getSize(), 2);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingIf_ThenMatchingItemsAreRemoved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 3, 4, 1, 5 };
+
+  auto removed = collection.eraseIf([](const T& item) { return item == T(1) || item == T(3); });
+
+  BOOST_CHECK_EQUAL(removed, 4);
+  thenCollectionContainsValues(collection, { 2, 4, 5 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingIfNothingMatches_ThenNothingHappens,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  auto removed = collection.eraseIf([](const T& item) { return item == T(7); });
+
+  BOOST_CHECK_EQUAL(removed, 0);
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingIfEverythingMatches_ThenCollectionIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  auto removed = collection.eraseIf([](const T&) { return true; });
+
+  BOOST_CHECK_EQUAL(removed, 3);
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(begin(collection) == end(collection));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionAfterErasingIf_WhenAddingItems_ThenCollectionStaysConsistent,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 1, 2, 1, 1 };
+
+  collection.eraseIf([](const T& item) { return item == T(1); });
+  collection.prepend(0);
+  collection.append(3);
+
+  thenCollectionContainsValues(collection, { 0, 2, 3 });
+  BOOST_CHECK_EQUAL(*(--end(collection)), T(3));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenRemovingValue_ThenAllOccurrencesAreRemoved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 5, 6, 5, 7, 5 };
+
+  auto removed = collection.removeValue(5);
+
+  BOOST_CHECK_EQUAL(removed, 3);
+  thenCollectionContainsValues(collection, { 6, 7 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithAdjacentDuplicates_WhenMakingUnique_ThenRunsAreCollapsed,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 1, 2, 3, 3, 3, 1, 4, 4 };
+
+  auto removed = collection.uniqueInPlace();
+
+  BOOST_CHECK_EQUAL(removed, 4);
+  thenCollectionContainsValues(collection, { 1, 2, 3, 1, 4 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenMakingUnique_ThenNothingHappens,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+
+  BOOST_CHECK_EQUAL(collection.uniqueInPlace(), 0);
+  BOOST_CHECK(collection.isEmpty());
+}
+
+using SerializableTypes = boost::mpl::list<std::int32_t,
+                                           std::uint64_t,
+                                           std::complex<std::int32_t>>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenSavedAndLoaded_ThenItemsAreRestored,
+                              T,
+                              SerializableTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4 };
+  LinearCollection<T> loaded = { 9 };
+  std::stringstream stream;
+
+  collection.save(stream);
+  loaded.load(stream);
+
+  thenCollectionContainsValues(loaded, { 1, 2, 3, 4 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenSavedAndLoaded_ThenLoadedCollectionIsEmpty,
+                              T,
+                              SerializableTypes)
+{
+  LinearCollection<T> collection;
+  LinearCollection<T> loaded = { 9 };
+  std::stringstream stream;
+
+  collection.save(stream);
+  loaded.load(stream);
+
+  BOOST_CHECK(loaded.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenLargeCollection_WhenSavedAndLoaded_ThenItemsAreRestored)
+{
+  LinearCollection<std::uint64_t> collection;
+  for (std::uint64_t i = 0; i < 100000; ++i) {
+    collection.append(i * 7);
+  }
+  LinearCollection<std::uint64_t> loaded;
+  std::stringstream stream;
+
+  collection.save(stream);
+  loaded.load(stream);
+
+  BOOST_CHECK_EQUAL(loaded.getSize(), 100000);
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(loaded), end(loaded));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollectionOfStrings_WhenSavedAndLoaded_ThenItemsAreRestored)
+{
+  LinearCollection<std::string> collection = { "", "a", std::string(100000, 'x') };
+  LinearCollection<std::string> loaded;
+  std::stringstream stream;
+
+  collection.save(stream);
+  loaded.load(stream);
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(loaded), end(loaded));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCorruptedStream_WhenLoading_ThenOperationThrowsAndCollectionIsUnchanged)
+{
+  LinearCollection<std::int32_t> collection = { 1, 2, 3 };
+  LinearCollection<std::int32_t> loaded = { 9 };
+  std::stringstream stream;
+  collection.save(stream);
+  std::string bytes = stream.str();
+  bytes[bytes.size() - 20] ^= 1;
+  std::stringstream corrupted(bytes);
+
+  BOOST_CHECK_THROW(loaded.load(corrupted), std::runtime_error);
+  thenCollectionContainsValues(loaded, { 9 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenTruncatedStream_WhenLoading_ThenOperationThrows)
+{
+  LinearCollection<std::int32_t> collection = { 1, 2, 3 };
+  LinearCollection<std::int32_t> loaded;
+  std::stringstream stream;
+  collection.save(stream);
+  std::stringstream truncated(stream.str().substr(0, stream.str().size() - 12));
+
+  BOOST_CHECK_THROW(loaded.load(truncated), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenDifferentElementType_WhenLoading_ThenOperationThrows)
+{
+  LinearCollection<std::uint64_t> collection = { 1, 2, 3 };
+  LinearCollection<std::int32_t> loaded;
+  std::stringstream stream;
+  collection.save(stream);
+
+  BOOST_CHECK_THROW(loaded.load(stream), std::runtime_error);
+}
+
+std::string withElementCount(std::string bytes, std::uint64_t count)
+{
+  // the count follows magic, version, flags, element size and a reserved word
+  bytes.replace(16, sizeof(count), reinterpret_cast<const char*>(&count), sizeof(count));
+  return bytes;
+}
+
+BOOST_AUTO_TEST_CASE(GivenCorruptElementCount_WhenLoading_ThenOperationThrowsInsteadOfAllocating)
+{
+  LinearCollection<std::int32_t> collection = { 1, 2, 3 };
+  LinearCollection<std::int32_t> loaded = { 9 };
+  std::stringstream stream;
+  collection.save(stream);
+
+  for (std::uint64_t count : { std::uint64_t(1) << 40, std::uint64_t(1) << 62, ~std::uint64_t(0) }) {
+    std::stringstream corrupted(withElementCount(stream.str(), count));
+    BOOST_CHECK_THROW(loaded.load(corrupted), std::runtime_error);
+  }
+  thenCollectionContainsValues(loaded, { 9 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenCorruptElementCountInFile_WhenLoading_ThenOperationThrows)
+{
+  LinearCollection<std::int32_t> collection = { 1, 2, 3 };
+  LinearCollection<std::int32_t> loaded;
+  std::stringstream stream;
+  collection.save(stream);
+  const std::string bytes = withElementCount(stream.str(), std::uint64_t(1) << 40);
+  std::FILE* file = std::tmpfile();
+  const int fd = fileno(file);
+
+  BOOST_REQUIRE_EQUAL(write(fd, bytes.data(), bytes.size()), ssize_t(bytes.size()));
+  lseek(fd, 0, SEEK_SET);
+
+  BOOST_CHECK_THROW(aisdi::load(loaded, fd), std::runtime_error);
+  std::fclose(file);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCorruptStringLength_WhenLoading_ThenOperationThrows)
+{
+  LinearCollection<std::string> collection = { "abc" };
+  LinearCollection<std::string> loaded;
+  std::stringstream stream;
+  collection.save(stream);
+  std::string bytes = stream.str();
+  // the first string length follows the header and the frame length
+  const std::uint64_t length = std::uint64_t(1) << 60;
+  bytes.replace(32, sizeof(length), reinterpret_cast<const char*>(&length), sizeof(length));
+  std::stringstream corrupted(bytes);
+
+  BOOST_CHECK_THROW(loaded.load(corrupted), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenFileDescriptor_WhenSavedAndLoaded_ThenItemsAreRestored)
+{
+  LinearCollection<std::int32_t> collection = { 1, 2, 3 };
+  LinearCollection<std::int32_t> other = { 4, 5 };
+  LinearCollection<std::int32_t> loaded;
+  LinearCollection<std::int32_t> loadedOther;
+  std::FILE* file = std::tmpfile();
+  const int fd = fileno(file);
+
+  aisdi::save(collection, fd);
+  aisdi::save(other, fd);
+  lseek(fd, 0, SEEK_SET);
+  aisdi::load(loaded, fd);
+  aisdi::load(loadedOther, fd);
+  std::fclose(file);
+
+  thenCollectionContainsValues(loaded, { 1, 2, 3 });
+  thenCollectionContainsValues(loadedOther, { 4, 5 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionsWithSameItems_WhenComparing_ThenTheyAreEqual,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { 1, 2, 3 };
+  const LinearCollection<T> other = { 1, 2, 3 };
+
+  BOOST_CHECK(collection == other);
+  BOOST_CHECK(!(collection != other));
+  BOOST_CHECK(LinearCollection<T>() == LinearCollection<T>());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionsWithDifferentItems_WhenComparing_ThenTheyAreNotEqual,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { 1, 2, 3 };
+
+  BOOST_CHECK(collection != LinearCollection<T>({ 1, 2, 4 }));
+  BOOST_CHECK(collection != LinearCollection<T>({ 1, 2 }));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollections_WhenComparingLexicographically_ThenOrderIsFromFirstDifference)
+{
+  const LinearCollection<int> collection = { 1, 2, 3 };
+
+  BOOST_CHECK(collection < LinearCollection<int>({ 1, 3 }));
+  BOOST_CHECK(LinearCollection<int>({ 1, 2 }) < collection);
+  BOOST_CHECK(collection > LinearCollection<int>({ 0, 9, 9, 9 }));
+  BOOST_CHECK(collection <= LinearCollection<int>({ 1, 2, 3 }));
+  BOOST_CHECK(collection >= LinearCollection<int>({ 1, 2, 3 }));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollections_WhenHashing_ThenEqualCollectionsHashEqually)
+{
+  const LinearCollection<std::string> collection = { "a", "b", "c" };
+  const LinearCollection<std::string> other = { "a", "b", "c" };
+  const LinearCollection<std::string> different = { "a", "c", "b" };
+
+  BOOST_CHECK_EQUAL(collection.hash(), other.hash());
+  BOOST_CHECK_EQUAL(std::hash<LinearCollection<std::string>>()(collection),
+                    std::hash<LinearCollection<std::string>>()(other));
+  BOOST_CHECK_NE(collection.hash(), different.hash());
+  BOOST_CHECK_NE(collection.hash(1), collection.hash(2));
+}
+
+template <bool Propagate>
+using TrackedCollection = aisdi::LinkedList<int, TrackingAllocator<int, Propagate>>;
+
+BOOST_AUTO_TEST_CASE(GivenStatefulAllocator_WhenCollectionIsFilledAndDies_ThenEveryNodeGoesBackToIt)
+{
+  {
+    TrackedCollection<false> collection{TrackingAllocator<int, false>(1)};
+    for (int i = 0; i < 10; ++i) {
+      collection.append(i);
+    }
+    collection.popFirst();
+    TrackedCollection<false> copy = collection;
+
+    BOOST_CHECK_EQUAL(copy.get_allocator().id, 1);
+    BOOST_CHECK_EQUAL(liveAllocations()[1], 18);
+  }
+
+  BOOST_CHECK_EQUAL(liveAllocations()[1], 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenMoveConstructed_ThenNodesAreTakenWithoutAllocating)
+{
+  {
+    TrackedCollection<false> collection({ 1, 2, 3 }, TrackingAllocator<int, false>(1));
+    const int* first = &*collection.begin();
+
+    TrackedCollection<false> moved(std::move(collection));
+    std::vector<TrackedCollection<false>> grown;
+    grown.push_back(std::move(moved));
+    grown.reserve(grown.capacity() + 1);
+
+    BOOST_CHECK(std::is_nothrow_move_constructible<TrackedCollection<false>>::value);
+    BOOST_CHECK(&*grown[0].begin() == first);
+    BOOST_CHECK_EQUAL(*--grown[0].end(), 3);
+    BOOST_CHECK_EQUAL(liveAllocations()[1], 3);
+    BOOST_CHECK(collection.isEmpty());
+    BOOST_CHECK(moved.begin() == moved.end());
+  }
+
+  BOOST_CHECK_EQUAL(liveAllocations()[1], 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonPropagatingAllocators_WhenAssigning_ThenTargetKeepsItsAllocator)
+{
+  {
+    TrackedCollection<false> collection({ 1, 2, 3 }, TrackingAllocator<int, false>(1));
+    TrackedCollection<false> copied{TrackingAllocator<int, false>(2)};
+    TrackedCollection<false> moved{TrackingAllocator<int, false>(2)};
+
+    copied = collection;
+    moved = std::move(collection);
+
+    BOOST_CHECK_EQUAL(copied.get_allocator().id, 2);
+    BOOST_CHECK_EQUAL(moved.get_allocator().id, 2);
+    BOOST_CHECK(copied == moved);
+    BOOST_CHECK_EQUAL(liveAllocations()[2], 6);
+  }
+
+  BOOST_CHECK_EQUAL(liveAllocations()[1], 0);
+  BOOST_CHECK_EQUAL(liveAllocations()[2], 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonPropagatingAllocators_WhenMoveAssigning_ThenItemsAreMovedNotCopied)
+{
+  using Allocator = TrackingAllocator<OperationCountingObject, false>;
+  aisdi::LinkedList<OperationCountingObject, Allocator> collection({ 1, 2, 3 }, Allocator(1));
+  aisdi::LinkedList<OperationCountingObject, Allocator> moved{Allocator(2)};
+
+  OperationCountingObject::resetCounters();
+  moved = std::move(collection);
+
+  BOOST_CHECK_EQUAL(moved.getSize(), 3u);
+  BOOST_CHECK(*moved.begin() == OperationCountingObject(1));
+  thenCopiedObjectsCountWas<OperationCountingObject>(0);
+  thenMovedObjectsCountWas<OperationCountingObject>(3);
+}
+
+BOOST_AUTO_TEST_CASE(GivenPropagatingAllocators_WhenAssigning_ThenTargetTakesSourceAllocator)
+{
+  {
+    TrackedCollection<true> collection({ 1, 2, 3 }, TrackingAllocator<int, true>(1));
+    TrackedCollection<true> copied{TrackingAllocator<int, true>(2)};
+    TrackedCollection<true> moved{TrackingAllocator<int, true>(2)};
+
+    copied = collection;
+    moved = std::move(collection);
+
+    BOOST_CHECK_EQUAL(copied.get_allocator().id, 1);
+    BOOST_CHECK_EQUAL(moved.get_allocator().id, 1);
+    BOOST_CHECK(copied == moved);
+    BOOST_CHECK_EQUAL(liveAllocations()[2], 0);
+  }
+
+  BOOST_CHECK_EQUAL(liveAllocations()[1], 0);
+}
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 
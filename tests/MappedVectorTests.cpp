@@ -0,0 +1,177 @@
+#include <MappedVector.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+namespace
+{
+
+struct Fixture
+{
+  Fixture()
+    : path(temporaryPath())
+  {
+    ::unlink(path.c_str());
+  }
+
+  ~Fixture()
+  {
+    ::unlink(path.c_str());
+  }
+
+  static std::string temporaryPath()
+  {
+    static int counter = 0;
+    const char* directory = std::getenv("TMPDIR");
+    return std::string(directory != nullptr ? directory : "/tmp") + "/aisdi_mapped_vector_"
+           + std::to_string(::getpid()) + "_" + std::to_string(counter++);
+  }
+
+  std::string path;
+};
+
+} // namespace
+
+template <typename T>
+using LinearCollection = aisdi::MappedVector<T>;
+
+using TestedTypes = boost::mpl::list<std::int32_t,
+                                     std::uint64_t,
+                                     std::complex<std::int32_t>>;
+
+using std::begin;
+using std::end;
+
+BOOST_FIXTURE_TEST_SUITE(MappedVectorTests, Fixture)
+
+template <typename T>
+void thenCollectionContainsValues(const LinearCollection<T>& collection,
+                                  std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNewFile_WhenOpened_ThenCollectionIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection(path);
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenReopened_ThenPreviousContentsAreVisible,
+                              T,
+                              TestedTypes)
+{
+  {
+    LinearCollection<T> collection(path);
+    collection.append(1);
+    collection.append(2);
+    collection.append(3);
+  }
+
+  LinearCollection<T> reopened(path);
+
+  thenCollectionContainsValues(reopened, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSmallCapacity_WhenAppendingManyItems_ThenFileGrows,
+                              T,
+                              TestedTypes)
+{
+  {
+    LinearCollection<T> collection(path, 2);
+    for (int i = 0; i < 10000; ++i) {
+      collection.append(i);
+    }
+    BOOST_CHECK_GE(collection.getCapacity(), 10000);
+    collection.sync();
+  }
+
+  LinearCollection<T> reopened(path);
+
+  BOOST_CHECK_EQUAL(reopened.getSize(), 10000);
+  BOOST_CHECK_EQUAL(reopened[9999], T(9999));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInsertingAndErasing_ThenItemsAreUpdated,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection(path, 1);
+  collection.append(1);
+  collection.append(3);
+
+  collection.insert(begin(collection) + 1, 2);
+  collection.prepend(0);
+  collection.erase(begin(collection) + 3);
+  collection.flush();
+
+  thenCollectionContainsValues(collection, { 0, 1, 2 });
+  BOOST_CHECK_EQUAL(collection.popFirst(), T(0));
+  BOOST_CHECK_EQUAL(collection.popLast(), T(2));
+  thenCollectionContainsValues(collection, { 1 });
+  BOOST_CHECK_THROW(collection.erase(end(collection)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenGrownCollection_WhenFittingToSize_ThenCapacityEqualsSize,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection(path, 100);
+  collection.append(5);
+  collection.append(6);
+
+  collection.fitToSize();
+
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 2);
+  thenCollectionContainsValues(collection, { 5, 6 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenFileWrittenWithOtherElementSize_WhenOpened_ThenOperationThrows)
+{
+  {
+    LinearCollection<std::uint64_t> collection(path);
+    collection.append(1);
+  }
+
+  BOOST_CHECK_THROW(LinearCollection<std::int32_t> collection(path), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyCollection_WhenPopping_ThenOperationThrows)
+{
+  LinearCollection<int> collection(path);
+
+  BOOST_CHECK_THROW(collection.popFirst(), std::logic_error);
+  BOOST_CHECK_THROW(collection.popLast(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMovedFromCollection_WhenQueried_ThenItIsEmpty)
+{
+  LinearCollection<int> collection(path);
+  collection.append(1);
+
+  LinearCollection<int> moved(std::move(collection));
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 0);
+  BOOST_CHECK(collection.begin() == collection.end());
+  BOOST_CHECK_THROW(collection.popLast(), std::logic_error);
+  thenCollectionContainsValues(moved, { 1 });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
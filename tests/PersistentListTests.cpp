@@ -0,0 +1,180 @@
+#include <PersistentList.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+template <typename T>
+using LinearCollection = aisdi::PersistentList<T>;
+
+using TestedTypes = boost::mpl::list<std::int32_t,
+                                     std::uint64_t,
+                                     std::complex<std::int32_t>>;
+
+using std::begin;
+using std::end;
+
+namespace
+{
+
+struct CountedValue
+{
+  explicit CountedValue(int value_)
+    : value(value_)
+  {
+    ++live;
+  }
+
+  CountedValue(const CountedValue& other)
+    : value(other.value)
+  {
+    if (failCopies) {
+      throw std::runtime_error("copy failed");
+    }
+    ++live;
+  }
+
+  ~CountedValue()
+  {
+    --live;
+  }
+
+  int value;
+
+  static int live;
+  static bool failCopies;
+};
+
+int CountedValue::live = 0;
+bool CountedValue::failCopies = false;
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(PersistentListTests)
+
+template <typename T>
+void thenCollectionContainsValues(const LinearCollection<T>& collection,
+                                  std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL(collection.getSize(), expected.size());
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+  BOOST_CHECK_THROW(collection.first(), std::logic_error);
+  BOOST_CHECK_THROW(collection.popFirst(), std::logic_error);
+  BOOST_CHECK_THROW(*collection.begin(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenPrepending_ThenNewVersionSharesOldCells,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { 2, 3 };
+
+  const LinearCollection<T> first = collection.prepend(1);
+  const LinearCollection<T> second = collection.prepend(4);
+
+  thenCollectionContainsValues(collection, { 2, 3 });
+  thenCollectionContainsValues(first, { 1, 2, 3 });
+  thenCollectionContainsValues(second, { 4, 2, 3 });
+  BOOST_CHECK(&first.tail().first() == &collection.first());
+  BOOST_CHECK(&second.tail().first() == &collection.first());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenPoppingFirst_ThenOldVersionIsUnchanged,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { 1, 2, 3 };
+
+  const LinearCollection<T> popped = collection.popFirst();
+
+  BOOST_CHECK(collection.first() == T(1));
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+  thenCollectionContainsValues(popped, { 2, 3 });
+  thenCollectionContainsValues(popped.popFirst().popFirst(), {});
+}
+
+BOOST_AUTO_TEST_CASE(GivenRange_WhenBuildingList_ThenOrderIsKept)
+{
+  const std::vector<std::string> values = { "a", "b", "c" };
+
+  const LinearCollection<std::string> collection = LinearCollection<std::string>::fromRange(values.begin(), values.end());
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 3);
+  BOOST_CHECK_EQUAL(collection.popFirst().getSize(), 2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(collection.begin(), collection.end(), values.begin(), values.end());
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenConvertingToVector_ThenCapacityIsExact)
+{
+  const LinearCollection<int> collection = { 1, 2, 3, 4, 5 };
+
+  const aisdi::Vector<int> vector = collection.toVector();
+
+  BOOST_CHECK_EQUAL(vector.getSize(), 5);
+  BOOST_CHECK_EQUAL(vector.getCapacity(), 5);
+  BOOST_CHECK_EQUAL_COLLECTIONS(vector.begin(), vector.end(), collection.begin(), collection.end());
+}
+
+BOOST_AUTO_TEST_CASE(GivenManyVersionsDifferingAtHead_WhenDropped_ThenSharedTailSurvives)
+{
+  const std::vector<int> sevens(1000, 7);
+  const LinearCollection<int> shared = LinearCollection<int>::fromRange(sevens.begin(), sevens.end());
+  std::vector<LinearCollection<int>> versions;
+
+  for (int i = 0; i < 1000; ++i) {
+    versions.push_back(shared.prepend(i));
+  }
+  versions.clear();
+
+  BOOST_CHECK_EQUAL(shared.getSize(), 1000);
+  BOOST_CHECK_EQUAL(shared.first(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(GivenThrowingCopy_WhenPrepending_ThenOldCellsAreStillReleased)
+{
+  {
+    const CountedValue item(3);
+    const LinearCollection<CountedValue> collection = { CountedValue(1), CountedValue(2) };
+
+    CountedValue::failCopies = true;
+    BOOST_CHECK_THROW(collection.prepend(item), std::runtime_error);
+    CountedValue::failCopies = false;
+    BOOST_CHECK_EQUAL(collection.getSize(), 2);
+  }
+
+  BOOST_CHECK_EQUAL(CountedValue::live, 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVeryLongList_WhenDestroyed_ThenStackDoesNotOverflow)
+{
+  LinearCollection<int> collection;
+  for (int i = 0; i < 1000000; ++i) {
+    collection = collection.prepend(i);
+  }
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 1000000);
+  collection = LinearCollection<int>();
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
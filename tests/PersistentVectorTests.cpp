@@ -0,0 +1,274 @@
+#include <PersistentVector.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+namespace
+{
+
+template <typename T>
+aisdi::PersistentVector<T> rampOf(int size, int first = 0)
+{
+  typename aisdi::PersistentVector<T>::Transient builder;
+  for (int i = 0; i < size; ++i) {
+    builder.append(T(first + i));
+  }
+  return builder.persistent();
+}
+
+std::vector<int> rampVector(int size, int first = 0)
+{
+  std::vector<int> values;
+  for (int i = 0; i < size; ++i) {
+    values.push_back(first + i);
+  }
+  return values;
+}
+
+void thenCollectionMatches(const aisdi::PersistentVector<int>& collection, const std::vector<int>& expected)
+{
+  BOOST_REQUIRE_EQUAL(collection.getSize(), expected.size());
+  BOOST_CHECK_EQUAL_COLLECTIONS(collection.begin(), collection.end(), expected.begin(), expected.end());
+  for (std::size_t i = 0; i < expected.size(); i += 7) {
+    BOOST_CHECK_EQUAL(collection.get(i), expected[i]);
+  }
+}
+
+} // namespace
+
+template <typename T>
+using LinearCollection = aisdi::PersistentVector<T>;
+
+using TestedTypes = boost::mpl::list<std::int32_t,
+                                     std::uint64_t,
+                                     std::complex<std::int32_t>>;
+
+using std::begin;
+using std::end;
+
+BOOST_AUTO_TEST_SUITE(PersistentVectorTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+  BOOST_CHECK_THROW(collection.get(0), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenAppending_ThenOldVersionIsUnchanged,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { T(1), T(2) };
+
+  const LinearCollection<T> appended = collection.append(T(3));
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 2);
+  BOOST_CHECK_EQUAL(appended.getSize(), 3);
+  BOOST_CHECK(appended.get(2) == T(3));
+}
+
+BOOST_AUTO_TEST_CASE(GivenStrings_WhenVersionsShareNodes_ThenEachVersionKeepsItsValues)
+{
+  const std::string longText(100, 'x');
+  LinearCollection<std::string> collection;
+  for (int i = 0; i < 100; ++i) {
+    collection = collection.append(longText + std::to_string(i));
+  }
+
+  const LinearCollection<std::string> edited = collection.set(50, "short").erase(0).slice(0, 60);
+
+  BOOST_CHECK_EQUAL(collection.get(50), longText + "50");
+  BOOST_CHECK_EQUAL(edited.get(49), "short");
+  BOOST_CHECK_EQUAL(edited.getSize(), 60);
+}
+
+BOOST_AUTO_TEST_CASE(GivenManyAppends_WhenReading_ThenEveryElementIsInPlace)
+{
+  LinearCollection<int> collection;
+  for (int i = 0; i < 2000; ++i) {
+    collection = collection.append(i);
+  }
+
+  thenCollectionMatches(collection, rampVector(2000));
+  BOOST_CHECK_THROW(collection.get(2000), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenLargeCollection_WhenSetting_ThenUnchangedLeavesAreShared)
+{
+  const LinearCollection<int> collection = rampOf<int>(40000);
+
+  const LinearCollection<int> updated = collection.set(35000, -1);
+
+  BOOST_CHECK_EQUAL(collection.get(35000), 35000);
+  BOOST_CHECK_EQUAL(updated.get(35000), -1);
+  BOOST_CHECK(&collection.get(0) == &updated.get(0));
+  BOOST_CHECK(&collection.get(34999) != &updated.get(34999));
+  BOOST_CHECK(&collection.get(34000) == &updated.get(34000));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollections_WhenConcatenating_ThenElementsFollowEachOther)
+{
+  const LinearCollection<int> left = rampOf<int>(1000);
+  const LinearCollection<int> right = rampOf<int>(77, 1000);
+
+  thenCollectionMatches(left.concat(right), rampVector(1077));
+  thenCollectionMatches(right.concat(LinearCollection<int>()), rampVector(77, 1000));
+  thenCollectionMatches(LinearCollection<int>().concat(left), rampVector(1000));
+}
+
+BOOST_AUTO_TEST_CASE(GivenManySmallPieces_WhenConcatenated_ThenLeavesAreMerged)
+{
+  LinearCollection<int> collection;
+  for (int i = 0; i < 3000; i += 3) {
+    collection = collection.concat(rampOf<int>(3, i));
+  }
+
+  std::size_t leaves = 0;
+  collection.forEachLeaf([&leaves](const int*, std::size_t count) {
+    BOOST_CHECK_LE(count, 32);
+    ++leaves;
+  });
+  thenCollectionMatches(collection, rampVector(3000));
+  BOOST_CHECK_LE(leaves, 3000 / 32 + 2);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenSlicing_ThenOnlyRangeIsKept)
+{
+  const LinearCollection<int> collection = rampOf<int>(5000);
+
+  thenCollectionMatches(collection.slice(1234, 4321), rampVector(3087, 1234));
+  thenCollectionMatches(collection.slice(0, 5000), rampVector(5000));
+  BOOST_CHECK(collection.slice(10, 10).isEmpty());
+  BOOST_CHECK_THROW(collection.slice(10, 5001), std::out_of_range);
+  BOOST_CHECK_THROW(collection.slice(11, 10), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenInsertingAndErasing_ThenNewVersionsAreUpdated)
+{
+  const LinearCollection<int> collection = { 1, 3 };
+
+  const LinearCollection<int> inserted = collection.insert(1, 2).prepend(0).insert(4, 4);
+  const LinearCollection<int> erased = inserted.erase(0).erase(3);
+
+  thenCollectionMatches(collection, { 1, 3 });
+  thenCollectionMatches(inserted, { 0, 1, 2, 3, 4 });
+  thenCollectionMatches(erased, { 1, 2, 3 });
+  BOOST_CHECK_THROW(collection.insert(3, 0), std::out_of_range);
+  BOOST_CHECK_THROW(collection.erase(2), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenRandomEdits_WhenComparedWithStdVector_ThenContentsAgree)
+{
+  std::mt19937 random(42);
+  LinearCollection<int> collection = rampOf<int>(300);
+  std::vector<int> expected = rampVector(300);
+
+  for (int step = 0; step < 300; ++step) {
+    const std::size_t size = expected.size();
+    const std::size_t position = size == 0 ? 0 : random() % (size + 1);
+    switch (random() % 5) {
+    case 0:
+      collection = collection.insert(position, step);
+      expected.insert(expected.begin() + position, step);
+      break;
+    case 1:
+      if (position < size) {
+        collection = collection.erase(position);
+        expected.erase(expected.begin() + position);
+      }
+      break;
+    case 2:
+      if (position < size) {
+        collection = collection.set(position, -step);
+        expected[position] = -step;
+      }
+      break;
+    case 3: {
+      const std::size_t last = position + random() % (std::min<std::size_t>(size - position, 50) + 1);
+      collection = collection.slice(position, last).concat(collection);
+      const std::vector<int> prefix(expected.begin() + position, expected.begin() + last);
+      expected.insert(expected.begin(), prefix.begin(), prefix.end());
+      break;
+    }
+    default: {
+      const std::vector<int> appended = rampVector(int(random() % 70), step * 100);
+      collection = collection.concat(rampOf<int>(int(appended.size()), step * 100));
+      expected.insert(expected.end(), appended.begin(), appended.end());
+    }
+    }
+  }
+
+  thenCollectionMatches(collection, expected);
+}
+
+BOOST_AUTO_TEST_CASE(GivenThousandsOfPrependsAndInserts_WhenComparedWithStdVector_ThenTreeStaysBalanced)
+{
+  std::mt19937 random(7);
+  LinearCollection<int> collection;
+  std::vector<int> expected;
+
+  for (int step = 0; step < 6000; ++step) {
+    const std::size_t position = expected.empty() ? 0 : random() % (expected.size() + 1);
+    if (random() % 2 == 0) {
+      collection = collection.prepend(step);
+      expected.insert(expected.begin(), step);
+    }
+    else {
+      collection = collection.insert(position, step);
+      expected.insert(expected.begin() + position, step);
+    }
+  }
+
+  thenCollectionMatches(collection, expected);
+  std::size_t leaves = 0;
+  collection.forEachLeaf([&leaves](const int*, std::size_t) { ++leaves; });
+  BOOST_CHECK_LT(leaves, 2 * expected.size() / LinearCollection<int>::BRANCHING);
+}
+
+BOOST_AUTO_TEST_CASE(GivenTransient_WhenBuildingFromVersion_ThenVersionIsUnchanged)
+{
+  const LinearCollection<int> collection = rampOf<int>(100);
+
+  auto builder = collection.transient();
+  for (int i = 100; i < 1100; ++i) {
+    builder.append(i);
+  }
+  builder.set(0, -1);
+  const LinearCollection<int> built = builder.persistent();
+
+  thenCollectionMatches(collection, rampVector(100));
+  std::vector<int> expected = rampVector(1100);
+  expected[0] = -1;
+  thenCollectionMatches(built, expected);
+  BOOST_CHECK_EQUAL(builder.getSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenIteratingPastEnd_ThenExceptionIsThrown)
+{
+  const LinearCollection<int> collection = { 1 };
+
+  auto it = collection.begin();
+  ++it;
+
+  BOOST_CHECK(it == collection.end());
+  BOOST_CHECK_THROW(*it, std::out_of_range);
+  BOOST_CHECK_THROW(++it, std::out_of_range);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,391 @@
+#include <SegmentedVector.h>
+
+#include <initializer_list>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+namespace
+{
+
+class OperationCountingObject
+{
+public:
+  OperationCountingObject(int value_ = 0)
+    : value(value_)
+  {
+    ++constructedObjects;
+  }
+
+  OperationCountingObject(const OperationCountingObject& other)
+    : value(std::move(other.value))
+  {
+    ++constructedObjects;
+    ++copiedObjects;
+  }
+
+  OperationCountingObject(OperationCountingObject&& other)
+    : value(other.value)
+  {
+    ++constructedObjects;
+    ++movedObjects;
+  }
+
+  ~OperationCountingObject()
+  {
+    ++destroyedObjects;
+  }
+
+  OperationCountingObject& operator=(const OperationCountingObject& other)
+  {
+    ++assignedObjects;
+    value = other.value;
+    return *this;
+  }
+
+  OperationCountingObject& operator=(OperationCountingObject&& other)
+  {
+    ++assignedObjects;
+    ++movedObjects;
+    value = std::move(other.value);
+    return *this;
+  }
+
+  operator int() const
+  {
+    return value;
+  }
+
+  static void resetCounters()
+  {
+    constructedObjects = 0;
+    destroyedObjects = 0;
+    copiedObjects = 0;
+    movedObjects = 0;
+    assignedObjects = 0;
+  }
+
+  static std::size_t constructedObjectsCount()
+  {
+    return constructedObjects;
+  }
+
+  static std::size_t destroyedObjectsCount()
+  {
+    return destroyedObjects;
+  }
+
+  static std::size_t copiedObjectsCount()
+  {
+    return copiedObjects;
+  }
+
+  static std::size_t movedObjectsCount()
+  {
+    return movedObjects;
+  }
+
+  static std::size_t assignedObjectsCount()
+  {
+    return assignedObjects;
+  }
+
+private:
+  int value;
+
+  static std::size_t constructedObjects;
+  static std::size_t destroyedObjects;
+  static std::size_t copiedObjects;
+  static std::size_t movedObjects;
+  static std::size_t assignedObjects;
+};
+
+std::size_t OperationCountingObject::constructedObjects = 0;
+std::size_t OperationCountingObject::destroyedObjects = 0;
+std::size_t OperationCountingObject::copiedObjects = 0;
+std::size_t OperationCountingObject::movedObjects = 0;
+std::size_t OperationCountingObject::assignedObjects = 0 ;
+
+std::ostream& operator<<(std::ostream& out, const OperationCountingObject& obj)
+{
+  return out << '<' << static_cast<int>(obj) << '>';
+}
+
+struct Fixture
+{
+  Fixture()
+  {
+    OperationCountingObject::resetCounters();
+  }
+};
+
+} // namespace
+
+template <typename T>
+using LinearCollection = aisdi::SegmentedVector<T>;
+
+using TestedTypes = boost::mpl::list<std::int32_t,
+                                     std::uint64_t,
+                                     std::complex<std::int32_t>,
+                                     OperationCountingObject>;
+
+using std::begin;
+using std::end;
+
+BOOST_FIXTURE_TEST_SUITE(SegmentedVectorTests, Fixture)
+
+template <typename T>
+void thenCollectionContainsValues(const LinearCollection<T>& collection,
+                                  std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+template <typename T>
+void thenConstructedObjectsCountWas(std::size_t count)
+{
+  (void) count;
+  // unable to check it (in a simple way) for all objects, hence template specialization.
+}
+
+template <typename T>
+void thenDestroyedObjectsCountWas(std::size_t count)
+{
+  (void) count;
+  // unable to check it (in a simple way) for all objects, hence template specialization.
+}
+
+template <typename T>
+void thenCopiedObjectsCountWas(std::size_t count)
+{
+  (void) count;
+  // unable to check it (in a simple way) for all objects, hence template specialization.
+}
+
+template <typename T>
+void thenMovedObjectsCountWas(std::size_t count)
+{
+  (void) count;
+  // unable to check it (in a simple way) for all objects, hence template specialization.
+}
+
+template <typename T>
+void thenAssignedObjectsCountWas(std::size_t count)
+{
+  (void) count;
+  // unable to check it (in a simple way) for all objects, hence template specialization.
+}
+
+template <>
+void thenConstructedObjectsCountWas<OperationCountingObject>(std::size_t count)
+{
+  BOOST_CHECK_EQUAL(OperationCountingObject::constructedObjectsCount(), count);
+}
+
+template <>
+void thenDestroyedObjectsCountWas<OperationCountingObject>(std::size_t count)
+{
+  BOOST_CHECK_EQUAL(OperationCountingObject::destroyedObjectsCount(), count);
+}
+
+template <>
+void thenCopiedObjectsCountWas<OperationCountingObject>(std::size_t count)
+{
+  BOOST_CHECK_EQUAL(OperationCountingObject::copiedObjectsCount(), count);
+}
+
+template <>
+void thenMovedObjectsCountWas<OperationCountingObject>(std::size_t count)
+{
+  BOOST_CHECK_EQUAL(OperationCountingObject::movedObjectsCount(), count);
+}
+
+template <>
+void thenAssignedObjectsCountWas<OperationCountingObject>(std::size_t count)
+{
+  BOOST_CHECK_EQUAL(OperationCountingObject::assignedObjectsCount(), count);
+}
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAppendingManyItems_ThenAllItemsAreKeptInOrder,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+
+  for (int i = 0; i < 1000; ++i) {
+    collection.append(i);
+  }
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 1000);
+  for (int i = 0; i < 1000; ++i) {
+    BOOST_CHECK_EQUAL(collection[i], T(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenReferenceToItem_WhenAppendingManyItems_ThenReferenceStaysValid,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 42 };
+  const T* first = &collection[0];
+
+  for (int i = 0; i < 5000; ++i) {
+    collection.append(i);
+  }
+
+  BOOST_CHECK_EQUAL(first, &collection[0]);
+  BOOST_CHECK_EQUAL(*first, T(42));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenIterating_ThenAllItemsAreVisited,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+  BOOST_CHECK_EQUAL(*(--end(collection)), T(3));
+  BOOST_CHECK_THROW(*end(collection), std::out_of_range);
+  BOOST_CHECK_THROW(--begin(collection), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenDereferencing_ThenItemCanBeChanged,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  *(begin(collection) + 1) = T(7);
+
+  thenCollectionContainsValues(collection, { 1, 7, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionSpanningBlocks_WhenInsertingInMiddle_ThenItemIsInserted,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+  for (int i = 0; i < 40; ++i) {
+    collection.append(i);
+  }
+
+  collection.insert(begin(collection) + 20, 100);
+  collection.prepend(-1);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 42);
+  BOOST_CHECK_EQUAL(collection[0], T(-1));
+  BOOST_CHECK_EQUAL(collection[20], T(19));
+  BOOST_CHECK_EQUAL(collection[21], T(100));
+  BOOST_CHECK_EQUAL(collection[22], T(20));
+  BOOST_CHECK_EQUAL(collection[41], T(39));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenPopping_ThenOperationThrows,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+
+  BOOST_CHECK_THROW(collection.popFirst(), std::logic_error);
+  BOOST_CHECK_THROW(collection.popLast(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPopping_ThenItemsAreRemovedAndReturned,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4 };
+
+  BOOST_CHECK_EQUAL(collection.popFirst(), T(1));
+  BOOST_CHECK_EQUAL(collection.popLast(), T(4));
+  thenCollectionContainsValues(collection, { 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasing_ThenItemsAreRemoved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4, 5, 6 };
+
+  collection.erase(begin(collection));
+  collection.erase(begin(collection) + 1, begin(collection) + 3);
+
+  thenCollectionContainsValues(collection, { 2, 5, 6 });
+  BOOST_CHECK_THROW(collection.erase(end(collection)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenCreatingCopy_ThenAllItemsAreCopied,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  LinearCollection<T> other{collection};
+
+  collection.append(4);
+
+  thenCollectionContainsValues(other, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenMovingToOther_ThenNoItemIsCopied,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  OperationCountingObject::resetCounters();
+  LinearCollection<T> other{std::move(collection)};
+
+  thenCollectionContainsValues(other, { 1, 2, 3 });
+  BOOST_CHECK(collection.isEmpty());
+  thenConstructedObjectsCountWas<T>(0);
+  thenCopiedObjectsCountWas<T>(0);
+  thenAssignedObjectsCountWas<T>(0);
+  thenMovedObjectsCountWas<T>(0);
+  thenDestroyedObjectsCountWas<T>(0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenAssigning_ThenAllItemsAreCopied,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  LinearCollection<T> other = { 7, 8 };
+
+  other = collection;
+  collection = LinearCollection<T>{ 9 };
+
+  thenCollectionContainsValues(other, { 1, 2, 3 });
+  thenCollectionContainsValues(collection, { 9 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenDestroyed_ThenOnlyLiveItemsAreDestroyed,
+                              T,
+                              TestedTypes)
+{
+  {
+    LinearCollection<T> collection = { 1, 2, 3, 4, 5 };
+    collection.popLast();
+    collection.fitToSize();
+
+    OperationCountingObject::resetCounters();
+  }
+
+  thenDestroyedObjectsCountWas<T>(4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
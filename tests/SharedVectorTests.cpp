@@ -0,0 +1,290 @@
+#include <SharedVector.h>
+
+#include <initializer_list>
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+namespace
+{
+
+struct Fixture
+{
+  Fixture()
+    : name(segmentName())
+  {
+    aisdi::SharedVector<int>::remove(name);
+  }
+
+  ~Fixture()
+  {
+    aisdi::SharedVector<int>::remove(name);
+  }
+
+  static std::string segmentName()
+  {
+    static int counter = 0;
+    return "/aisdi_shared_vector_" + std::to_string(::getpid()) + "_" + std::to_string(counter++);
+  }
+
+  std::string name;
+};
+
+struct Node
+{
+  aisdi::OffsetPtr<Node> next;
+  int value;
+};
+
+} // namespace
+
+template <typename T>
+using LinearCollection = aisdi::SharedVector<T>;
+
+using TestedTypes = boost::mpl::list<std::int32_t,
+                                     std::uint64_t,
+                                     std::complex<std::int32_t>>;
+
+using std::begin;
+using std::end;
+
+BOOST_FIXTURE_TEST_SUITE(SharedVectorTests, Fixture)
+
+template <typename T>
+void thenCollectionContainsValues(const LinearCollection<T>& collection,
+                                  std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE(GivenOffsetPointers_WhenMemoryIsCopiedElsewhere_ThenTheyPointIntoTheCopy)
+{
+  Node original[2];
+  original[0].next = &original[1];
+  original[0].value = 1;
+  original[1].value = 2;
+
+  Node copy[2];
+  std::memcpy(static_cast<void*>(copy), static_cast<const void*>(original), sizeof(original));
+
+  BOOST_CHECK(copy[0].next.get() == &copy[1]);
+  BOOST_CHECK_EQUAL(copy[0].next->value, 2);
+  BOOST_CHECK(!copy[1].next);
+  BOOST_CHECK(copy[1].next.get() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNewSegment_WhenOpened_ThenCollectionIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection(name);
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+  BOOST_CHECK_EQUAL(collection.getVersion(), 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoMappings_WhenAppendingThroughOne_ThenOtherSeesSameElements,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> writer(name);
+  LinearCollection<T> reader(name);
+
+  writer.append(1);
+  writer.append(2);
+  writer.append(3);
+
+  BOOST_CHECK(reader.data() != writer.data());
+  thenCollectionContainsValues(reader, { 1, 2, 3 });
+  BOOST_CHECK_EQUAL(reader.getVersion(), 3);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSmallCapacity_WhenOtherMappingGrowsSegment_ThenReadLockFollowsIt,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> writer(name, 2);
+  LinearCollection<T> reader(name);
+
+  for (int i = 0; i < 10000; ++i) {
+    writer.append(i);
+  }
+
+  const typename LinearCollection<T>::ReadLock lock(reader);
+  const aisdi::Span<const T> view = lock.view();
+  BOOST_CHECK_EQUAL(view.getSize(), 10000);
+  BOOST_CHECK_EQUAL(view[9999], T(9999));
+}
+
+BOOST_AUTO_TEST_CASE(GivenOtherMappingGrewSegment_WhenReadingWithoutLock_ThenOnlyMappedItemsAreVisible)
+{
+  LinearCollection<std::int32_t> writer(name, 2);
+  LinearCollection<std::int32_t> reader(name);
+
+  for (int i = 0; i < 1000; ++i) {
+    writer.append(i);
+  }
+
+  BOOST_CHECK_EQUAL(reader.getSize(), 2);
+  BOOST_CHECK_EQUAL(reader[1], 1);
+  {
+    const LinearCollection<std::int32_t>::ReadLock lock(reader);
+  }
+  BOOST_CHECK_EQUAL(reader.getSize(), 1000);
+  BOOST_CHECK_EQUAL(reader[999], 999);
+}
+
+BOOST_AUTO_TEST_CASE(GivenThreadsSharingMapping_WhenTheyFollowGrowthUnderReadLocks_ThenViewsStayValid)
+{
+  LinearCollection<std::int32_t> writer(name, 2);
+  const LinearCollection<std::int32_t> reader(name);
+  const int items = 5000;
+
+  std::thread appending([&writer, items]() {
+    for (int i = 0; i < items; ++i) {
+      writer.append(i);
+    }
+  });
+  std::vector<std::thread> readers;
+  std::vector<int> mismatches(4, 0);
+  for (int r = 0; r < 4; ++r) {
+    readers.emplace_back([&reader, &mismatches, r, items]() {
+      // glibc rwlocks prefer readers, so the rounds are bounded and the writer is not starved for good
+      for (int round = 0; round < 500; ++round) {
+        const LinearCollection<std::int32_t>::ReadLock lock(reader);
+        const aisdi::Span<const std::int32_t> view = lock.view();
+        const std::size_t seen = view.getSize();
+        if (seen > 0 && view[seen - 1] != static_cast<std::int32_t>(seen - 1)) {
+          ++mismatches[r];
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+      }
+    });
+  }
+  appending.join();
+  for (auto& thread : readers) {
+    thread.join();
+  }
+
+  for (int r = 0; r < 4; ++r) {
+    BOOST_CHECK_EQUAL(mismatches[r], 0);
+  }
+  const LinearCollection<std::int32_t>::ReadLock lock(reader);
+  BOOST_CHECK_EQUAL(lock.view().getSize(), items);
+  BOOST_CHECK_EQUAL(lock.view()[items - 1], items - 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInsertingAndErasing_ThenItemsAreUpdated,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection(name, 1);
+  collection.append(1);
+  collection.append(3);
+
+  collection.insert(begin(collection) + 1, 2);
+  collection.prepend(0);
+  collection.erase(begin(collection) + 3);
+
+  thenCollectionContainsValues(collection, { 0, 1, 2 });
+  BOOST_CHECK_EQUAL(collection.popFirst(), T(0));
+  BOOST_CHECK_EQUAL(collection.popLast(), T(2));
+  thenCollectionContainsValues(collection, { 1 });
+  BOOST_CHECK_THROW(collection.erase(end(collection)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenPopping_ThenExceptionIsThrown,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection(name);
+
+  BOOST_CHECK_THROW(collection.popFirst(), std::logic_error);
+  BOOST_CHECK_THROW(collection.popLast(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenBulkAppend_WhenReading_ThenAllItemsAreStoredInOneVersion)
+{
+  const std::int32_t items[] = { 4, 5, 6, 7 };
+  LinearCollection<std::int32_t> collection(name);
+
+  collection.append(items, 4);
+
+  thenCollectionContainsValues(collection, { 4, 5, 6, 7 });
+  BOOST_CHECK_EQUAL(collection.getVersion(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenMovedFromCollection_WhenUsed_ThenItReadsEmptyAndRefusesChanges)
+{
+  LinearCollection<std::int32_t> collection(name);
+  collection.append(1);
+
+  LinearCollection<std::int32_t> moved(std::move(collection));
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.data() == nullptr);
+  BOOST_CHECK_EQUAL(collection.getVersion(), 0);
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 0);
+  BOOST_CHECK(collection.begin() == collection.end());
+  BOOST_CHECK_THROW(collection.append(2), std::logic_error);
+  BOOST_CHECK_THROW(LinearCollection<std::int32_t>::ReadLock guard(collection), std::logic_error);
+  thenCollectionContainsValues(moved, { 1 });
+  collection = std::move(moved);
+  thenCollectionContainsValues(collection, { 1 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenSegmentOfOtherType_WhenOpening_ThenExceptionIsThrown)
+{
+  LinearCollection<std::int32_t> collection(name);
+
+  BOOST_CHECK_THROW(LinearCollection<std::uint64_t> other(name), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenChildProcess_WhenItAppends_ThenParentSeesItemsWithoutCopying)
+{
+  LinearCollection<std::int32_t> collection(name, 4);
+  collection.append(1);
+
+  const pid_t child = ::fork();
+  if (child == 0) {
+    int status = 0;
+    try {
+      LinearCollection<std::int32_t> attached(name);
+      status = attached.getSize() == 1 ? 0 : 1;
+      for (int i = 2; i <= 100; ++i) {
+        attached.append(i);
+      }
+    }
+    catch (...) {
+      status = 2;
+    }
+    ::_exit(status);
+  }
+  BOOST_REQUIRE(child > 0);
+  int status = -1;
+  ::waitpid(child, &status, 0);
+  BOOST_REQUIRE(WIFEXITED(status));
+  BOOST_CHECK_EQUAL(WEXITSTATUS(status), 0);
+
+  const LinearCollection<std::int32_t>::ReadLock lock(collection);
+  const aisdi::Span<const std::int32_t> view = lock.view();
+  BOOST_CHECK_EQUAL(view.getSize(), 100);
+  BOOST_CHECK_EQUAL(view[99], 100);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,184 @@
+#include <SoAVector.h>
+
+#include <cstdint>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+namespace
+{
+
+using Records = aisdi::SoAVector<std::int32_t, double, std::string>;
+
+void thenIdsAre(const Records& records, std::initializer_list<std::int32_t> expected)
+{
+  const auto ids = records.column<0>();
+  BOOST_CHECK_EQUAL_COLLECTIONS(ids.begin(), ids.end(), expected.begin(), expected.end());
+}
+
+class FragileField
+{
+public:
+  FragileField(int value_ = 0)
+    : value(value_)
+  {}
+
+  FragileField(const FragileField& other)
+    : value(other.value)
+  {
+    throwIfFailing();
+  }
+
+  FragileField& operator=(const FragileField& other)
+  {
+    throwIfFailing();
+    value = other.value;
+    return *this;
+  }
+
+  static void throwIfFailing()
+  {
+    if (failCopies)
+    {
+      throw std::runtime_error("Copy failed");
+    }
+  }
+
+  int value;
+  static bool failCopies;
+};
+
+bool FragileField::failCopies = false;
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(SoAVectorTests)
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty)
+{
+  const Records records;
+
+  BOOST_CHECK(records.isEmpty());
+  BOOST_CHECK(records.column<1>().isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyCollection_WhenAppendingRows_ThenEveryColumnHoldsItsField)
+{
+  Records records;
+
+  records.append(1, 0.5, "one");
+  records.append(2, 1.5, "two");
+
+  BOOST_CHECK_EQUAL(records.getSize(), 2);
+  thenIdsAre(records, { 1, 2 });
+  BOOST_CHECK_EQUAL(records.column<1>()[1], 1.5);
+  BOOST_CHECK_EQUAL(records.column<2>()[0], "one");
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonEmptyCollection_WhenGettingRow_ThenAllFieldsAreReturned)
+{
+  Records records;
+  records.append(1, 0.5, "one");
+
+  const auto row = records.get(0);
+
+  BOOST_CHECK_EQUAL(std::get<0>(row), 1);
+  BOOST_CHECK_EQUAL(std::get<1>(row), 0.5);
+  BOOST_CHECK_EQUAL(std::get<2>(row), "one");
+  BOOST_CHECK_THROW(records.get(1), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonEmptyCollection_WhenInserting_ThenRowIsInsertedInEveryColumn)
+{
+  Records records;
+  records.append(1, 0.5, "one");
+  records.append(3, 2.5, "three");
+
+  records.insert(1, 2, 1.5, "two");
+  records.prepend(0, 0.0, "zero");
+
+  thenIdsAre(records, { 0, 1, 2, 3 });
+  BOOST_CHECK_EQUAL(records.column<2>()[2], "two");
+  BOOST_CHECK_THROW(records.insert(5, 9, 9.0, "nine"), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonEmptyCollection_WhenErasing_ThenRowsAreRemovedFromEveryColumn)
+{
+  Records records;
+  for (int i = 0; i < 6; ++i) {
+    records.append(i, i * 0.5, std::to_string(i));
+  }
+
+  records.erase(0);
+  records.erase(1, 3);
+
+  thenIdsAre(records, { 1, 4, 5 });
+  BOOST_CHECK_EQUAL(records.column<2>()[1], "4");
+  BOOST_CHECK_THROW(records.erase(3), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonEmptyCollection_WhenPopping_ThenRowsAreRemovedAndReturned)
+{
+  Records records;
+  records.append(1, 0.5, "one");
+  records.append(2, 1.5, "two");
+  records.append(3, 2.5, "three");
+
+  BOOST_CHECK_EQUAL(std::get<2>(records.popFirst()), "one");
+  BOOST_CHECK_EQUAL(std::get<0>(records.popLast()), 3);
+  thenIdsAre(records, { 2 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyCollection_WhenPopping_ThenOperationThrows)
+{
+  Records records;
+
+  BOOST_CHECK_THROW(records.popFirst(), std::logic_error);
+  BOOST_CHECK_THROW(records.popLast(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenFieldCopyThrows_WhenAppendingOrInserting_ThenColumnsStayInStep)
+{
+  aisdi::SoAVector<std::int32_t, FragileField, double> records;
+  for (int i = 0; i < 4; ++i) {
+    records.append(i, FragileField(i), i * 0.5);
+  }
+
+  FragileField::failCopies = true;
+  BOOST_CHECK_THROW(records.append(4, FragileField(4), 2.0), std::runtime_error);
+  BOOST_CHECK_THROW(records.insert(1, 9, FragileField(9), 4.5), std::runtime_error);
+  FragileField::failCopies = false;
+
+  BOOST_CHECK_EQUAL(records.getSize(), 4);
+  BOOST_CHECK_EQUAL(records.column<1>().getSize(), 4);
+  BOOST_CHECK_EQUAL(records.column<2>().getSize(), 4);
+  const auto ids = records.column<0>();
+  const std::vector<std::int32_t> expected = { 0, 1, 2, 3 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(ids.begin(), ids.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(records.column<1>()[3].value, 3);
+  records.append(4, FragileField(4), 2.0);
+  BOOST_CHECK_EQUAL(records.column<2>()[4], 2.0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenColumnSpan_WhenModifyingThroughIt_ThenCollectionIsUpdated)
+{
+  Records records;
+  records.reserve(3);
+  records.append(1, 0.5, "one");
+  records.append(2, 1.5, "two");
+
+  for (auto& value : records.column<1>()) {
+    value *= 2;
+  }
+
+  const auto values = records.column<1>();
+  BOOST_CHECK_EQUAL(std::accumulate(values.begin(), values.end(), 0.0), 4.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,78 @@
+#ifndef AISDI_LINEAR_TRACKINGALLOCATOR_H
+#define AISDI_LINEAR_TRACKINGALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Outstanding allocations per allocator id, shared by every test translation unit.
+inline long* liveAllocations()
+{
+  static long counts[3];
+  return counts;
+}
+
+inline long& constructedElements()
+{
+  static long count;
+  return count;
+}
+
+// Stateful allocator identified by id; Propagate selects the propagate_on_container_* traits.
+template <typename T, bool Propagate>
+class TrackingAllocator
+{
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::integral_constant<bool, Propagate>;
+  using propagate_on_container_move_assignment = std::integral_constant<bool, Propagate>;
+
+  template <typename U>
+  struct rebind
+  {
+    using other = TrackingAllocator<U, Propagate>;
+  };
+
+  explicit TrackingAllocator(int id_ = 0)
+    : id(id_)
+  {}
+
+  template <typename U>
+  TrackingAllocator(const TrackingAllocator<U, Propagate>& other)
+    : id(other.id)
+  {}
+
+  T* allocate(std::size_t count)
+  {
+    ++liveAllocations()[id];
+    return static_cast<T*>(::operator new(count * sizeof(T)));
+  }
+
+  void deallocate(T* memory, std::size_t)
+  {
+    --liveAllocations()[id];
+    ::operator delete(memory);
+  }
+
+  template <typename U, typename... Args>
+  void construct(U* memory, Args&&... args)
+  {
+    ++constructedElements();
+    ::new (static_cast<void*>(memory)) U(std::forward<Args>(args)...);
+  }
+
+  bool operator==(const TrackingAllocator& other) const
+  {
+    return id == other.id;
+  }
+
+  bool operator!=(const TrackingAllocator& other) const
+  {
+    return id != other.id;
+  }
+
+  int id;
+};
+
+#endif // AISDI_LINEAR_TRACKINGALLOCATOR_H
@@ -1,15 +1,27 @@
 #include <Vector.h>
+#include <FdSerialization.h>
 
 #include <initializer_list>
+#include <iterator>
 #include <complex>
 #include <cstdint>
 #include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <unistd.h>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/test_tools.hpp>
 
 #include <boost/mpl/list.hpp>
 
+#include "TrackingAllocator.h"
+
 namespace
 {
 
@@ -296,6 +308,26 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPreIncrementing_ThenNewPositionI
   BOOST_CHECK(it == collection.end());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenAdvancing_ThenItJumpsAsRandomAccessIterator,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4 };
+  using Category = typename std::iterator_traits<typename LinearCollection<T>::const_iterator>::iterator_category;
+
+  auto it = collection.begin();
+  it += 3;
+  const auto next = std::next(collection.cbegin(), 2);
+
+  BOOST_CHECK((std::is_same<Category, std::random_access_iterator_tag>::value));
+  BOOST_CHECK_EQUAL(*it, 4);
+  BOOST_CHECK_EQUAL(*next, 3);
+  BOOST_CHECK_EQUAL(next[-1], 2);
+  BOOST_CHECK_EQUAL(it - next, 1);
+  it[-3] = 5;
+  BOOST_CHECK_EQUAL(*collection.begin(), 5);
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEndIterator_WhenIncrementing_ThenOperationThrows,
                               T,
                               TestedTypes)
@@ -513,6 +545,55 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAssigningToOther_ThenOthe
   BOOST_CHECK(other.isEmpty());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionsOfSameSize_WhenAssigning_ThenStorageIsReused,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { 1, 2, 3, 4 };
+  LinearCollection<T> other = { 100, 200, 300, 400 };
+  const T* storage = other.data();
+
+  OperationCountingObject::resetCounters();
+  other = collection;
+
+  BOOST_CHECK(other.data() == storage);
+  thenCollectionContainsValues(other, { 1, 2, 3, 4 });
+  thenConstructedObjectsCountWas<T>(0);
+  thenAssignedObjectsCountWas<T>(4);
+  thenDestroyedObjectsCountWas<T>(0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLongerCollection_WhenAssigningShorterOne_ThenCapacityIsKept,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection = { 1, 2 };
+  LinearCollection<T> other = { 100, 200, 300, 400, 500 };
+  const std::size_t capacity = other.getCapacity();
+
+  other = collection;
+  other.append(3);
+
+  BOOST_CHECK_EQUAL(other.getCapacity(), capacity);
+  thenCollectionContainsValues(other, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenShorterCollection_WhenAssigningLongerOne_ThenItGrows,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+  for (int i = 0; i < 100; ++i) {
+    collection.append(i);
+  }
+  LinearCollection<T> other = { 100, 200 };
+
+  other = collection;
+
+  BOOST_CHECK_EQUAL(other.getSize(), 100);
+  BOOST_CHECK_EQUAL_COLLECTIONS(other.begin(), other.end(), collection.begin(), collection.end());
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenSelfAssigning_ThenNothingHappens,
                               T,
                               TestedTypes)
@@ -680,6 +761,58 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInsertingInMiddle_Then
   thenCollectionContainsValues(collection, { 11, 42, 12, 13 });
 }
 
+BOOST_AUTO_TEST_CASE(GivenNonEmptyCollection_WhenInsertingTemporary_ThenNothingIsCopied)
+{
+  LinearCollection<OperationCountingObject> collection = { 11, 12, 13 };
+  collection.reserve(8);
+
+  OperationCountingObject::resetCounters();
+  collection.insert(++begin(collection), OperationCountingObject(42));
+  collection.prepend(OperationCountingObject(10));
+
+  BOOST_CHECK_EQUAL(OperationCountingObject::copiedObjectsCount(), 0);
+  thenCollectionContainsValues(collection, { 10, 11, 42, 12, 13 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonEmptyCollection_WhenInsertingOwnElement_ThenItsValueIsInserted)
+{
+  LinearCollection<std::string> collection = { "first", "second" };
+
+  collection.insert(begin(collection), *begin(collection));
+  collection.insert(begin(collection) + 1, *(begin(collection) + 2));
+
+  const std::string expected[] = { "first", "second", "first", "second" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(expected), end(expected));
+}
+
+BOOST_AUTO_TEST_CASE(GivenSpareCapacity_WhenAppendingCopy_ThenItemIsCopiedOnceWithoutMoves)
+{
+  LinearCollection<OperationCountingObject> collection = { 11, 12, 13 };
+  collection.reserve(8);
+  const OperationCountingObject item(14);
+
+  OperationCountingObject::resetCounters();
+  collection.append(item);
+
+  BOOST_CHECK_EQUAL(OperationCountingObject::assignedObjectsCount(), 1);
+  BOOST_CHECK_EQUAL(OperationCountingObject::copiedObjectsCount(), 0);
+  BOOST_CHECK_EQUAL(OperationCountingObject::movedObjectsCount(), 0);
+  thenCollectionContainsValues(collection, { 11, 12, 13, 14 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenSpareCapacity_WhenInsertingOwnElementBeforeIt_ThenItsValueIsInserted)
+{
+  LinearCollection<std::string> collection = { "first", "second", "third" };
+  collection.reserve(8);
+
+  collection.insert(begin(collection), *(begin(collection) + 1));
+  collection.insert(begin(collection) + 3, *(begin(collection) + 3));
+  collection.insert(begin(collection) + 5, *begin(collection));
+
+  const std::string expected[] = { "second", "first", "second", "third", "third", "second" };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(expected), end(expected));
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInserting_ThenSizeIsUpdated,
                               T,
                               TestedTypes)
@@ -949,6 +1082,824 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(WhenFittedToSize_NumberOfDestroyedElementsEqualsEl
   thenDestroyedObjectsCountWas<T>(5);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingIf_ThenMatchingItemsAreRemoved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 3, 4, 1, 5 };
+
+  auto removed = collection.eraseIf([](const T& item) { return item == T(1) || item == T(3); });
+
+  BOOST_CHECK_EQUAL(removed, 4);
+  thenCollectionContainsValues(collection, { 2, 4, 5 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingIfNothingMatches_ThenNothingHappens,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  auto removed = collection.eraseIf([](const T& item) { return item == T(7); });
+
+  BOOST_CHECK_EQUAL(removed, 0);
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingIfEverythingMatches_ThenCollectionIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  auto removed = collection.eraseIf([](const T&) { return true; });
+
+  BOOST_CHECK_EQUAL(removed, 3);
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(begin(collection) == end(collection));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionAfterErasingIf_WhenAddingItems_ThenCollectionStaysConsistent,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 1, 2, 1, 1 };
+
+  collection.eraseIf([](const T& item) { return item == T(1); });
+  collection.prepend(0);
+  collection.append(3);
+
+  thenCollectionContainsValues(collection, { 0, 2, 3 });
+  BOOST_CHECK_EQUAL(*(--end(collection)), T(3));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenRemovingValue_ThenAllOccurrencesAreRemoved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 5, 6, 5, 7, 5 };
+
+  auto removed = collection.removeValue(5);
+
+  BOOST_CHECK_EQUAL(removed, 3);
+  thenCollectionContainsValues(collection, { 6, 7 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithAdjacentDuplicates_WhenMakingUnique_ThenRunsAreCollapsed,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 1, 2, 3, 3, 3, 1, 4, 4 };
+
+  auto removed = collection.uniqueInPlace();
+
+  BOOST_CHECK_EQUAL(removed, 4);
+  thenCollectionContainsValues(collection, { 1, 2, 3, 1, 4 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenMakingUnique_ThenNothingHappens,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+
+  BOOST_CHECK_EQUAL(collection.uniqueInPlace(), 0);
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingAtPositions_ThenItemsAreRemoved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 10, 11, 12, 13, 14, 15, 16 };
+
+  auto removed = collection.eraseAt({ 0, 2, 3, 6 });
+
+  BOOST_CHECK_EQUAL(removed, 4);
+  thenCollectionContainsValues(collection, { 11, 14, 15 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingAtPositionsFromContainer_ThenItemsAreRemoved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 10, 11, 12, 13 };
+  const aisdi::Vector<std::size_t> positions = { 1, 2 };
+
+  collection.eraseAt(positions);
+
+  thenCollectionContainsValues(collection, { 10, 13 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenUnsortedPositions_WhenErasingAt_ThenOperationThrows,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 10, 11, 12, 13 };
+
+  BOOST_CHECK_THROW(collection.eraseAt({ 2, 1 }), std::invalid_argument);
+  thenCollectionContainsValues(collection, { 10, 11, 12, 13 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenPositionPastEnd_WhenErasingAt_ThenOperationThrows,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 10, 11, 12, 13 };
+
+  BOOST_CHECK_THROW(collection.eraseAt({ 1, 4 }), std::out_of_range);
+  thenCollectionContainsValues(collection, { 10, 11, 12, 13 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingRanges_ThenItemsAreRemoved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 10, 11, 12, 13, 14, 15, 16, 17 };
+
+  auto removed = collection.eraseRanges({ { 0, 2 }, { 3, 3 }, { 4, 6 }, { 7, 8 } });
+
+  BOOST_CHECK_EQUAL(removed, 5);
+  thenCollectionContainsValues(collection, { 12, 13, 16 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenOverlappingRanges_WhenErasingRanges_ThenOperationThrows,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 10, 11, 12, 13 };
+
+  BOOST_CHECK_THROW(collection.eraseRanges({ { 0, 2 }, { 1, 3 } }), std::invalid_argument);
+  thenCollectionContainsValues(collection, { 10, 11, 12, 13 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenSwapRemoving_ThenLastItemFillsTheHole,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4 };
+
+  auto it = collection.swapRemove(begin(collection) + 1);
+
+  thenCollectionContainsValues(collection, { 1, 4, 3 });
+  BOOST_CHECK_EQUAL(*it, T(4));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenSwapRemovingLastItem_ThenEndIsReturned,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  auto it = collection.swapRemove(end(collection) - 1);
+
+  thenCollectionContainsValues(collection, { 1, 2 });
+  BOOST_CHECK(it == end(collection));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenSwapRemovingEnd_ThenOperationThrows,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  BOOST_CHECK_THROW(collection.swapRemove(end(collection)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenScanningCollection_WhenSwapRemovingDuringScan_ThenEveryItemIsVisited,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 2, 3, 2 };
+
+  for (auto it = begin(collection); it != end(collection);) {
+    if (*it == T(2)) {
+      it = collection.swapRemove(it);
+    }
+    else {
+      ++it;
+    }
+  }
+
+  thenCollectionContainsValues(collection, { 1, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenSwapRemovingIf_ThenMatchingItemsAreRemoved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 7, 1, 7, 2, 7, 7 };
+
+  auto removed = collection.swapRemoveIf([](const T& item) { return item == T(7); });
+
+  BOOST_CHECK_EQUAL(removed, 4);
+  thenCollectionContainsValues(collection, { 2, 1 });
+}
+
+using SerializableTypes = boost::mpl::list<std::int32_t,
+                                           std::uint64_t,
+                                           std::complex<std::int32_t>>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenSavedAndLoaded_ThenItemsAreRestored,
+                              T,
+                              SerializableTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4 };
+  LinearCollection<T> loaded = { 9 };
+  std::stringstream stream;
+
+  collection.save(stream);
+  loaded.load(stream);
+
+  thenCollectionContainsValues(loaded, { 1, 2, 3, 4 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenSavedAndLoaded_ThenLoadedCollectionIsEmpty,
+                              T,
+                              SerializableTypes)
+{
+  LinearCollection<T> collection;
+  LinearCollection<T> loaded = { 9 };
+  std::stringstream stream;
+
+  collection.save(stream);
+  loaded.load(stream);
+
+  BOOST_CHECK(loaded.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenLargeCollection_WhenSavedAndLoaded_ThenItemsAreRestored)
+{
+  LinearCollection<std::uint64_t> collection;
+  for (std::uint64_t i = 0; i < 100000; ++i) {
+    collection.append(i * 7);
+  }
+  LinearCollection<std::uint64_t> loaded;
+  std::stringstream stream;
+
+  collection.save(stream);
+  loaded.load(stream);
+
+  BOOST_CHECK_EQUAL(loaded.getSize(), 100000);
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(loaded), end(loaded));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollectionOfStrings_WhenSavedAndLoaded_ThenItemsAreRestored)
+{
+  LinearCollection<std::string> collection = { "", "a", std::string(100000, 'x') };
+  LinearCollection<std::string> loaded;
+  std::stringstream stream;
+
+  collection.save(stream);
+  loaded.load(stream);
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(loaded), end(loaded));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCorruptedStream_WhenLoading_ThenOperationThrowsAndCollectionIsUnchanged)
+{
+  LinearCollection<std::int32_t> collection = { 1, 2, 3 };
+  LinearCollection<std::int32_t> loaded = { 9 };
+  std::stringstream stream;
+  collection.save(stream);
+  std::string bytes = stream.str();
+  bytes[bytes.size() - 20] ^= 1;
+  std::stringstream corrupted(bytes);
+
+  BOOST_CHECK_THROW(loaded.load(corrupted), std::runtime_error);
+  thenCollectionContainsValues(loaded, { 9 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenTruncatedStream_WhenLoading_ThenOperationThrows)
+{
+  LinearCollection<std::int32_t> collection = { 1, 2, 3 };
+  LinearCollection<std::int32_t> loaded;
+  std::stringstream stream;
+  collection.save(stream);
+  std::stringstream truncated(stream.str().substr(0, stream.str().size() - 12));
+
+  BOOST_CHECK_THROW(loaded.load(truncated), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenDifferentElementType_WhenLoading_ThenOperationThrows)
+{
+  LinearCollection<std::uint64_t> collection = { 1, 2, 3 };
+  LinearCollection<std::int32_t> loaded;
+  std::stringstream stream;
+  collection.save(stream);
+
+  BOOST_CHECK_THROW(loaded.load(stream), std::runtime_error);
+}
+
+std::string withElementCount(std::string bytes, std::uint64_t count)
+{
+  // the count follows magic, version, flags, element size and a reserved word
+  bytes.replace(16, sizeof(count), reinterpret_cast<const char*>(&count), sizeof(count));
+  return bytes;
+}
+
+BOOST_AUTO_TEST_CASE(GivenCorruptElementCount_WhenLoading_ThenOperationThrowsInsteadOfAllocating)
+{
+  LinearCollection<std::int32_t> collection = { 1, 2, 3 };
+  LinearCollection<std::int32_t> loaded = { 9 };
+  std::stringstream stream;
+  collection.save(stream);
+
+  for (std::uint64_t count : { std::uint64_t(1) << 40, std::uint64_t(1) << 62, ~std::uint64_t(0) }) {
+    std::stringstream corrupted(withElementCount(stream.str(), count));
+    BOOST_CHECK_THROW(loaded.load(corrupted), std::runtime_error);
+  }
+  thenCollectionContainsValues(loaded, { 9 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenCorruptElementCountInFile_WhenLoading_ThenOperationThrows)
+{
+  LinearCollection<std::int32_t> collection = { 1, 2, 3 };
+  LinearCollection<std::int32_t> loaded;
+  std::stringstream stream;
+  collection.save(stream);
+  const std::string bytes = withElementCount(stream.str(), std::uint64_t(1) << 40);
+  std::FILE* file = std::tmpfile();
+  const int fd = fileno(file);
+
+  BOOST_REQUIRE_EQUAL(write(fd, bytes.data(), bytes.size()), ssize_t(bytes.size()));
+  lseek(fd, 0, SEEK_SET);
+
+  BOOST_CHECK_THROW(aisdi::load(loaded, fd), std::runtime_error);
+  std::fclose(file);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCorruptStringLength_WhenLoading_ThenOperationThrows)
+{
+  LinearCollection<std::string> collection = { "abc" };
+  LinearCollection<std::string> loaded;
+  std::stringstream stream;
+  collection.save(stream);
+  std::string bytes = stream.str();
+  // the first string length follows the header and the frame length
+  const std::uint64_t length = std::uint64_t(1) << 60;
+  bytes.replace(32, sizeof(length), reinterpret_cast<const char*>(&length), sizeof(length));
+  std::stringstream corrupted(bytes);
+
+  BOOST_CHECK_THROW(loaded.load(corrupted), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GivenFileDescriptor_WhenSavedAndLoaded_ThenItemsAreRestored)
+{
+  LinearCollection<std::int32_t> collection = { 1, 2, 3 };
+  LinearCollection<std::int32_t> other = { 4, 5 };
+  LinearCollection<std::int32_t> loaded;
+  LinearCollection<std::int32_t> loadedOther;
+  std::FILE* file = std::tmpfile();
+  const int fd = fileno(file);
+
+  aisdi::save(collection, fd);
+  aisdi::save(other, fd);
+  lseek(fd, 0, SEEK_SET);
+  aisdi::load(loaded, fd);
+  aisdi::load(loadedOther, fd);
+  std::fclose(file);
+
+  thenCollectionContainsValues(loaded, { 1, 2, 3 });
+  thenCollectionContainsValues(loadedOther, { 4, 5 });
+}
+
+using ScannedTypes = boost::mpl::list<std::int32_t,
+                                      std::uint64_t,
+                                      float,
+                                      double,
+                                      std::int16_t>;
+
+template <typename T>
+LinearCollection<T> rampOf(std::size_t size)
+{
+  LinearCollection<T> collection;
+  for (std::size_t i = 0; i < size; ++i) {
+    collection.append(T(i % 50));
+  }
+  return collection;
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionsOfManySizes_WhenFinding_ThenFirstOccurrenceIsReturned,
+                              T,
+                              ScannedTypes)
+{
+  for (std::size_t size = 0; size < 40; ++size) {
+    const LinearCollection<T> collection = rampOf<T>(size);
+    for (std::size_t value = 0; value <= size; ++value) {
+      auto expected = value < size ? collection.begin() + value : collection.end();
+      BOOST_CHECK(collection.find(T(value)) == expected);
+      BOOST_CHECK_EQUAL(collection.contains(T(value)), value < size);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenFindingMutably_ThenItemCanBeChanged,
+                              T,
+                              ScannedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  *collection.find(T(2)) = T(7);
+
+  thenCollectionContainsValues(collection, { 1, 7, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeCollection_WhenCounting_ThenAllOccurrencesAreCounted,
+                              T,
+                              ScannedTypes)
+{
+  const LinearCollection<T> collection = rampOf<T>(1003);
+
+  BOOST_CHECK_EQUAL(collection.count(T(0)), 21);
+  BOOST_CHECK_EQUAL(collection.count(T(2)), 21);
+  BOOST_CHECK_EQUAL(collection.count(T(3)), 20);
+  BOOST_CHECK_EQUAL(collection.count(T(99)), 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeCollection_WhenLookingForAnyOfValues_ThenFirstMatchIsReturned,
+                              T,
+                              ScannedTypes)
+{
+  const LinearCollection<T> collection = rampOf<T>(1000);
+  const LinearCollection<T> values = { 49, 37 };
+
+  BOOST_CHECK_EQUAL(collection.indexOfAny({ 45, 17, 30 }), 17);
+  BOOST_CHECK_EQUAL(collection.indexOfAny(values), 37);
+  BOOST_CHECK_EQUAL(collection.indexOfAny({ 77, 88 }), 1000);
+  BOOST_CHECK_EQUAL(collection.indexOfAny({}), 1000);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeCollection_WhenLookingForExtremes_ThenFirstOccurrencesAreReturned,
+                              T,
+                              ScannedTypes)
+{
+  LinearCollection<T> collection = rampOf<T>(1000);
+  collection.data()[501] = T(60);
+  collection.data()[700] = T(60);
+
+  BOOST_CHECK(collection.minElement() == collection.begin());
+  BOOST_CHECK(collection.maxElement() == collection.begin() + 501);
+}
+
+BOOST_AUTO_TEST_CASE(GivenEmptyCollection_WhenLookingForExtremes_ThenEndIsReturned)
+{
+  const LinearCollection<float> collection;
+
+  BOOST_CHECK(collection.minElement() == collection.end());
+  BOOST_CHECK(collection.maxElement() == collection.end());
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollectionWithNaNs_WhenLookingForExtremes_ThenNaNsAreSkipped)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  LinearCollection<double> collection = rampOf<double>(100);
+  collection.data()[0] = nan;
+  collection.data()[63] = nan;
+  const LinearCollection<double> onlyNaNs = { nan, nan };
+
+  BOOST_CHECK(collection.minElement() == collection.begin() + 50);
+  BOOST_CHECK(collection.maxElement() == collection.begin() + 49);
+  BOOST_CHECK(onlyNaNs.minElement() == onlyNaNs.begin());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeCollection_WhenSumming_ThenTotalIsReturned,
+                              T,
+                              ScannedTypes)
+{
+  const LinearCollection<T> collection = rampOf<T>(1003);
+
+  BOOST_CHECK_EQUAL(collection.sum(), 20 * 1225 + 3);
+}
+
+BOOST_AUTO_TEST_CASE(GivenLargeIntegers_WhenSumming_ThenTotalDoesNotOverflowElementType)
+{
+  LinearCollection<std::int32_t> collection;
+  for (int i = 0; i < 100; ++i) {
+    collection.append(std::numeric_limits<std::int32_t>::max());
+    collection.append(-1);
+  }
+
+  BOOST_CHECK_EQUAL(collection.sum(), 100LL * std::numeric_limits<std::int32_t>::max() - 100);
+}
+
+BOOST_AUTO_TEST_CASE(GivenLargeCollection_WhenUsingBaselineKernels_ThenResultsMatchDispatchedOnes)
+{
+  namespace simd = aisdi::detail::simd;
+  const LinearCollection<float> collection = rampOf<float>(1001);
+  const float values[] = { 45.0f, 47.0f };
+
+  BOOST_CHECK_EQUAL((simd::Find::run<16>(collection.data(), 1001, 48.0f)), 48);
+  BOOST_CHECK_EQUAL((simd::Count::run<16>(collection.data(), 1001, 0.0f)), 21);
+  BOOST_CHECK_EQUAL((simd::FindAny::run<16>(collection.data(), 1001, values, 2)), 45);
+  BOOST_CHECK_EQUAL((simd::Extreme<true>::run<16>(collection.data(), 1001)), 49.0f);
+  BOOST_CHECK_EQUAL((simd::Sum::run<16>(collection.data(), 1001)), collection.sum());
+}
+
+using ComparedTypes = boost::mpl::list<std::int32_t,
+                                       std::uint64_t,
+                                       double,
+                                       std::string>;
+
+template <typename T>
+T comparedItem(int value)
+{
+  return T(value);
+}
+
+template <>
+std::string comparedItem<std::string>(int value)
+{
+  return std::to_string(value);
+}
+
+template <typename T>
+LinearCollection<T> comparedCollection(std::size_t size)
+{
+  LinearCollection<T> collection;
+  for (std::size_t i = 0; i < size; ++i) {
+    collection.append(comparedItem<T>(i % 7));
+  }
+  return collection;
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionsWithSameItems_WhenComparing_ThenTheyAreEqual,
+                              T,
+                              ComparedTypes)
+{
+  const LinearCollection<T> collection = comparedCollection<T>(100);
+  const LinearCollection<T> other = comparedCollection<T>(100);
+
+  BOOST_CHECK(collection == other);
+  BOOST_CHECK(!(collection != other));
+  BOOST_CHECK(!(collection < other));
+  BOOST_CHECK(collection <= other);
+  BOOST_CHECK(collection >= other);
+  BOOST_CHECK(LinearCollection<T>() == LinearCollection<T>());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionsDifferingInOneItem_WhenComparing_ThenOrderFollowsThatItem,
+                              T,
+                              ComparedTypes)
+{
+  const LinearCollection<T> collection = comparedCollection<T>(100);
+  LinearCollection<T> other = comparedCollection<T>(100);
+  other.data()[90] = comparedItem<T>(8);
+
+  BOOST_CHECK(collection != other);
+  BOOST_CHECK(collection < other);
+  BOOST_CHECK(other > collection);
+  BOOST_CHECK(!(other <= collection));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionAndItsPrefix_WhenComparing_ThenPrefixIsSmaller,
+                              T,
+                              ComparedTypes)
+{
+  const LinearCollection<T> collection = comparedCollection<T>(100);
+  const LinearCollection<T> prefix = comparedCollection<T>(99);
+
+  BOOST_CHECK(collection != prefix);
+  BOOST_CHECK(prefix < collection);
+  BOOST_CHECK(!(collection < prefix));
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollectionsWithNaN_WhenComparing_ThenTheyAreNotEqualButUnordered)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const LinearCollection<double> collection = { 1, nan, 3 };
+  const LinearCollection<double> other = { 1, nan, 3 };
+  const LinearCollection<double> greater = { 1, nan, 4 };
+
+  BOOST_CHECK(collection != other);
+  BOOST_CHECK(!(collection < other));
+  BOOST_CHECK(collection < greater);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEqualCollections_WhenHashing_ThenHashesAreEqual,
+                              T,
+                              ComparedTypes)
+{
+  const LinearCollection<T> collection = comparedCollection<T>(100);
+  const LinearCollection<T> other = comparedCollection<T>(100);
+
+  BOOST_CHECK_EQUAL(collection.hash(), other.hash());
+  BOOST_CHECK_EQUAL(collection.hash(5), other.hash(5));
+  BOOST_CHECK_EQUAL(std::hash<LinearCollection<T>>()(collection), std::hash<LinearCollection<T>>()(other));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenDifferentCollections_WhenHashing_ThenHashesDiffer,
+                              T,
+                              ComparedTypes)
+{
+  const LinearCollection<T> collection = comparedCollection<T>(100);
+  LinearCollection<T> other = comparedCollection<T>(100);
+  other.data()[50] = comparedItem<T>(9);
+
+  BOOST_CHECK_NE(collection.hash(), other.hash());
+  BOOST_CHECK_NE(collection.hash(), comparedCollection<T>(99).hash());
+  BOOST_CHECK_NE(collection.hash(1), collection.hash(2));
+}
+
+BOOST_AUTO_TEST_CASE(GivenBuffersOfEveryLength_WhenHashing_ThenEachByteMatters)
+{
+  for (std::size_t size = 0; size < 120; ++size) {
+    LinearCollection<std::uint8_t> collection;
+    for (std::size_t i = 0; i < size; ++i) {
+      collection.append(std::uint8_t(i));
+    }
+    const auto hash = collection.hash();
+    for (std::size_t i = 0; i < size; ++i) {
+      collection.data()[i] ^= 0x80;
+      BOOST_CHECK_NE(collection.hash(), hash);
+      collection.data()[i] ^= 0x80;
+    }
+    collection.append(0);
+    BOOST_CHECK_NE(collection.hash(), hash);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenZeroesOfBothSigns_WhenHashing_ThenHashesAreEqual)
+{
+  const LinearCollection<double> collection = { 0.0, 1.0 };
+  const LinearCollection<double> other = { -0.0, 1.0 };
+
+  BOOST_CHECK(collection == other);
+  BOOST_CHECK_EQUAL(collection.hash(), other.hash());
+}
+
+template <typename T>
+bool isAlignedTo(const T* pointer, std::size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenAlignedCollection_WhenGrowing_ThenBufferStaysAligned,
+                              T,
+                              TestedTypes)
+{
+  aisdi::AlignedVector<T> collection;
+
+  for (int i = 0; i < 100; ++i) {
+    collection.append(T(i));
+    BOOST_CHECK(isAlignedTo(collection.data(), 64));
+  }
+  collection.fitToSize();
+
+  BOOST_CHECK(isAlignedTo(collection.data(), 64));
+  BOOST_CHECK_EQUAL(collection.getSize(), 100);
+  BOOST_CHECK(*(collection.end() - 1) == T(99));
+}
+
+BOOST_AUTO_TEST_CASE(GivenAlignedCollection_WhenFittedToSize_ThenCapacityIsPaddedToWholeBlocks)
+{
+  aisdi::AlignedVector<std::int32_t> collection = { 1, 2, 3 };
+
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 16);
+  for (int i = 0; i < 14; ++i) {
+    collection.append(i);
+  }
+  collection.fitToSize();
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 17);
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 32);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollectionWithDefaultAlignment_WhenFittedToSize_ThenCapacityEqualsSize)
+{
+  LinearCollection<std::int32_t> collection = { 1, 2, 3 };
+
+  collection.append(4);
+  collection.append(5);
+  collection.fitToSize();
+
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(GivenAlignedCollection_WhenCopied_ThenCopyIsAlignedAndEqual)
+{
+  aisdi::AlignedVector<double, 128> collection = { 1.5, 2.5, 3.5 };
+  aisdi::AlignedVector<double, 128> assigned = { 7 };
+
+  aisdi::AlignedVector<double, 128> copy = collection;
+  assigned = collection;
+
+  BOOST_CHECK(isAlignedTo(copy.data(), 128));
+  BOOST_CHECK(isAlignedTo(assigned.data(), 128));
+  BOOST_CHECK(copy == collection);
+  BOOST_CHECK(assigned == collection);
+  BOOST_CHECK_EQUAL(copy.sum(), 7.5);
+}
+
+template <bool Propagate>
+using TrackedCollection = aisdi::Vector<int, TrackingAllocator<int, Propagate>>;
+
+BOOST_AUTO_TEST_CASE(GivenTrivialElements_WhenCollectionGrows_ThenSpareCapacityIsNotInitialized)
+{
+  TrackedCollection<false> collection;
+  const long constructed = constructedElements();
+
+  for (int i = 0; i < 1000; ++i) {
+    collection.append(i);
+  }
+  collection.reserve(100000);
+
+  BOOST_CHECK_EQUAL(constructedElements(), constructed);
+  BOOST_CHECK_EQUAL(collection.getSize(), 1000);
+  BOOST_CHECK_EQUAL(*(collection.end() - 1), 999);
+}
+
+struct FailingAssignment
+{
+  FailingAssignment& operator=(const FailingAssignment&)
+  {
+    if (fail) {
+      throw std::runtime_error("assignment failed");
+    }
+    return *this;
+  }
+
+  static bool fail;
+};
+
+bool FailingAssignment::fail = false;
+
+BOOST_AUTO_TEST_CASE(GivenThrowingCopy_WhenCollectionGrows_ThenNewArrayIsReleased)
+{
+  {
+    using Allocator = TrackingAllocator<FailingAssignment, false>;
+    aisdi::Vector<FailingAssignment, Allocator> collection{Allocator(1)};
+    collection.append(FailingAssignment());
+
+    FailingAssignment::fail = true;
+    BOOST_CHECK_THROW(collection.reserve(100), std::runtime_error);
+    FailingAssignment::fail = false;
+
+    BOOST_CHECK_EQUAL(collection.getSize(), 1);
+    BOOST_CHECK_EQUAL(liveAllocations()[1], 1);
+  }
+
+  BOOST_CHECK_EQUAL(liveAllocations()[1], 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenStatefulAllocator_WhenCollectionGrowsAndDies_ThenAllMemoryGoesBackToIt)
+{
+  {
+    TrackedCollection<false> collection{TrackingAllocator<int, false>(1)};
+    for (int i = 0; i < 100; ++i) {
+      collection.append(i);
+    }
+    TrackedCollection<false> copy = collection;
+
+    BOOST_CHECK_EQUAL(copy.get_allocator().id, 1);
+    BOOST_CHECK_EQUAL(liveAllocations()[1], 2);
+  }
+
+  BOOST_CHECK_EQUAL(liveAllocations()[1], 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenNonPropagatingAllocators_WhenAssigning_ThenTargetKeepsItsAllocator)
+{
+  {
+    TrackedCollection<false> collection({ 1, 2, 3 }, TrackingAllocator<int, false>(1));
+    TrackedCollection<false> copied{TrackingAllocator<int, false>(2)};
+    TrackedCollection<false> moved{TrackingAllocator<int, false>(2)};
+
+    copied = collection;
+    moved = std::move(collection);
+
+    BOOST_CHECK_EQUAL(copied.get_allocator().id, 2);
+    BOOST_CHECK_EQUAL(moved.get_allocator().id, 2);
+    BOOST_CHECK(copied == moved);
+    BOOST_CHECK_EQUAL(liveAllocations()[1], 1);
+    BOOST_CHECK_EQUAL(liveAllocations()[2], 2);
+  }
+
+  BOOST_CHECK_EQUAL(liveAllocations()[1], 0);
+  BOOST_CHECK_EQUAL(liveAllocations()[2], 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenPropagatingAllocators_WhenAssigning_ThenTargetTakesSourceAllocator)
+{
+  {
+    TrackedCollection<true> collection({ 1, 2, 3 }, TrackingAllocator<int, true>(1));
+    TrackedCollection<true> copied{TrackingAllocator<int, true>(2)};
+    TrackedCollection<true> moved{TrackingAllocator<int, true>(2)};
+    const int* buffer = collection.data();
+
+    copied = collection;
+    moved = std::move(collection);
+
+    BOOST_CHECK_EQUAL(copied.get_allocator().id, 1);
+    BOOST_CHECK_EQUAL(moved.get_allocator().id, 1);
+    BOOST_CHECK(moved.data() == buffer);
+    BOOST_CHECK(copied == moved);
+    BOOST_CHECK_EQUAL(liveAllocations()[2], 0);
+  }
+
+  BOOST_CHECK_EQUAL(liveAllocations()[1], 0);
+}
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 
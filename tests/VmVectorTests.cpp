@@ -0,0 +1,440 @@
+#include <VmVector.h>
+
+#include <initializer_list>
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+namespace
+{
+
+class OperationCountingObject
+{
+public:
+  OperationCountingObject(int value_ = 0)
+    : value(value_)
+  {
+    ++constructedObjects;
+  }
+
+  OperationCountingObject(const OperationCountingObject& other)
+    : value(std::move(other.value))
+  {
+    ++constructedObjects;
+    ++copiedObjects;
+  }
+
+  OperationCountingObject(OperationCountingObject&& other)
+    : value(other.value)
+  {
+    ++constructedObjects;
+    ++movedObjects;
+  }
+
+  ~OperationCountingObject()
+  {
+    ++destroyedObjects;
+  }
+
+  OperationCountingObject& operator=(const OperationCountingObject& other)
+  {
+    ++assignedObjects;
+    value = other.value;
+    return *this;
+  }
+
+  OperationCountingObject& operator=(OperationCountingObject&& other)
+  {
+    ++assignedObjects;
+    ++movedObjects;
+    value = std::move(other.value);
+    return *this;
+  }
+
+  operator int() const
+  {
+    return value;
+  }
+
+  static void resetCounters()
+  {
+    constructedObjects = 0;
+    destroyedObjects = 0;
+    copiedObjects = 0;
+    movedObjects = 0;
+    assignedObjects = 0;
+  }
+
+  static std::size_t constructedObjectsCount()
+  {
+    return constructedObjects;
+  }
+
+  static std::size_t destroyedObjectsCount()
+  {
+    return destroyedObjects;
+  }
+
+  static std::size_t copiedObjectsCount()
+  {
+    return copiedObjects;
+  }
+
+  static std::size_t movedObjectsCount()
+  {
+    return movedObjects;
+  }
+
+  static std::size_t assignedObjectsCount()
+  {
+    return assignedObjects;
+  }
+
+private:
+  int value;
+
+  static std::size_t constructedObjects;
+  static std::size_t destroyedObjects;
+  static std::size_t copiedObjects;
+  static std::size_t movedObjects;
+  static std::size_t assignedObjects;
+};
+
+std::size_t OperationCountingObject::constructedObjects = 0;
+std::size_t OperationCountingObject::destroyedObjects = 0;
+std::size_t OperationCountingObject::copiedObjects = 0;
+std::size_t OperationCountingObject::movedObjects = 0;
+std::size_t OperationCountingObject::assignedObjects = 0 ;
+
+std::ostream& operator<<(std::ostream& out, const OperationCountingObject& obj)
+{
+  return out << '<' << static_cast<int>(obj) << '>';
+}
+
+struct Fixture
+{
+  Fixture()
+  {
+    OperationCountingObject::resetCounters();
+  }
+};
+
+} // namespace
+
+template <typename T>
+using LinearCollection = aisdi::VmVector<T>;
+
+using TestedTypes = boost::mpl::list<std::int32_t,
+                                     std::uint64_t,
+                                     std::complex<std::int32_t>,
+                                     OperationCountingObject>;
+
+using std::begin;
+using std::end;
+
+BOOST_FIXTURE_TEST_SUITE(VmVectorTests, Fixture)
+
+template <typename T>
+void thenCollectionContainsValues(const LinearCollection<T>& collection,
+                                  std::initializer_list<int> expected)
+{
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+template <typename T>
+void thenConstructedObjectsCountWas(std::size_t count)
+{
+  (void) count;
+  // unable to check it (in a simple way) for all objects, hence template specialization.
+}
+
+template <typename T>
+void thenDestroyedObjectsCountWas(std::size_t count)
+{
+  (void) count;
+  // unable to check it (in a simple way) for all objects, hence template specialization.
+}
+
+template <typename T>
+void thenCopiedObjectsCountWas(std::size_t count)
+{
+  (void) count;
+  // unable to check it (in a simple way) for all objects, hence template specialization.
+}
+
+template <typename T>
+void thenMovedObjectsCountWas(std::size_t count)
+{
+  (void) count;
+  // unable to check it (in a simple way) for all objects, hence template specialization.
+}
+
+template <typename T>
+void thenAssignedObjectsCountWas(std::size_t count)
+{
+  (void) count;
+  // unable to check it (in a simple way) for all objects, hence template specialization.
+}
+
+template <>
+void thenConstructedObjectsCountWas<OperationCountingObject>(std::size_t count)
+{
+  BOOST_CHECK_EQUAL(OperationCountingObject::constructedObjectsCount(), count);
+}
+
+template <>
+void thenDestroyedObjectsCountWas<OperationCountingObject>(std::size_t count)
+{
+  BOOST_CHECK_EQUAL(OperationCountingObject::destroyedObjectsCount(), count);
+}
+
+template <>
+void thenCopiedObjectsCountWas<OperationCountingObject>(std::size_t count)
+{
+  BOOST_CHECK_EQUAL(OperationCountingObject::copiedObjectsCount(), count);
+}
+
+template <>
+void thenMovedObjectsCountWas<OperationCountingObject>(std::size_t count)
+{
+  BOOST_CHECK_EQUAL(OperationCountingObject::movedObjectsCount(), count);
+}
+
+template <>
+void thenAssignedObjectsCountWas<OperationCountingObject>(std::size_t count)
+{
+  BOOST_CHECK_EQUAL(OperationCountingObject::assignedObjectsCount(), count);
+}
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              T,
+                              TestedTypes)
+{
+  const LinearCollection<T> collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+  BOOST_CHECK_EQUAL(collection.getCommittedBytes(), 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAppendingManyItems_ThenBufferIsNeverMoved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+  collection.append(0);
+  const T* first = collection.data();
+
+  for (int i = 1; i < 100000; ++i) {
+    collection.append(i);
+  }
+
+  BOOST_CHECK_EQUAL(first, collection.data());
+  BOOST_CHECK_EQUAL(collection.getSize(), 100000);
+  BOOST_CHECK_EQUAL(collection[0], T(0));
+  BOOST_CHECK_EQUAL(collection[99999], T(99999));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFullReservation_WhenAppending_ThenOperationThrows,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection(1);
+  while (collection.getSize() < collection.getCapacity()) {
+    collection.append(T{});
+  }
+
+  BOOST_CHECK_THROW(collection.append(T{}), std::length_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenShrunkCollection_WhenFittingToSize_ThenPagesAreReleased,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+  for (int i = 0; i < 100000; ++i) {
+    collection.append(i);
+  }
+  const auto committed = collection.getCommittedBytes();
+
+  collection.erase(begin(collection) + 10, end(collection));
+  collection.fitToSize();
+
+  BOOST_CHECK_LT(collection.getCommittedBytes(), committed);
+  thenCollectionContainsValues(collection, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+  collection.append(10);
+  BOOST_CHECK_EQUAL(collection.getSize(), 11);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenShrunkCollection_WhenErasingAndPopping_ThenPagesAreReleasedWithoutFitToSize,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+  for (int i = 0; i < 100000; ++i) {
+    collection.append(i);
+  }
+  const auto committed = collection.getCommittedBytes();
+
+  collection.erase(begin(collection) + 1000, end(collection));
+  const auto afterErase = collection.getCommittedBytes();
+  while (collection.getSize() > 10) {
+    collection.popLast();
+  }
+
+  BOOST_CHECK_LT(afterErase, committed);
+  BOOST_CHECK_LE(collection.getCommittedBytes(), afterErase);
+  thenCollectionContainsValues(collection, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInsertingAndErasing_ThenItemsAreUpdated,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  collection.insert(begin(collection) + 1, 7);
+  collection.prepend(0);
+  collection.erase(end(collection) - 1);
+
+  thenCollectionContainsValues(collection, { 0, 1, 7, 2 });
+  BOOST_CHECK_THROW(collection.erase(end(collection)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPopping_ThenItemsAreRemovedAndReturned,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  BOOST_CHECK_EQUAL(collection.popFirst(), T(1));
+  BOOST_CHECK_EQUAL(collection.popLast(), T(3));
+  thenCollectionContainsValues(collection, { 2 });
+  collection.popLast();
+  BOOST_CHECK_THROW(collection.popLast(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenCopying_ThenCollectionsAreIndependent,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+  LinearCollection<T> other{collection};
+  LinearCollection<T> assigned;
+
+  assigned = collection;
+  collection.append(4);
+
+  thenCollectionContainsValues(other, { 1, 2, 3 });
+  thenCollectionContainsValues(assigned, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenMoving_ThenNoItemIsTouched,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3 };
+
+  OperationCountingObject::resetCounters();
+  LinearCollection<T> other{std::move(collection)};
+
+  thenCollectionContainsValues(other, { 1, 2, 3 });
+  thenConstructedObjectsCountWas<T>(0);
+  thenCopiedObjectsCountWas<T>(0);
+  thenAssignedObjectsCountWas<T>(0);
+  thenMovedObjectsCountWas<T>(0);
+  thenDestroyedObjectsCountWas<T>(0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenDestroyed_ThenLiveItemsAreDestroyed,
+                              T,
+                              TestedTypes)
+{
+  {
+    LinearCollection<T> collection = { 1, 2, 3 };
+
+    OperationCountingObject::resetCounters();
+  }
+
+  thenDestroyedObjectsCountWas<T>(3);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenHugePagesRequested_WhenAppending_ThenCollectionWorks,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection(1 << 20, true);
+
+  collection.append(1);
+  collection.append(2);
+
+  thenCollectionContainsValues(collection, { 1, 2 });
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(collection.data()) % (2 << 20), 0);
+}
+
+using Page = std::array<char, 1 << 20>;
+
+struct NamedPage
+{
+  std::string name;
+  Page page;
+};
+
+BOOST_AUTO_TEST_CASE(GivenDefaultReservationUsedUp_WhenAppending_ThenPagesAreRemappedAndKept)
+{
+  aisdi::VmVector<Page> collection;
+  const std::size_t reserved = collection.getCapacity();
+  Page page;
+
+  for (std::size_t i = 0; i < reserved + 10; ++i) {
+    page.fill(char(i));
+    collection.append(page);
+  }
+
+  BOOST_CHECK_GT(collection.getCapacity(), reserved);
+  for (std::size_t i = 0; i < collection.getSize(); ++i) {
+    BOOST_REQUIRE_EQUAL(collection[i][i % page.size()], char(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GivenDefaultReservationUsedUp_WhenAppendingNonTrivialItems_ThenTheyAreMoved)
+{
+  aisdi::VmVector<NamedPage> collection;
+  const std::size_t reserved = collection.getCapacity();
+  NamedPage item;
+
+  for (std::size_t i = 0; i < reserved + 10; ++i) {
+    item.name = "a name long enough to live on the heap " + std::to_string(i);
+    collection.append(item);
+  }
+
+  BOOST_CHECK_GT(collection.getCapacity(), reserved);
+  BOOST_CHECK_EQUAL(collection[0].name, "a name long enough to live on the heap 0");
+  BOOST_CHECK_EQUAL(collection[reserved + 9].name, item.name);
+}
+
+BOOST_AUTO_TEST_CASE(GivenFullDefaultReservation_WhenAppendingOwnItem_ThenItemIsCopiedBeforeGrowth)
+{
+  aisdi::VmVector<NamedPage> collection;
+  const std::size_t reserved = collection.getCapacity();
+  NamedPage item;
+  item.name = "a name long enough to live on the heap";
+  for (std::size_t i = 0; i < reserved; ++i) {
+    collection.append(item);
+  }
+  collection[0].name = "the first name, also long enough to live on the heap";
+
+  collection.append(collection[0]);
+
+  BOOST_CHECK_GT(collection.getCapacity(), reserved);
+  BOOST_CHECK_EQUAL(collection[reserved].name, "the first name, also long enough to live on the heap");
+}
+
+BOOST_AUTO_TEST_SUITE_END()